@@ -0,0 +1,152 @@
+// Measures the throughput and latency of co_await'ing futures that are not ready yet,
+// with the executor, and with the previous scheme of one thread per co_await.
+//
+// Build and run:
+//	c++ -std=c++2a -fcoroutines -O2 -pthread bench/await.cpp -o await && ./await
+// The number of executor threads can be set with RL_THREADS.
+
+#include "../out/helper.cpp"
+
+#include <algorithm>
+#include <cstdio>
+
+using Clock = std::chrono::steady_clock;
+using Nanoseconds = std::chrono::nanoseconds::rep;
+
+// Resumes suspended producers on a separate thread, so that their futures complete later.
+class Completer
+{
+	std::mutex m_mutex;
+	std::condition_variable m_available;
+	std::deque<std::coroutine_handle<>> m_queue;
+	std::thread m_thread;
+public:
+	Completer(): m_thread([this]{ run(); }) {}
+	~Completer()
+	{
+		push(nullptr);
+		m_thread.join();
+	}
+
+	void push(std::coroutine_handle<> producer)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queue.push_back(producer);
+		m_available.notify_one();
+	}
+
+	void run()
+	{
+		for(;;)
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_available.wait(lock, [this]{ return !m_queue.empty(); });
+			auto producer = m_queue.front();
+			m_queue.pop_front();
+			lock.unlock();
+			if(!producer)
+				return;
+			producer.resume();
+		}
+	}
+
+	auto operator co_await()
+	{
+		struct awaiter {
+			Completer & completer;
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<> producer) { completer.push(producer); }
+			void await_resume() const noexcept {}
+		};
+		return awaiter{*this};
+	}
+};
+
+// Completes its future on the completer thread, with the time of completion.
+__rl::Future<Nanoseconds> produce(Completer & completer)
+{
+	co_await completer;
+	co_return Clock::now().time_since_epoch().count();
+}
+
+// The previous co_await scheme, which waits on a new thread.
+template<class T>
+struct ThreadPerAwait { std::future<T> future; };
+
+template<class T>
+auto operator co_await(ThreadPerAwait<T> && wrapper) noexcept {
+	struct awaiter : std::future<T> {
+		bool await_ready() const noexcept {
+			using namespace std::chrono_literals;
+			return this->wait_for(0s) != std::future_status::timeout;
+		}
+		void await_suspend(std::coroutine_handle<> cont) const {
+			std::thread([this, cont] {
+			this->wait();
+			cont();
+			}).detach();
+		}
+		T await_resume() { return this->get(); }
+	};
+	return awaiter{std::move(wrapper.future)};
+}
+
+// Awaits a chain of futures, recording the delay between completion and resumption.
+template<bool kThreadPerAwait>
+std::future<void> consume(
+	Completer & completer,
+	int count,
+	std::vector<Nanoseconds> & latencies)
+{
+	for(int i = 0; i < count; i++)
+	{
+		Nanoseconds completion;
+		if constexpr(kThreadPerAwait)
+		{
+			// Not a temporary, which GCC 12 destroys twice.
+			ThreadPerAwait<Nanoseconds> future{produce(completer)};
+			completion = co_await std::move(future);
+		} else
+			completion = co_await produce(completer);
+		latencies.push_back(Clock::now().time_since_epoch().count() - completion);
+	}
+}
+
+template<bool kThreadPerAwait>
+void measure(
+	char const * name,
+	int consumers,
+	int awaits)
+{
+	Completer completer;
+	std::vector<std::vector<Nanoseconds>> latencies(consumers);
+	std::vector<std::future<void>> done;
+
+	auto const start = Clock::now();
+	for(int i = 0; i < consumers; i++)
+		done.push_back(consume<kThreadPerAwait>(completer, awaits, latencies[i]));
+	for(auto & consumer : done)
+		consumer.get();
+	double const seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::vector<Nanoseconds> all;
+	for(auto & consumer : latencies)
+		all.insert(all.end(), consumer.begin(), consumer.end());
+	std::sort(all.begin(), all.end());
+	std::printf("%-16s %4d consumers: %9.0f awaits/s, latency p50 %7.1f us, p99 %8.1f us\n",
+		name,
+		consumers,
+		all.size() / seconds,
+		all[all.size() / 2] / 1000.0,
+		all[all.size() * 99 / 100] / 1000.0);
+}
+
+int main()
+{
+	for(int consumers : {1, 16, 256})
+	{
+		int const awaits = 20000 / consumers;
+		measure<true>("thread per await", consumers, awaits);
+		measure<false>("executor", consumers, awaits);
+	}
+}
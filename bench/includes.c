@@ -0,0 +1,143 @@
+// Measures the compiler on a synthetic include graph of many files, without compiling the generated C++.
+// A root file includes every file, and every file includes a shared base file and its parent in a binary tree.
+//
+// Build and run from the repository's root:
+//	cc -std=gnu11 -O2 bench/includes.c -o includes && ./includes path/to/rmbrtbc [files]
+// The C++ compiler is replaced by a script that discards its input.
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+static char const k_sink[] =
+	"#!/bin/sh\n"
+	"for a in \"$@\"; do case \"$a\" in /tmp/.rlc_pipe_*) cat \"$a\" > /dev/null; rm -f \"$a\";; -) cat > /dev/null;; esac; done\n"
+	"exit 0\n";
+
+static int write_file(
+	char const * path,
+	char const * contents)
+{
+	FILE * out = fopen(path, "w");
+	if(!out)
+	{
+		perror(path);
+		return 0;
+	}
+	fputs(contents, out);
+	return !fclose(out);
+}
+
+/** Generates the include graph and the sink compiler in the current directory. */
+static int generate(
+	int files)
+{
+	char path[32], contents[128];
+	if(!write_file("base.rl", "::base { Value: U4; }\n")
+	|| !write_file("c++", k_sink)
+	|| chmod("c++", 0755))
+		return 0;
+
+	FILE * root = fopen("root.rl", "w");
+	if(!root)
+		return 0;
+	for(int i = 0; i < files; i++)
+	{
+		snprintf(path, sizeof(path), "f%d.rl", i);
+		if(i)
+			snprintf(contents, sizeof(contents),
+				"INCLUDE \"base.rl\"\nINCLUDE \"f%d.rl\"\n\n::f%d { Value: U4; }\n",
+				(i - 1) / 2, i);
+		else
+			snprintf(contents, sizeof(contents), "INCLUDE \"base.rl\"\n\n::f0 { Value: U4; }\n");
+		if(!write_file(path, contents))
+			return 0;
+		fprintf(root, "INCLUDE \"%s\"\n", path);
+	}
+	return !fclose(root);
+}
+
+static void remove_files(
+	int files)
+{
+	char path[32];
+	for(int i = 0; i < files; i++)
+	{
+		snprintf(path, sizeof(path), "f%d.rl", i);
+		unlink(path);
+	}
+	unlink("base.rl");
+	unlink("root.rl");
+	unlink("c++");
+	unlink("a.out");
+}
+
+int main(int argc, char ** argv)
+{
+	if(argc < 2)
+	{
+		fprintf(stderr, "usage: %s path/to/rmbrtbc [files]\n", argv[0]);
+		return 1;
+	}
+	char compiler[PATH_MAX];
+	if(!realpath(argv[1], compiler))
+	{
+		perror(argv[1]);
+		return 1;
+	}
+	int const files = argc > 2 ? atoi(argv[2]) : 10000;
+
+	char dir[] = "/tmp/rlc_includes_XXXXXX";
+	if(!mkdtemp(dir) || chdir(dir))
+	{
+		perror(dir);
+		return 1;
+	}
+
+	int success = generate(files);
+	if(success)
+	{
+		// The sink shadows the real compiler.
+		char const * path = getenv("PATH");
+		char search[PATH_MAX + 4096];
+		snprintf(search, sizeof(search), "%s:%s", dir, path ? path : "/usr/bin:/bin");
+		setenv("PATH", search, 1);
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		pid_t const child = fork();
+		if(!child)
+		{
+			// Only errors are shown.
+			if(!freopen("/dev/null", "w", stdout))
+				_exit(127);
+			execl(compiler, compiler, "root.rl", (char *)NULL);
+			perror(compiler);
+			_exit(127);
+		}
+
+		int status;
+		struct rusage usage;
+		success = child != -1
+			&& wait4(child, &status, 0, &usage) == child
+			&& WIFEXITED(status) && !WEXITSTATUS(status);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		if(success)
+			printf("%d files: %.2f s, %.1f MiB peak RSS\n",
+				files,
+				(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9,
+				usage.ru_maxrss / 1024.0);
+		else
+			fprintf(stderr, "%s failed.\n", compiler);
+	}
+
+	remove_files(files);
+	rmdir(dir);
+	return !success;
+}
@@ -0,0 +1,97 @@
+// Measures the parser's throughput on a generated file that uses most expressions, statements, and scope entries.
+//
+// Build and run from the repository's root:
+//	cc -std=gnu11 -fcommon -O2 -Isrc bench/parse.c $(find src -name '*.c' ! -name main.c) -pthread -o parse && ./parse [copies] [runs]
+// Prints the best time of all runs, which includes tokenising.
+
+#include "parser/file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/** A function and a class, with `%1$d` replaced by the copy's index. */
+static char const k_template[] =
+	"(/ Copy %1$d. /)\n"
+	"compute%1$d(a: int, b: int) int\n"
+	"{\n"
+	"\tx: int := a * b + a / b - a %% b;\n"
+	"\ty ::= x << 2 >> 1;\n"
+	"\tz: int(x & y | x ^ y);\n"
+	"\tIF(x < y && y <= z || z > x && x >= y || x == y || x != y)\n"
+	"\t\tx := -x;\n"
+	"\tELSE\n"
+	"\t\tx += +y;\n"
+	"\tx -= 1; x *= 2; x /= 3; x %%= 4;\n"
+	"\tFOR(i: int := 0; i < 10; ++i)\n"
+	"\t\ty := y + i;\n"
+	"\tWHILE(y > 0)\n"
+	"\t\t--y;\n"
+	"\tSWITCH(z)\n"
+	"\t{\n"
+	"\tCASE 1, 2: { x := 1; BREAK; }\n"
+	"\tDEFAULT: x := 3;\n"
+	"\t}\n"
+	"\tt ::= (1, 2, 3);\n"
+	"\ts ::= :sym%1$d;\n"
+	"\tp: int * := &x;\n"
+	"\tr ::= <int>(*p);\n"
+	"\tsz ::= SIZEOF(int);\n"
+	"\tTRY { THROW 5; }\n"
+	"\tCATCH(e: int) { x := e; }\n"
+	"\tarr: int[4];\n"
+	"\tarr[1] := !x ? ~y : x;\n"
+	"\tRETURN compute%1$d(arr[1], Foo%1$d::make().get());\n"
+	"}\n"
+	"\n"
+	"Foo%1$d\n"
+	"{\n"
+	"\tV: int;\n"
+	"\tget() int := V;\n"
+	"\tset(v: int) VOID { V := v; }\n"
+	"\tSTATIC make() Foo%1$d := Foo%1$d();\n"
+	"}\n"
+	"\n";
+
+int main(int argc, char ** argv)
+{
+	int const copies = argc > 1 ? atoi(argv[1]) : 2000;
+	int const runs = argc > 2 ? atoi(argv[2]) : 20;
+
+	char path[] = "/tmp/rlc_parse_XXXXXX";
+	int const fd = mkstemp(path);
+	FILE * out = fd == -1 ? NULL : fdopen(fd, "w");
+	if(!out)
+	{
+		perror(path);
+		return 1;
+	}
+	for(int i = 0; i < copies; i++)
+		fprintf(out, k_template, i);
+	long const size = ftell(out);
+	fclose(out);
+
+	double best = 1e9;
+	for(int i = 0; i < runs; i++)
+	{
+		struct timespec start, end;
+		struct RlcParsedFile file;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if(!rlc_parsed_file_create(&file, path))
+		{
+			unlink(path);
+			return 1;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		rlc_parsed_file_destroy(&file);
+
+		double const seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+		if(seconds < best)
+			best = seconds;
+	}
+	unlink(path);
+
+	printf("%ld bytes, best of %d: %.2f ms, %.1f MB/s\n", size, runs, best * 1e3, size / best / 1e6);
+	return 0;
+}
@@ -0,0 +1,125 @@
+// Measures the tokeniser's throughput and the token buffer's memory use, on a small and a large generated file.
+//
+// Build and run from the repository's root:
+//	cc -std=gnu11 -fcommon -O2 -Isrc bench/tokenise.c $(find src -name '*.c' ! -name main.c) -pthread -o tokenise && ./tokenise [runs]
+// The large file exceeds 64 KiB, and contains a string literal longer than the compact token length.
+
+#include "tokeniser/tokenbuffer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+/** A line of typical code, with `%1$d` replaced by the line's index. */
+static char const k_line[] =
+	"\tvalue%1$d: U4 := compute(first_%1$d, 0x%1$x) + \"a short string\" * 42; // a comment\n";
+
+/** Generates a file of `lines` lines, followed by a string literal of `literal` characters.
+@return
+	The file's size, or -1. */
+static long generate(
+	char * path,
+	int lines,
+	int literal)
+{
+	int const fd = mkstemp(path);
+	FILE * out = fd == -1 ? NULL : fdopen(fd, "w");
+	if(!out)
+		return -1;
+
+	for(int i = 0; i < lines; i++)
+		fprintf(out, k_line, i);
+	if(literal)
+	{
+		fputc('"', out);
+		for(int i = 0; i < literal; i++)
+			fputc('a' + i % 26, out);
+		fputs("\";\n", out);
+	}
+	long const size = ftell(out);
+	fclose(out);
+	return size;
+}
+
+static double now(void)
+{
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+static int measure(
+	char const * name,
+	int lines,
+	int literal,
+	int runs)
+{
+	char path[] = "/tmp/rlc_tokenise_XXXXXX";
+	long const size = generate(path, lines, literal);
+	struct RlcSrcFile file;
+	if(size == -1 || !rlc_src_file_read(&file, path))
+	{
+		perror(path);
+		return 0;
+	}
+	unlink(path);
+
+	// Tokenising alone.
+	double best = 1e9;
+	size_t tokens = 0;
+	for(int run = 0; run < runs; run++)
+	{
+		struct RlcTokeniser tokeniser;
+		struct RlcToken token;
+		tokens = 0;
+		double const start = now();
+		rlc_tokeniser_create(&tokeniser, &file);
+		while(rlc_tokeniser_read(&tokeniser, &token))
+			++tokens;
+		double const seconds = now() - start;
+		if(seconds < best)
+			best = seconds;
+	}
+
+	// Storing the tokens, as the parser does.
+	struct RlcTokenBuffer buffer;
+	rlc_token_buffer_create(&buffer, &file);
+	if(!rlc_token_buffer_has(&buffer, tokens - 1))
+	{
+		fprintf(stderr, "%s: tokenising failed.\n", name);
+		return 0;
+	}
+	size_t const long_tokens = atomic_load(&buffer.fLongLengthCount);
+	size_t const bytes = tokens * (sizeof(*buffer.fTypes)
+			+ sizeof(*buffer.fStarts)
+			+ sizeof(*buffer.fLengths)
+			+ sizeof(*buffer.fIdentifiers))
+		+ long_tokens * sizeof(*buffer.fLongLengths);
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	rlc_token_buffer_destroy(&buffer);
+	rlc_src_file_destroy(&file);
+
+	printf("%-6s %9ld bytes, %8zu tokens (%zu long): %6.1f MB/s, buffer %5.2f bytes/token, peak RSS %6.1f MiB\n",
+		name,
+		size,
+		tokens,
+		long_tokens,
+		size / best / 1e6,
+		(double) bytes / tokens,
+		usage.ru_maxrss / 1024.0);
+	return 1;
+}
+
+int main(int argc, char ** argv)
+{
+	int const runs = argc > 1 ? atoi(argv[1]) : 20;
+	// Peak RSS only grows, so the small file is measured first.
+	if(!measure("small", 700, 0, runs)
+	|| !measure("large", 50000, 70000, runs))
+		return 1;
+	return 0;
+}
@@ -14,73 +14,417 @@
 #include <thread>
 #include <type_traits>
 #include <tuple>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
-// Enable the use of std::future<T> as a coroutine type
-// by using a std::promise<T> as the promise type.
-template <typename T, typename... Args>
-requires(!std::is_void_v<T> && !std::is_reference_v<T>)
-struct std::coroutine_traits<std::future<T>, Args...> {
-	struct promise_type : std::promise<T> {
-		std::future<T> get_return_object() noexcept {
-			return this->get_future();
+// Runs resumed coroutines on a set of worker threads.
+// Every worker owns a queue, and steals from the others when its own is empty.
+// A coroutine awaiting the __rl::Future of a coroutine is resumed by that coroutine once it completes.
+// Other futures, such as those of std::async, are polled by idle workers with a growing interval.
+// A worker that blocks on a future is replaced by a spare worker until it continues, so that what it waits for still runs.
+// The number of workers defaults to the number of cores, and can be set with the RL_THREADS environment variable.
+namespace __rl::executor
+{
+	// A worker's queue: the owner takes the newest task, thieves take the oldest.
+	class WorkQueue
+	{
+		std::mutex m_mutex;
+		std::deque<std::coroutine_handle<>> m_tasks;
+	public:
+		inline void push(std::coroutine_handle<> task)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(task);
 		}
+		inline std::coroutine_handle<> pop()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if(m_tasks.empty())
+				return nullptr;
+			auto task = m_tasks.back();
+			m_tasks.pop_back();
+			return task;
+		}
+		inline std::coroutine_handle<> steal()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if(m_tasks.empty())
+				return nullptr;
+			auto task = m_tasks.front();
+			m_tasks.pop_front();
+			return task;
+		}
+	};
+
+	// A coroutine waiting for a future that is polled.
+	struct Wait
+	{
+		void const * awaiter;
+		bool (*ready)(void const * awaiter);
+		std::coroutine_handle<> continuation;
+	};
+
+	class Executor
+	{
+		unsigned m_worker_count;
+		std::unique_ptr<WorkQueue[]> m_queues;
+		std::atomic<unsigned> m_next {0};
+		// The number of workers that are not blocked, including spare workers.
+		std::atomic<unsigned> m_running;
+		// The number of queued tasks, and of workers sleeping until there are any.
+		std::atomic<size_t> m_queued {0};
+		std::atomic<unsigned> m_sleeping {0};
+		std::mutex m_idle_mutex;
+		std::condition_variable m_idle;
+
+		// Polled futures are only accessed by the idle worker holding `m_idle_mutex`.
+		std::vector<Wait> m_waits;
+		bool m_polling = false;
 
-		std::suspend_never initial_suspend() const noexcept { return {}; }
-		std::suspend_never final_suspend() const noexcept { return {}; }
+		static inline thread_local WorkQueue * t_queue = nullptr;
+		static inline thread_local bool t_worker = false;
 
-		void return_value(const T &value)
-		noexcept(std::is_nothrow_copy_constructible_v<T>) {
-			this->set_value(value);
+		static unsigned worker_count()
+		{
+			if(char const * threads = std::getenv("RL_THREADS"))
+				if(unsigned long count = std::strtoul(threads, nullptr, 10))
+					return (unsigned) count;
+			unsigned const cores = std::thread::hardware_concurrency();
+			return cores ? cores : 1;
 		}
-		void return_value(T &&value)
-		noexcept(std::is_nothrow_move_constructible_v<T>) {
-			this->set_value(std::move(value));
+
+		// Spare workers have no queue of their own, and steal from all workers.
+		std::coroutine_handle<> find_task(unsigned self)
+		{
+			unsigned others = m_worker_count;
+			if(self < m_worker_count)
+			{
+				if(auto task = m_queues[self].pop())
+					return task;
+				--others;
+			}
+			for(unsigned i = 1; i <= others; i++)
+				if(auto task = m_queues[(self + i) % m_worker_count].steal())
+					return task;
+			return nullptr;
 		}
-		void unhandled_exception() noexcept {
-			this->set_exception(std::current_exception());
+
+		// Resumes the coroutines whose futures became ready. Expects `m_idle_mutex` to be locked.
+		void poll()
+		{
+			for(size_t i = 0; i < m_waits.size();)
+				if(m_waits[i].ready(m_waits[i].awaiter))
+				{
+					push(m_waits[i].continuation);
+					m_waits[i] = m_waits.back();
+					m_waits.pop_back();
+				} else
+					++i;
 		}
-	};
-};
 
-// Same for std::future<void>.
-template <typename... Args>
-struct std::coroutine_traits<std::future<void>, Args...> {
-	struct promise_type : std::promise<void> {
-		std::future<void> get_return_object() noexcept {
-			return this->get_future();
+		// Stops a spare worker if enough workers are running without it.
+		bool retire()
+		{
+			unsigned running = m_running.load();
+			while(running > m_worker_count)
+				if(m_running.compare_exchange_weak(running, running - 1))
+					return true;
+			return false;
+		}
+
+		void work(unsigned self)
+		{
+			using namespace std::chrono_literals;
+			bool const spare = self == m_worker_count;
+			t_queue = spare ? nullptr : &m_queues[self];
+			t_worker = true;
+			for(;;)
+			{
+				if(auto task = find_task(self))
+				{
+					--m_queued;
+					task.resume();
+					continue;
+				}
+
+				if(spare && retire())
+					return;
+
+				// A single idle worker polls the futures, the others sleep until there are tasks.
+				std::unique_lock<std::mutex> lock(m_idle_mutex);
+				++m_sleeping;
+				auto const queued = [this]{ return m_queued.load() != 0; };
+				if(m_polling || m_waits.empty())
+					m_idle.wait(lock, [&]{ return queued() || (!m_polling && !m_waits.empty()); });
+				if(!queued() && !m_polling)
+				{
+					m_polling = true;
+					for(auto interval = 50us; !m_waits.empty() && !queued(); interval = std::min<std::chrono::microseconds>(interval * 2, 2ms))
+						if(!m_idle.wait_for(lock, interval, queued))
+							poll();
+					m_polling = false;
+					// Another worker takes over polling, if there still are futures.
+					m_idle.notify_one();
+				}
+				--m_sleeping;
+			}
+		}
+
+		void push(std::coroutine_handle<> task)
+		{
+			// Counted before it can be taken, so that `m_queued` does not underflow.
+			++m_queued;
+			if(t_queue)
+				t_queue->push(task);
+			else
+				m_queues[m_next++ % m_worker_count].push(task);
+		}
+
+	public:
+		Executor():
+			m_worker_count(worker_count()),
+			m_queues(new WorkQueue[m_worker_count]),
+			m_running(m_worker_count)
+		{
+			// The executor lives until the program exits, like the threads it replaces.
+			for(unsigned i = 0; i < m_worker_count; i++)
+				std::thread(&Executor::work, this, i).detach();
 		}
 
-		std::suspend_never initial_suspend() const noexcept { return {}; }
-		std::suspend_never final_suspend() const noexcept { return {}; }
+		// Schedules a coroutine to be resumed on a worker.
+		void post(std::coroutine_handle<> task)
+		{
+			push(task);
+			if(m_sleeping.load())
+			{
+				std::lock_guard<std::mutex> lock(m_idle_mutex);
+				m_idle.notify_one();
+			}
+		}
+
+		// Parks a coroutine until `ready(awaiter)` returns true.
+		void wait(
+			void const * awaiter,
+			bool (*ready)(void const *),
+			std::coroutine_handle<> continuation)
+		{
+			std::lock_guard<std::mutex> lock(m_idle_mutex);
+			m_waits.push_back(Wait{awaiter, ready, continuation});
+			m_idle.notify_one();
+		}
+
+		// Called before the calling thread blocks. If it is a worker, a spare worker runs in its place, unless enough other workers are running.
+		// Returns whether the calling thread is a worker.
+		bool block()
+		{
+			if(!t_worker)
+				return false;
+			if(--m_running < m_worker_count)
+			{
+				++m_running;
+				std::thread(&Executor::work, this, m_worker_count).detach();
+			}
+			return true;
+		}
 
-		void return_void() noexcept {
-			this->set_value();
+		// Called once a worker that blocked continues. Spare workers stop once they are idle.
+		void unblock()
+		{
+			++m_running;
 		}
-		void unhandled_exception() noexcept {
-			this->set_exception(std::current_exception());
+	};
+
+	inline Executor & instance()
+	{
+		static Executor * executor = new Executor();
+		return *executor;
+	}
+
+	// Marks the calling thread as blocked while it exists.
+	class Blocking
+	{
+		bool m_worker;
+	public:
+		Blocking(): m_worker(instance().block()) {}
+		~Blocking()
+		{
+			if(m_worker)
+				instance().unblock();
 		}
+		Blocking(Blocking const&) = delete;
+		Blocking &operator=(Blocking const&) = delete;
 	};
-};
+}
 
-// Allow co_await'ing std::future<T> and std::future<void>
-// by naively spawning a new thread for each co_await.
-template <typename T>
-auto operator co_await(std::future<T> &&future) noexcept
-	requires(!std::is_reference_v<T>) {
-	struct awaiter : std::future<T> {
-		bool await_ready() const noexcept {
+// The type of future values.
+// Futures of coroutines resume their awaiter when the coroutine completes, other futures are polled by the executor.
+// A future is a std::future, so that it can be passed to and from other code.
+namespace __rl
+{
+	template<class T>
+	class Future;
+
+	namespace detail
+	{
+		// Holds the coroutine awaiting a coroutine's future, or marks the coroutine as completed.
+		class Completion
+		{
+			static inline char s_completed;
+			std::atomic<void *> m_state {nullptr};
+		public:
+			bool completed() const noexcept
+			{
+				return m_state.load(std::memory_order_acquire) == &s_completed;
+			}
+			// Returns false if the coroutine already completed.
+			bool await(std::coroutine_handle<> continuation) noexcept
+			{
+				void * expected = nullptr;
+				return m_state.compare_exchange_strong(expected, continuation.address(), std::memory_order_acq_rel);
+			}
+			// Called after the coroutine made its future ready.
+			void complete()
+			{
+				if(void * continuation = m_state.exchange(&s_completed, std::memory_order_acq_rel))
+					executor::instance().post(std::coroutine_handle<>::from_address(continuation));
+			}
+		};
+
+		template<class T>
+		class FuturePromiseBase : public std::promise<T>
+		{
+		protected:
+			std::shared_ptr<Completion> m_completion = std::make_shared<Completion>();
+		public:
+			Future<T> get_return_object() { return Future<T>(this->get_future(), m_completion); }
+
+			std::suspend_never initial_suspend() const noexcept { return {}; }
+			std::suspend_never final_suspend() const noexcept { return {}; }
+
+			void unhandled_exception() noexcept
+			{
+				this->set_exception(std::current_exception());
+				m_completion->complete();
+			}
+		};
+
+		template<class T>
+		class FuturePromise : public FuturePromiseBase<T>
+		{
+		public:
+			void return_value(T const& value)
+			noexcept(std::is_nothrow_copy_constructible_v<T>) {
+				this->set_value(value);
+				this->m_completion->complete();
+			}
+			void return_value(T &&value)
+			noexcept(std::is_nothrow_move_constructible_v<T>) {
+				this->set_value(std::move(value));
+				this->m_completion->complete();
+			}
+		};
+
+		template<>
+		class FuturePromise<void> : public FuturePromiseBase<void>
+		{
+		public:
+			void return_void() noexcept {
+				this->set_value();
+				m_completion->complete();
+			}
+		};
+	}
+
+	template<class T>
+	class Future : public std::future<T>
+	{
+		// Null if the future was not returned by a coroutine.
+		std::shared_ptr<detail::Completion> m_completion;
+
+		struct Awaiter
+		{
+			Future future;
+
+			bool await_ready() const noexcept { return future.ready(); }
+			bool await_suspend(std::coroutine_handle<> continuation)
+			{
+				if(future.m_completion)
+					return future.m_completion->await(continuation);
+				executor::instance().wait(this, &ready, continuation);
+				return true;
+			}
+			T await_resume() { return future.std::future<T>::get(); }
+
+			static bool ready(void const * self) noexcept
+			{
+				return static_cast<Awaiter const *>(self)->future.ready();
+			}
+		};
+	public:
+		typedef detail::FuturePromise<T> promise_type;
+
+		Future() noexcept = default;
+		Future(std::future<T> &&future) noexcept:
+			std::future<T>(std::move(future))
+		{
+		}
+		Future(std::future<T> &&future, std::shared_ptr<detail::Completion> completion) noexcept:
+			std::future<T>(std::move(future)),
+			m_completion(std::move(completion))
+		{
+		}
+
+		// Whether the result is available.
+		bool ready() const noexcept
+		{
 			using namespace std::chrono_literals;
+			if(m_completion)
+				return m_completion->completed();
 			return this->wait_for(0s) != std::future_status::timeout;
 		}
-		void await_suspend(std::coroutine_handle<> cont) const {
-			std::thread([this, cont] {
-			this->wait();
-			cont();
-			}).detach();
+
+		void wait() const
+		{
+			if(!ready())
+			{
+				executor::Blocking blocking;
+				std::future<T>::wait();
+			}
+		}
+		// Blocks until the result is available. Coroutines co_await the future instead.
+		T get()
+		{
+			wait();
+			return std::future<T>::get();
 		}
-		T await_resume() { return this->get(); }
+
+		Awaiter operator co_await() noexcept { return Awaiter{std::move(*this)}; }
 	};
-	return awaiter{std::move(future)};
+}
+
+// Enable the use of std::future<T> as a coroutine type.
+template <typename T, typename... Args>
+requires(!std::is_reference_v<T>)
+struct std::coroutine_traits<std::future<T>, Args...> {
+	typedef ::__rl::detail::FuturePromise<T> promise_type;
+};
+
+// Allow co_await'ing std::future<T> and std::future<void>, which are polled by the executor.
+template <typename T>
+auto operator co_await(std::future<T> &&future) noexcept
+	requires(!std::is_reference_v<T>) {
+	return ::__rl::Future<T>(std::move(future)).operator co_await();
 }
 
 template<class T>
@@ -88,6 +432,227 @@ auto operator co_await(std::future<T> &future) noexcept {
 	return operator co_await(std::move(future));
 }
 
+// The return type of asynchronous functions.
+// A task starts when it is awaited, and resumes its awaiter directly when it finishes.
+// Its result is not shared, so it needs no locking, and frames are recycled per thread.
+// Tasks convert to __rl::Future<T> for callers that are not coroutines, which starts them.
+namespace __rl
+{
+	template<class T>
+	class Task;
+
+	namespace detail
+	{
+		// A thread's unused coroutine frames, by size.
+		struct FrameLists
+		{
+			struct Frame { Frame * next; };
+			static constexpr size_t kClasses = 16;
+
+			Frame * free[kClasses] {};
+			size_t count[kClasses] {};
+			~FrameLists()
+			{
+				for(Frame * list : free)
+					while(list)
+					{
+						Frame * next = list->next;
+						::operator delete(list);
+						list = next;
+					}
+			}
+		};
+
+		// Recycles coroutine frames by size, so that calling an asynchronous function rarely allocates.
+		class FramePool
+		{
+			typedef FrameLists::Frame Frame;
+			static constexpr size_t kGranularity = 64;
+			static constexpr size_t kClasses = FrameLists::kClasses;
+			static constexpr size_t kMaxFree = 64;
+
+			static inline thread_local FrameLists t_lists;
+
+		public:
+			static void * allocate(size_t size)
+			{
+				size_t const index = (size - 1) / kGranularity;
+				if(index >= kClasses)
+					return ::operator new(size);
+				if(Frame * frame = t_lists.free[index])
+				{
+					t_lists.free[index] = frame->next;
+					--t_lists.count[index];
+					return frame;
+				}
+				return ::operator new((index + 1) * kGranularity);
+			}
+
+			// Frames may be freed on another thread than the one that allocated them.
+			static void deallocate(void * memory, size_t size)
+			{
+				size_t const index = (size - 1) / kGranularity;
+				if(index >= kClasses || t_lists.count[index] == kMaxFree)
+				{
+					::operator delete(memory);
+					return;
+				}
+				Frame * frame = static_cast<Frame *>(memory);
+				frame->next = t_lists.free[index];
+				t_lists.free[index] = frame;
+				++t_lists.count[index];
+			}
+		};
+
+		class TaskPromiseBase
+		{
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept { return false; }
+				template<class Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept
+				{
+					if(auto awaiter = self.promise().m_awaiter)
+						return awaiter;
+					return std::noop_coroutine();
+				}
+				void await_resume() const noexcept {}
+			};
+		public:
+			std::coroutine_handle<> m_awaiter;
+
+			static void * operator new(size_t size) { return FramePool::allocate(size); }
+			static void operator delete(void * frame, size_t size) { FramePool::deallocate(frame, size); }
+
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			FinalAwaiter final_suspend() const noexcept { return {}; }
+		};
+
+		template<class T>
+		class TaskPromise : public TaskPromiseBase
+		{
+			std::variant<std::monostate, T, std::exception_ptr> m_result;
+		public:
+			Task<T> get_return_object() noexcept;
+
+			void return_value(T const& value)
+			noexcept(std::is_nothrow_copy_constructible_v<T>) {
+				m_result.template emplace<1>(value);
+			}
+			void return_value(T &&value)
+			noexcept(std::is_nothrow_move_constructible_v<T>) {
+				m_result.template emplace<1>(std::move(value));
+			}
+			void unhandled_exception() noexcept {
+				m_result.template emplace<2>(std::current_exception());
+			}
+
+			T result()
+			{
+				if(m_result.index() == 2)
+					std::rethrow_exception(std::get<2>(m_result));
+				return std::move(std::get<1>(m_result));
+			}
+		};
+
+		template<>
+		class TaskPromise<void> : public TaskPromiseBase
+		{
+			std::exception_ptr m_exception;
+		public:
+			Task<void> get_return_object() noexcept;
+
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept {
+				m_exception = std::current_exception();
+			}
+
+			void result()
+			{
+				if(m_exception)
+					std::rethrow_exception(m_exception);
+			}
+		};
+	}
+
+	template<class T>
+	class Task
+	{
+	public:
+		typedef detail::TaskPromise<T> promise_type;
+	private:
+		std::coroutine_handle<promise_type> m_coroutine;
+
+		struct Awaiter
+		{
+			std::coroutine_handle<promise_type> coroutine;
+
+			bool await_ready() const noexcept { return coroutine.done(); }
+			// Symmetric transfer: the task runs on the awaiter's thread, without growing the stack.
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept
+			{
+				coroutine.promise().m_awaiter = awaiter;
+				return coroutine;
+			}
+			T await_resume() { return coroutine.promise().result(); }
+		};
+
+		static Future<T> bridge(Task task)
+		{
+			if constexpr(std::is_void_v<T>)
+				co_await std::move(task);
+			else
+				co_return co_await std::move(task);
+		}
+	public:
+		explicit Task(std::coroutine_handle<promise_type> coroutine) noexcept:
+			m_coroutine(coroutine)
+		{
+		}
+		Task(Task &&rhs) noexcept:
+			m_coroutine(std::exchange(rhs.m_coroutine, nullptr))
+		{
+		}
+		Task &operator=(Task &&rhs) noexcept
+		{
+			if(this != &rhs)
+			{
+				if(m_coroutine)
+					m_coroutine.destroy();
+				m_coroutine = std::exchange(rhs.m_coroutine, nullptr);
+			}
+			return *this;
+		}
+		~Task()
+		{
+			if(m_coroutine)
+				m_coroutine.destroy();
+		}
+
+		Awaiter operator co_await() const noexcept { return Awaiter{m_coroutine}; }
+
+		// Starts the task on the calling thread, and returns a future of its result.
+		Future<T> future() { return bridge(std::move(*this)); }
+		operator Future<T>() { return future(); }
+		// Runs the task, and blocks until it finished.
+		T get() { return future().get(); }
+	};
+
+	namespace detail
+	{
+		template<class T>
+		inline Task<T> TaskPromise<T>::get_return_object() noexcept
+		{
+			return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+		}
+
+		inline Task<void> TaskPromise<void>::get_return_object() noexcept
+		{
+			return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+		}
+	}
+}
+
 // Helpers for implementing language features.
 namespace __rl
 {
@@ -357,22 +922,22 @@ namespace __rl
 #define __RL_TEST(name) __RL_TEST_IMPL(name, __COUNTER__)
 #define __RL_TEST_IMPL_PASTE(a,b) a##b
 #define __RL_TEST_IMPL(name, counter) \
-void __RL_TEST_IMPL_PASTE(__rl_test_, counter)(); \
-	int __RL_TEST_IMPL_PASTE(_, counter) = \
+static void __RL_TEST_IMPL_PASTE(__rl_test_, counter)(); \
+	static int __RL_TEST_IMPL_PASTE(_, counter) = \
 		::__rl::test::detail::test(name, &__RL_TEST_IMPL_PASTE(__rl_test_, counter)); \
-	void __RL_TEST_IMPL_PASTE(__rl_test_, counter)()
+	static void __RL_TEST_IMPL_PASTE(__rl_test_, counter)()
 
 namespace __rl::test
 {
 	namespace detail {
-		int successes = 0;
-		int failures = 0;
+		inline int successes = 0;
+		inline int failures = 0;
 
 		extern "C" void * stderr;
 		extern "C" int fprintf(void * file, char const * fmt, ...);
 	}
 
-	void status(int &successes, int &failures)
+	inline void status(int &successes, int &failures)
 	{
 		successes = detail::successes;
 		failures = detail::failures;
@@ -380,7 +945,7 @@ namespace __rl::test
 
 	namespace detail
 	{
-		int test(char const * name, void (*test_fn)())
+		inline int test(char const * name, void (*test_fn)())
 		{
 			try {
 				test_fn();
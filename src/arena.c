@@ -0,0 +1,183 @@
+#include "arena.h"
+#include "malloc.h"
+#include "assert.h"
+
+#include <stdalign.h>
+#include <stdatomic.h>
+
+/** A block of memory owned by an arena. */
+struct RlcArenaBlock
+{
+	/** The previously allocated block. */
+	struct RlcArenaBlock * fPrevious;
+	/** The block's usable size. */
+	size_t fSize;
+	/** The block's used size. */
+	size_t fUsed;
+	/** The block's memory. */
+	max_align_t fData[];
+};
+
+enum
+{
+	/** The usable size of regular blocks. */
+	kBlockSize = 64 * 1024 - sizeof(struct RlcArenaBlock),
+	/** Allocations larger than this get a block of their own. */
+	kLargeAllocation = kBlockSize / 4
+};
+
+/** Shared by all threads, as arenas are created while parsing in parallel. */
+static atomic_size_t s_rlc_arena_bytes = 0;
+static atomic_size_t s_rlc_arena_blocks = 0;
+
+/** Rounds a size up to the arena's alignment. */
+static size_t align_size(
+	size_t size)
+{
+	return (size + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+}
+
+/** Allocates a new block and links it into the arena.
+@param[in] size:
+	The block's usable size.
+@param[in] current:
+	Whether to allocate from the new block afterwards. Otherwise, the block is placed behind the current block. */
+static struct RlcArenaBlock * add_block(
+	struct RlcArena * this,
+	size_t size,
+	int current)
+{
+	struct RlcArenaBlock * block = NULL;
+	rlc_malloc((void**)&block, sizeof(struct RlcArenaBlock) + size);
+	block->fSize = size;
+	block->fUsed = 0;
+
+	if(current || !this->fBlock)
+	{
+		block->fPrevious = this->fBlock;
+		this->fBlock = block;
+	} else
+	{
+		block->fPrevious = this->fBlock->fPrevious;
+		this->fBlock->fPrevious = block;
+	}
+
+	++this->fBlockCount;
+	this->fBytes += size;
+	atomic_fetch_add_explicit(&s_rlc_arena_blocks, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&s_rlc_arena_bytes, size, memory_order_relaxed);
+
+	return block;
+}
+
+/** Allocates aligned memory from the arena. */
+static void * allocate(
+	struct RlcArena * this,
+	size_t size)
+{
+	size = align_size(size);
+
+	struct RlcArenaBlock * block = this->fBlock;
+	if(!block || block->fSize - block->fUsed < size)
+	{
+		if(size > kLargeAllocation)
+			block = add_block(this, size, 0);
+		else
+			block = add_block(this, kBlockSize, 1);
+	}
+
+	void * ret = (char *)block->fData + block->fUsed;
+	block->fUsed += size;
+	return ret;
+}
+
+void rlc_arena_create(
+	struct RlcArena * this)
+{
+	RLC_DASSERT(this != NULL);
+
+	this->fBlock = NULL;
+	this->fBlockCount = 0;
+	this->fBytes = 0;
+}
+
+void rlc_arena_destroy(
+	struct RlcArena * this)
+{
+	RLC_DASSERT(this != NULL);
+
+	while(this->fBlock)
+	{
+		struct RlcArenaBlock * previous = this->fBlock->fPrevious;
+		rlc_free((void**)&this->fBlock);
+		this->fBlock = previous;
+	}
+
+	atomic_fetch_sub_explicit(&s_rlc_arena_blocks, this->fBlockCount, memory_order_relaxed);
+	atomic_fetch_sub_explicit(&s_rlc_arena_bytes, this->fBytes, memory_order_relaxed);
+	this->fBlockCount = 0;
+	this->fBytes = 0;
+}
+
+void rlc_arena_malloc(
+	struct RlcArena * this,
+	void ** ptr,
+	size_t size)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(ptr != NULL);
+	RLC_DASSERT(!*ptr);
+
+	*ptr = allocate(this, size);
+}
+
+int rlc_arena_resize(
+	struct RlcArena * this,
+	void * ptr,
+	size_t size,
+	size_t newsz)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(ptr != NULL);
+
+	size = align_size(size);
+	newsz = align_size(newsz);
+
+	struct RlcArenaBlock * block = this->fBlock;
+	if((char *)ptr + size != (char *)block->fData + block->fUsed)
+		return 0;
+	if(newsz > size && block->fSize - block->fUsed < newsz - size)
+		return 0;
+
+	block->fUsed = block->fUsed - size + newsz;
+	return 1;
+}
+
+struct RlcArenaBlock const * rlc_arena_next_block(
+	struct RlcArena const * this,
+	struct RlcArenaBlock const * block,
+	void const ** data,
+	size_t * used)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(data != NULL);
+	RLC_DASSERT(used != NULL);
+
+	block = block ? block->fPrevious : this->fBlock;
+	if(block)
+	{
+		*data = block->fData;
+		*used = block->fUsed;
+	}
+	return block;
+}
+
+size_t rlc_arena_bytes(void)
+{
+	return atomic_load_explicit(&s_rlc_arena_bytes, memory_order_relaxed);
+}
+
+size_t rlc_arena_blocks(void)
+{
+	return atomic_load_explicit(&s_rlc_arena_blocks, memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+/** @file arena.h
+	Contains the arena allocator used for data that is released all at once, such as the syntax tree of a file.
+	Arena blocks are allocated with `rlc_malloc`, so `rlc_allocations()` counts live blocks, not individual objects. */
+#ifndef __rlc_arena_h_defined
+#define __rlc_arena_h_defined
+
+#include "macros.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct RlcArenaBlock;
+
+/** An arena allocator.
+	Objects cannot be freed individually, but are all released together when the arena is destroyed. */
+struct RlcArena
+{
+	/** The block that is currently allocated from. Points to the previous blocks. */
+	struct RlcArenaBlock * fBlock;
+	/** The number of blocks owned by the arena. */
+	size_t fBlockCount;
+	/** The number of bytes in all blocks owned by the arena. */
+	size_t fBytes;
+};
+
+/** Creates an empty arena.
+@memberof RlcArena
+@param[out] this:
+	The arena to create.
+	@dassert @nonnull */
+void rlc_arena_create(
+	struct RlcArena * this);
+
+/** Releases all memory allocated from an arena.
+@memberof RlcArena
+@param[in,out] this:
+	The arena to destroy.
+	@dassert @nonnull */
+void rlc_arena_destroy(
+	struct RlcArena * this);
+
+/** Allocates memory with size bytes from an arena and stores the address in ``*ptr``.
+	If no memory could be allocated, terminates the program.
+@memberof RlcArena
+@param[in,out] this:
+	The arena to allocate from.
+	@dassert @nonnull
+@param[out] ptr:
+	The address of a pointer that should be set to the allocated memory address.
+	@dassert @nonnull
+	@dassert ``*ptr`` must be null.
+@param[in] size:
+	The size of the allocated memory, in bytes. */
+void rlc_arena_malloc(
+	struct RlcArena * this,
+	void ** ptr,
+	size_t size);
+
+/** Resizes the most recent allocation of an arena in place.
+@memberof RlcArena
+@param[in,out] this:
+	The arena the memory was allocated from.
+	@dassert @nonnull
+@param[in] ptr:
+	The memory to resize.
+	@dassert @nonnull
+@param[in] size:
+	The memory's current size, in bytes.
+@param[in] newsz:
+	The memory's new size, in bytes.
+@return
+	Whether the memory could be resized. Fails if the memory is not the most recent allocation, or there is no room left in its block. */
+_Nodiscard int rlc_arena_resize(
+	struct RlcArena * this,
+	void * ptr,
+	size_t size,
+	size_t newsz);
+
+/** Iterates over the memory used in an arena's blocks.
+	Blocks are visited starting with the one that is currently allocated from.
+@memberof RlcArena
+@param[in] this:
+	The arena whose blocks to visit.
+	@dassert @nonnull
+@param[in] block:
+	The previously visited block, or null to visit the first block.
+@param[out] data:
+	The visited block's memory.
+	@dassert @nonnull
+@param[out] used:
+	The number of bytes used in the visited block.
+	@dassert @nonnull
+@return
+	The visited block, or null if there are no more blocks. */
+struct RlcArenaBlock const * rlc_arena_next_block(
+	struct RlcArena const * this,
+	struct RlcArenaBlock const * block,
+	void const ** data,
+	size_t * used);
+
+/** Retrieves the number of bytes in all live arenas' blocks. */
+size_t rlc_arena_bytes(void);
+
+/** Retrieves the number of blocks owned by all live arenas. */
+size_t rlc_arena_blocks(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,348 @@
+/* For posix_spawn_file_actions_addchdir_np(). */
+#define _GNU_SOURCE
+
+#include "backend.h"
+#include "buildcache.h"
+#include "malloc.h"
+#include "assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <spawn.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/limits.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+
+extern char ** environ;
+
+#ifndef F_SETPIPE_SZ
+#define F_SETPIPE_SZ 1031
+#endif
+/** The requested pipe capacity. Linux limits this to `/proc/sys/fs/pipe-max-size`, usually 1 MiB. */
+enum { kPipeSize = 1 << 20 };
+
+pid_t rlc_backend_spawn(
+	char * const * argv,
+	char const * directory,
+	char const * errors,
+	int * input,
+	int group)
+{
+	RLC_DASSERT(argv != NULL && argv[0] != NULL);
+
+	int fds[2] = { -1, -1 };
+	if(input)
+	{
+		*input = -1;
+		// Both ends are closed on exec, only the duplicate on the standard input survives.
+		if(pipe(fds))
+		{
+			perror("pipe");
+			return -1;
+		}
+		fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+		fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+		// A larger pipe lets the writer run ahead instead of waking the reader every 64 KiB.
+		fcntl(fds[1], F_SETPIPE_SZ, kPipeSize);
+	}
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	if(directory)
+		posix_spawn_file_actions_addchdir_np(&actions, directory);
+	if(errors)
+		posix_spawn_file_actions_addopen(&actions, 2, errors, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if(input)
+		posix_spawn_file_actions_adddup2(&actions, fds[0], 0);
+
+	posix_spawnattr_t attributes;
+	posix_spawnattr_init(&attributes);
+	if(group)
+	{
+		posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+		posix_spawnattr_setpgroup(&attributes, 0);
+	}
+
+	pid_t process;
+	int const error = posix_spawnp(&process, argv[0], &actions, &attributes, argv, environ);
+	posix_spawnattr_destroy(&attributes);
+	posix_spawn_file_actions_destroy(&actions);
+
+	if(input)
+	{
+		close(fds[0]);
+		if(error)
+			close(fds[1]);
+		else
+			*input = fds[1];
+	}
+
+	if(error)
+	{
+		errno = error;
+		perror(argv[0]);
+		return -1;
+	}
+	return process;
+}
+
+int rlc_backend_write(
+	int fd,
+	struct iovec * parts,
+	size_t count)
+{
+	RLC_DASSERT(parts != NULL || !count);
+
+	while(count)
+	{
+		if(!parts->iov_len)
+		{
+			++parts;
+			--count;
+			continue;
+		}
+
+		// POSIX allows at least 16 buffers per call.
+		ssize_t written = writev(fd, parts, count < 16 ? (int)count : 16);
+		if(written == -1)
+		{
+			if(errno == EINTR)
+				continue;
+			// The reader exited, and its exit status tells why.
+			if(errno != EPIPE)
+				perror("writev");
+			return 0;
+		}
+
+		for(; count && (size_t)written >= parts->iov_len; ++parts, --count)
+			written -= parts->iov_len;
+		if(count)
+		{
+			parts->iov_base = (char *)parts->iov_base + written;
+			parts->iov_len -= written;
+		}
+	}
+	return 1;
+}
+
+int rlc_backend_wait(
+	pid_t process)
+{
+	if(process == -1)
+		return 0;
+
+	int status;
+	while(-1 == waitpid(process, &status, 0))
+		if(errno != EINTR)
+		{
+			perror("waitpid");
+			return 0;
+		}
+	return WIFEXITED(status) && !WEXITSTATUS(status);
+}
+
+void rlc_backend_stop(
+	pid_t process)
+{
+	if(process == -1)
+		return;
+
+	if(kill(-process, SIGTERM))
+		kill(process, SIGTERM);
+	while(-1 == waitpid(process, NULL, 0) && errno == EINTR);
+}
+
+int rlc_backend_cache_directory(
+	char * path,
+	size_t size)
+{
+	RLC_DASSERT(path != NULL);
+
+	char const * base = getenv("XDG_CACHE_HOME");
+	int length;
+	if(base && *base)
+		length = snprintf(path, size, "%s/rmbrtbc", base);
+	else if((base = getenv("HOME")) && *base)
+	{
+		length = snprintf(path, size, "%s/.cache", base);
+		if(length > 0 && (size_t)length < size)
+			mkdir(path, 0777);
+		length = snprintf(path, size, "%s/.cache/rmbrtbc", base);
+	} else
+		return 0;
+
+	if(length <= 0 || (size_t)length >= size)
+		return 0;
+	return !mkdir(path, 0777) || errno == EEXIST;
+}
+
+int rlc_backend_read_file(
+	char const * path,
+	char ** contents,
+	size_t * size)
+{
+	RLC_DASSERT(path != NULL);
+	RLC_DASSERT(contents != NULL);
+	RLC_DASSERT(size != NULL);
+
+	FILE * f = fopen(path, "rb");
+	if(!f)
+		return 0;
+
+	long length;
+	if(fseek(f, 0, SEEK_END) || (length = ftell(f)) < 0 || fseek(f, 0, SEEK_SET))
+	{
+		fclose(f);
+		return 0;
+	}
+
+	*contents = NULL;
+	rlc_malloc((void**)contents, length ? length : 1);
+	*size = fread(*contents, 1, length, f);
+	fclose(f);
+	if(*size != (size_t)length)
+	{
+		rlc_free((void**)contents);
+		return 0;
+	}
+	return 1;
+}
+
+/** Atomically creates a file, so that concurrent compiler runs never see it half written.
+@return
+	Whether the file was written. */
+static int write_file(
+	char const * path,
+	char const * contents,
+	size_t size)
+{
+	char temp[PATH_MAX];
+	if((size_t)snprintf(temp, sizeof(temp), "%s.tmp-XXXXXX", path) >= sizeof(temp))
+		return 0;
+	int const fd = mkstemp(temp);
+	if(fd == -1)
+		return 0;
+
+	int success = 1;
+	for(size_t written = 0; success && written < size;)
+	{
+		ssize_t const n = write(fd, contents + written, size - written);
+		if(n > 0)
+			written += n;
+		else if(n == -1 && errno == EINTR)
+			continue;
+		else
+			success = 0;
+	}
+	close(fd);
+
+	if(success && !rename(temp, path))
+		return 1;
+	unlink(temp);
+	return 0;
+}
+
+/** How long a failed precompilation is not retried, in seconds. */
+enum { kNoPchExpiry = 24 * 60 * 60 };
+
+/** Compiles a header into a precompiled header next to it.
+	If the compiler does not support precompiled headers, leaves a marker, so that it is not asked again until the marker expires. */
+static void precompile(
+	char const * header,
+	char const * const * flags)
+{
+	char pch[PATH_MAX], marker[PATH_MAX], temp[PATH_MAX];
+	if((size_t)snprintf(pch, sizeof(pch), "%s.gch", header) >= sizeof(pch)
+	|| (size_t)snprintf(marker, sizeof(marker), "%s.nopch", header) >= sizeof(marker)
+	|| (size_t)snprintf(temp, sizeof(temp), "%s.gch.tmp-XXXXXX", header) >= sizeof(temp))
+		return;
+	if(!access(pch, F_OK))
+		return;
+	struct stat info;
+	if(!stat(marker, &info))
+	{
+		// A failure may have been temporary, such as a full disk.
+		if(time(NULL) - info.st_mtime < kNoPchExpiry)
+			return;
+		unlink(marker);
+	}
+
+	int const fd = mkstemp(temp);
+	if(fd == -1)
+		return;
+	close(fd);
+
+	size_t flag_count = 0;
+	while(flags[flag_count])
+		++flag_count;
+
+	char const ** args = NULL;
+	rlc_malloc((void**)&args, (flag_count + 7) * sizeof(char const *));
+	size_t arg = 0;
+	args[arg++] = "c++";
+	for(size_t i = 0; i < flag_count; i++)
+		args[arg++] = flags[i];
+	args[arg++] = "-x";
+	args[arg++] = "c++-header";
+	args[arg++] = header;
+	args[arg++] = "-o";
+	args[arg++] = temp;
+	args[arg] = NULL;
+
+	int const success = rlc_backend_wait(rlc_backend_spawn((char * const *)args, NULL, "/dev/null", NULL, 0));
+	rlc_free((void**)&args);
+
+	if(success && !stat(temp, &info) && info.st_size && !rename(temp, pch))
+		return;
+
+	unlink(temp);
+	if(!success)
+		(void) write_file(marker, "", 0);
+}
+
+int rlc_backend_prelude(
+	char const * helper,
+	char const * const * flags,
+	char * header,
+	size_t size)
+{
+	RLC_DASSERT(helper != NULL);
+	RLC_DASSERT(flags != NULL);
+	RLC_DASSERT(header != NULL);
+
+	char directory[PATH_MAX];
+	if(!rlc_backend_cache_directory(directory, sizeof(directory)))
+		return 0;
+
+	char * contents;
+	size_t length;
+	if(!rlc_backend_read_file(helper, &contents, &length))
+		return 0;
+
+	// A precompiled header is only valid for the exact compiler and flags it was built with.
+	struct RlcBuildCacheKey key;
+	rlc_build_cache_key_create(&key, "c++");
+	rlc_build_cache_key_add(&key, contents, length);
+	for(char const * const * flag = flags; *flag; flag++)
+		rlc_build_cache_key_add_string(&key, *flag);
+	uint8_t digest[kRlcBuildCacheDigestSize];
+	rlc_build_cache_key_digest(&key, digest);
+	char name[2 * kRlcBuildCacheDigestSize + 1];
+	for(size_t i = 0; i < kRlcBuildCacheDigestSize; i++)
+		sprintf(name + 2 * i, "%02x", digest[i]);
+
+	int success = (size_t)snprintf(header, size, "%s/helper-%s.hpp", directory, name) < size;
+	if(success && access(header, R_OK))
+		success = write_file(header, contents, length);
+	rlc_free((void**)&contents);
+
+	if(success)
+		precompile(header, flags);
+	return success;
+}
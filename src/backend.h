@@ -0,0 +1,125 @@
+/** @file backend.h
+	Contains the invocation of the C++ compiler that turns the generated code into an executable.
+	The helper prelude that precedes all generated code is compiled into a precompiled header once, and kept in the user's cache directory. */
+#ifndef __rlc_backend_h_defined
+#define __rlc_backend_h_defined
+
+#include "macros.h"
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Starts a process without waiting for it.
+	The program is looked up in `PATH`.
+@param[in] argv:
+	The null-terminated argument list, starting with the program name.
+	@dassert @nonnull
+@param[in] directory:
+	If not null, the working directory of the process. Otherwise, the process inherits the working directory.
+@param[in] errors:
+	If not null, the file that the process's error output is written to, which is created or truncated. Otherwise, the process inherits the error output.
+@param[out] input:
+	If not null, receives the write end of a pipe connected to the process's standard input, or -1 on failure. Otherwise, the process inherits the standard input.
+@param[in] group:
+	Whether the process leads a new process group, so that `rlc_backend_stop()` also terminates the processes it starts. Such processes do not receive the terminal's signals.
+@return
+	The process ID, or -1 if the process could not be started. */
+_Nodiscard pid_t rlc_backend_spawn(
+	char * const * argv,
+	char const * directory,
+	char const * errors,
+	int * input,
+	int group);
+
+/** Writes buffers to a pipe, in order, as a single stream.
+	Writing stops early if the reading process exits, which is then reported by `rlc_backend_wait()`.
+@param[in] fd:
+	The pipe's write end.
+@param[in,out] parts:
+	The buffers to write. Their entries are modified.
+	@dassert @nonnull
+@param[in] count:
+	The number of buffers.
+@return
+	Whether everything was written. */
+int rlc_backend_write(
+	int fd,
+	struct iovec * parts,
+	size_t count);
+
+/** Reads a whole file into memory.
+@param[in] path:
+	The file's path.
+	@dassert @nonnull
+@param[out] contents:
+	Receives the file's contents, which must be freed with `rlc_free()`.
+	@dassert @nonnull
+@param[out] size:
+	Receives the file's size.
+	@dassert @nonnull
+@return
+	Whether the file was read. */
+_Nodiscard int rlc_backend_read_file(
+	char const * path,
+	char ** contents,
+	size_t * size);
+
+/** Waits for a process started by `rlc_backend_spawn()` to terminate.
+@param[in] process:
+	The process ID, or -1.
+@return
+	Whether the process exited successfully. */
+_Nodiscard int rlc_backend_wait(
+	pid_t process);
+
+/** Terminates a process started by `rlc_backend_spawn()` and its process group, if it leads one, and waits for it.
+	The processes are asked to terminate, so that they can remove their temporary files.
+@param[in] process:
+	The process ID, or -1. */
+void rlc_backend_stop(
+	pid_t process);
+
+/** Retrieves the compiler's cache directory, and creates it if necessary.
+	This is `$XDG_CACHE_HOME/rmbrtbc`, or `$HOME/.cache/rmbrtbc`.
+@param[out] path:
+	Receives the directory's path.
+	@dassert @nonnull
+@param[in] size:
+	The size of `path`.
+@return
+	Whether the directory exists. */
+_Nodiscard int rlc_backend_cache_directory(
+	char * path,
+	size_t size);
+
+/** Prepares the helper prelude for inclusion via `-include`.
+	The prelude is copied into the cache directory, and precompiled with the given flags, unless that was already done. The cache entry is keyed on the prelude's contents, the flags, and the identity of the C++ compiler, so that upgrading the compiler precompiles the prelude again. If the C++ compiler does not support precompiled headers, it parses the copied prelude instead, and precompiling is retried after a day.
+@param[in] helper:
+	The prelude's path.
+	@dassert @nonnull
+@param[in] flags:
+	The null-terminated compile flags, without the program name, input, and output.
+	@dassert @nonnull
+@param[out] header:
+	Receives the path of the header to include.
+	@dassert @nonnull
+@param[in] size:
+	The size of `header`.
+@return
+	Whether `header` can be included. If not, the prelude has to be prepended to the generated code. */
+_Nodiscard int rlc_backend_prelude(
+	char const * helper,
+	char const * const * flags,
+	char * header,
+	size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
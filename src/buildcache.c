@@ -0,0 +1,370 @@
+#include "buildcache.h"
+#include "malloc.h"
+#include "vector.h"
+#include "assert.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <linux/limits.h>
+#include <sys/stat.h>
+
+/** The file name extension of cache entries. */
+static char const k_extension[] = ".rlbc";
+
+/** The cache directory, or null if the cache is disabled. */
+static char * s_directory = NULL;
+/** The size the cache is trimmed to. */
+static uint64_t s_max_size = kRlcBuildCacheDefaultSize;
+static size_t s_hits = 0;
+static size_t s_misses = 0;
+static size_t s_evictions = 0;
+
+/** A cache entry found while trimming the cache. */
+struct RlcBuildCacheEntry
+{
+	char * fName;
+	uint64_t fSize;
+	/** The time the entry was last used. */
+	struct timespec fUsed;
+};
+
+void rlc_build_cache_enable(
+	char const * directory,
+	uint64_t max_size)
+{
+	RLC_DASSERT(directory != NULL);
+	RLC_DASSERT(s_directory == NULL);
+
+	size_t const length = strlen(directory);
+	rlc_malloc((void**)&s_directory, length + 1);
+	memcpy(s_directory, directory, length + 1);
+	mkdir(directory, 0777);
+	s_max_size = max_size;
+}
+
+int rlc_build_cache_enabled(void)
+{
+	return s_directory != NULL;
+}
+
+/** Finds a program in `PATH`, the way `posix_spawnp()` does.
+@return
+	Whether the program was found. */
+static int find_program(
+	char const * program,
+	char * path,
+	size_t size)
+{
+	if(strchr(program, '/'))
+		return (size_t)snprintf(path, size, "%s", program) < size;
+
+	char const * dirs = getenv("PATH");
+	if(!dirs)
+		dirs = "/usr/local/bin:/usr/bin:/bin";
+	for(char const * end; *dirs; dirs = *end ? end + 1 : end)
+	{
+		end = strchr(dirs, ':');
+		if(!end)
+			end = dirs + strlen(dirs);
+		int const length = (int)(end - dirs);
+		if((size_t)snprintf(path, size, "%.*s/%s", length, length ? dirs : ".", program) < size
+		&& !access(path, X_OK))
+			return 1;
+	}
+	return 0;
+}
+
+void rlc_build_cache_key_create(
+	struct RlcBuildCacheKey * this,
+	char const * compiler)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(compiler != NULL);
+
+	rlc_sha256_create(&this->fHash);
+	rlc_build_cache_key_add_string(this, compiler);
+
+	// Compiler drivers are usually symbolic links to the versioned executable.
+	char path[PATH_MAX], real[PATH_MAX];
+	struct stat info;
+	if(find_program(compiler, path, sizeof(path))
+	&& realpath(path, real)
+	&& !stat(real, &info))
+	{
+		uint64_t const identity[3] = {
+			info.st_size,
+			info.st_mtim.tv_sec,
+			info.st_mtim.tv_nsec
+		};
+		rlc_build_cache_key_add_string(this, real);
+		rlc_build_cache_key_add(this, identity, sizeof(identity));
+	}
+}
+
+void rlc_build_cache_key_add(
+	struct RlcBuildCacheKey * this,
+	void const * data,
+	size_t size)
+{
+	RLC_DASSERT(this != NULL);
+
+	rlc_sha256_add(&this->fHash, data, size);
+}
+
+void rlc_build_cache_key_add_string(
+	struct RlcBuildCacheKey * this,
+	char const * string)
+{
+	RLC_DASSERT(string != NULL);
+	rlc_build_cache_key_add(this, string, strlen(string) + 1);
+}
+
+void rlc_build_cache_key_digest(
+	struct RlcBuildCacheKey const * this,
+	uint8_t digest[kRlcBuildCacheDigestSize])
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(digest != NULL);
+
+	uint8_t full[kRlcSha256Size];
+	rlc_sha256_digest(&this->fHash, full);
+	memcpy(digest, full, kRlcBuildCacheDigestSize);
+}
+
+/** Builds the path of a cache entry. */
+static int entry_path(
+	struct RlcBuildCacheKey const * key,
+	char * path,
+	size_t size)
+{
+	uint8_t digest[kRlcBuildCacheDigestSize];
+	rlc_build_cache_key_digest(key, digest);
+
+	char name[2 * kRlcBuildCacheDigestSize + 1];
+	for(size_t i = 0; i < kRlcBuildCacheDigestSize; i++)
+		sprintf(name + 2 * i, "%02x", digest[i]);
+	return (size_t)snprintf(path, size, "%s/%s%s", s_directory, name, k_extension) < size;
+}
+
+/** Copies a file's contents into an open file.
+@return
+	Whether the whole file was copied. */
+static int copy_to(
+	char const * source,
+	int out)
+{
+	int const in = open(source, O_RDONLY);
+	if(in == -1)
+		return 0;
+
+	static char buffer[1 << 16];
+	ssize_t size;
+	int success = 1;
+	while(success && (size = read(in, buffer, sizeof(buffer))))
+	{
+		if(size == -1)
+		{
+			success = errno == EINTR;
+			continue;
+		}
+		for(char const * p = buffer; success && size;)
+		{
+			ssize_t const written = write(out, p, size);
+			if(written > 0)
+			{
+				p += written;
+				size -= written;
+			} else
+				success = written == -1 && errno == EINTR;
+		}
+	}
+	close(in);
+	return success;
+}
+
+int rlc_build_cache_fetch(
+	struct RlcBuildCacheKey const * this,
+	char const * destination)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(destination != NULL);
+
+	if(!s_directory)
+		return 0;
+
+	char path[PATH_MAX];
+	if(!entry_path(this, path, sizeof(path)) || access(path, R_OK))
+	{
+		++s_misses;
+		return 0;
+	}
+
+	// The destination is replaced, not overwritten, in case it is a running executable.
+	unlink(destination);
+	int const out = open(destination, O_WRONLY | O_CREAT | O_TRUNC, 0777);
+	if(out == -1)
+	{
+		++s_misses;
+		return 0;
+	}
+	int const success = copy_to(path, out);
+	close(out);
+	if(!success)
+	{
+		unlink(destination);
+		++s_misses;
+		return 0;
+	}
+
+	// The modification time records the last use, for eviction.
+	utimensat(AT_FDCWD, path, NULL, 0);
+	++s_hits;
+	return 1;
+}
+
+void rlc_build_cache_store(
+	struct RlcBuildCacheKey const * this,
+	char const * source)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(source != NULL);
+
+	if(!s_directory)
+		return;
+
+	char path[PATH_MAX], temp[PATH_MAX + 16];
+	if(!entry_path(this, path, sizeof(path)))
+		return;
+	snprintf(temp, sizeof(temp), "%s.tmp-XXXXXX", path);
+
+	// Entries are written under a temporary name, so that concurrent runs never see partial entries.
+	int const out = mkstemp(temp);
+	if(out == -1)
+		return;
+	int const success = copy_to(source, out);
+	close(out);
+	if(!success || rename(temp, path))
+		unlink(temp);
+}
+
+static int compare_use(
+	void const * lhs,
+	void const * rhs)
+{
+	struct timespec const * a = &((struct RlcBuildCacheEntry const *)lhs)->fUsed;
+	struct timespec const * b = &((struct RlcBuildCacheEntry const *)rhs)->fUsed;
+	if(a->tv_sec != b->tv_sec)
+		return a->tv_sec < b->tv_sec ? -1 : 1;
+	return (a->tv_nsec > b->tv_nsec) - (a->tv_nsec < b->tv_nsec);
+}
+
+/** Lists all cache entries.
+@return
+	The total size of all entries. */
+static uint64_t list_entries(
+	struct RlcBuildCacheEntry ** entries,
+	size_t * count)
+{
+	*entries = NULL;
+	*count = 0;
+
+	DIR * dir = opendir(s_directory);
+	if(!dir)
+		return 0;
+
+	uint64_t total = 0;
+	size_t const extension = sizeof(k_extension) - 1;
+	for(struct dirent * ent; (ent = readdir(dir));)
+	{
+		size_t const length = strlen(ent->d_name);
+		if(length <= extension
+		|| strcmp(ent->d_name + length - extension, k_extension))
+			continue;
+
+		struct stat info;
+		if(fstatat(dirfd(dir), ent->d_name, &info, 0) || !S_ISREG(info.st_mode))
+			continue;
+
+		struct RlcBuildCacheEntry * entry = &RLC_VECTOR_PUSH(NULL, *entries, *count);
+		entry->fName = NULL;
+		rlc_malloc((void**)&entry->fName, length + 1);
+		memcpy(entry->fName, ent->d_name, length + 1);
+		entry->fSize = info.st_size;
+		entry->fUsed = info.st_mtim;
+		total += info.st_size;
+	}
+	closedir(dir);
+	return total;
+}
+
+static void free_entries(
+	struct RlcBuildCacheEntry ** entries,
+	size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+		rlc_free((void**)&(*entries)[i].fName);
+	rlc_vector_free((void**)entries);
+}
+
+void rlc_build_cache_trim(void)
+{
+	if(!s_directory)
+		return;
+
+	struct RlcBuildCacheEntry * entries;
+	size_t count;
+	uint64_t total = list_entries(&entries, &count);
+	if(total > s_max_size)
+	{
+		qsort(entries, count, sizeof(struct RlcBuildCacheEntry), &compare_use);
+
+		DIR * dir = opendir(s_directory);
+		for(size_t i = 0; dir && i < count && total > s_max_size; i++)
+			if(!unlinkat(dirfd(dir), entries[i].fName, 0))
+			{
+				total -= entries[i].fSize;
+				++s_evictions;
+			}
+		if(dir)
+			closedir(dir);
+	}
+	free_entries(&entries, count);
+}
+
+void rlc_build_cache_print_stats(
+	FILE * out)
+{
+	RLC_DASSERT(out != NULL);
+
+	if(!s_directory)
+	{
+		fputs("build cache: disabled.\n", out);
+		return;
+	}
+
+	struct RlcBuildCacheEntry * entries;
+	size_t count;
+	uint64_t const total = list_entries(&entries, &count);
+	free_entries(&entries, count);
+
+	fprintf(out, "build cache: %zu hits, %zu misses, %zu evicted, %zu entries, %.1f of %.1f MiB.\n",
+		s_hits,
+		s_misses,
+		s_evictions,
+		count,
+		total / (1024.0 * 1024.0),
+		s_max_size / (1024.0 * 1024.0));
+}
+
+void rlc_build_cache_free(void)
+{
+	if(s_directory)
+		rlc_free((void**)&s_directory);
+	s_hits = 0;
+	s_misses = 0;
+	s_evictions = 0;
+}
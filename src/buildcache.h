@@ -0,0 +1,134 @@
+/** @file buildcache.h
+	Contains the on-disk cache of C++ compiler results.
+	An entry holds an executable or object file, and is keyed on the generated C++ code, the compile flags, and the identity of the C++ compiler. Unchanged programs are therefore never compiled twice. Entries are evicted in least recently used order once the cache exceeds its size limit. */
+#ifndef __rlc_buildcache_h_defined
+#define __rlc_buildcache_h_defined
+
+#include "macros.h"
+#include "sha256.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The default size limit of the build cache, in bytes. */
+#define kRlcBuildCacheDefaultSize ((uint64_t)1 << 30)
+
+/** The size of a build cache key's digest, in bytes. */
+#define kRlcBuildCacheDigestSize ((size_t)16)
+
+/** Identifies a compiler result by everything it depends on. */
+struct RlcBuildCacheKey
+{
+	/** The SHA-256 hash of everything added, as a collision hands out a wrong binary. */
+	struct RlcSha256 fHash;
+};
+
+/** Enables the build cache.
+	Creates the cache directory if it does not exist.
+@param[in] directory:
+	The directory to store cache entries in.
+	@dassert @nonnull
+@param[in] max_size:
+	The size in bytes that the cache is trimmed to. */
+void rlc_build_cache_enable(
+	char const * directory,
+	uint64_t max_size);
+
+/** Whether the build cache is enabled. */
+_Nodiscard int rlc_build_cache_enabled(void);
+
+/** Starts a key for a result of a C++ compiler.
+@memberof RlcBuildCacheKey
+@param[out] this:
+	The key to start.
+	@dassert @nonnull
+@param[in] compiler:
+	The compiler's program name, which is looked up in `PATH`. Its resolved path, size, and modification time identify it.
+	@dassert @nonnull */
+void rlc_build_cache_key_create(
+	struct RlcBuildCacheKey * this,
+	char const * compiler);
+
+/** Adds data that the result depends on to a key.
+@memberof RlcBuildCacheKey
+@param[in,out] this:
+	The key.
+	@dassert @nonnull
+@param[in] data:
+	The data.
+@param[in] size:
+	The data's size. */
+void rlc_build_cache_key_add(
+	struct RlcBuildCacheKey * this,
+	void const * data,
+	size_t size);
+
+/** Adds a null-terminated string to a key, see `rlc_build_cache_key_add()`. */
+void rlc_build_cache_key_add_string(
+	struct RlcBuildCacheKey * this,
+	char const * string);
+
+/** Computes a key's digest, which names its cache entry.
+	More data can be added to the key afterwards.
+@memberof RlcBuildCacheKey
+@param[in] this:
+	The key.
+	@dassert @nonnull
+@param[out] digest:
+	The SHA-256 hash of the key's data, truncated to 128 bits.
+	@dassert @nonnull */
+void rlc_build_cache_key_digest(
+	struct RlcBuildCacheKey const * this,
+	uint8_t digest[kRlcBuildCacheDigestSize]);
+
+/** Copies a cached result to a file, and records a hit or miss.
+@memberof RlcBuildCacheKey
+@param[in] this:
+	The result's key.
+	@dassert @nonnull
+@param[in] destination:
+	The file to create or overwrite.
+	@dassert @nonnull
+@return
+	Whether the result was cached. If the cache is disabled, fails. */
+_Nodiscard int rlc_build_cache_fetch(
+	struct RlcBuildCacheKey const * this,
+	char const * destination);
+
+/** Stores a compiler result in the build cache.
+	Does nothing if the cache is disabled.
+@memberof RlcBuildCacheKey
+@param[in] this:
+	The result's key.
+	@dassert @nonnull
+@param[in] source:
+	The file containing the result.
+	@dassert @nonnull */
+void rlc_build_cache_store(
+	struct RlcBuildCacheKey const * this,
+	char const * source);
+
+/** Evicts the least recently used entries until the cache fits its size limit.
+	Does nothing if the cache is disabled. */
+void rlc_build_cache_trim(void);
+
+/** Prints the number of hits, misses, evictions, and the cache's size.
+@param[in] out:
+	The stream to print to.
+	@dassert @nonnull */
+void rlc_build_cache_print_stats(
+	FILE * out);
+
+/** Disables the build cache. */
+void rlc_build_cache_free(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,210 @@
+#include "diagnostics.h"
+#include "malloc.h"
+#include "vector.h"
+#include "assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+/** A collected error and its notes. */
+struct RlcDiagnostic
+{
+	/** The file name, which sorts errors by file. */
+	char * fFile;
+	/** The error's source index, which sorts errors within a file. */
+	RlcSrcIndex fIndex;
+	/** The order in which the error was reported, which keeps sorting stable. */
+	size_t fOrder;
+	/** The error's printed lines. */
+	char * fText;
+	/** The length of `fText`. */
+	size_t fLength;
+};
+
+/** Protects all collected errors. */
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+/** The collected errors. */
+static struct RlcDiagnostic * s_errors = NULL;
+/** The number of collected errors. */
+static size_t s_error_count = 0;
+/** The number of errors reported since the program started. */
+static size_t s_total = 0;
+/** The number of errors that were already printed. */
+static size_t s_flushed = 0;
+/** The maximum number of errors, or 0. */
+static size_t s_limit = kRlcDiagnosticsDefaultLimit;
+/** The order of the calling thread's last reported error, which receives its notes. */
+static _Thread_local size_t s_last = SIZE_MAX;
+
+/** Appends a formatted line to an error. */
+static void append_line(
+	struct RlcDiagnostic * this,
+	struct RlcSrcFile const * file,
+	RlcSrcIndex index,
+	char const * kind,
+	char const * format,
+	va_list args)
+{
+	struct RlcSrcPosition pos;
+	rlc_src_file_position(file, &pos, index);
+
+	va_list copy;
+	va_copy(copy, args);
+	int const prefix = snprintf(NULL, 0, "%s:%u:%u: %s: ",
+		file->fName, pos.line, pos.column, kind);
+	int const message = vsnprintf(NULL, 0, format, copy);
+	va_end(copy);
+	RLC_ASSERT(prefix >= 0 && message >= 0);
+
+	size_t const length = this->fLength + prefix + message + 1;
+	if(this->fText)
+		rlc_realloc((void**)&this->fText, length + 1);
+	else
+		rlc_malloc((void**)&this->fText, length + 1);
+
+	char * out = this->fText + this->fLength;
+	snprintf(out, prefix + 1, "%s:%u:%u: %s: ",
+		file->fName, pos.line, pos.column, kind);
+	vsnprintf(out + prefix, message + 1, format, args);
+	out[prefix + message] = '\n';
+	out[prefix + message + 1] = '\0';
+	this->fLength = length;
+}
+
+static int compare(
+	void const * lhs,
+	void const * rhs)
+{
+	struct RlcDiagnostic const * a = lhs, * b = rhs;
+	int const file = strcmp(a->fFile, b->fFile);
+	if(file)
+		return file;
+	if(a->fIndex != b->fIndex)
+		return a->fIndex < b->fIndex ? -1 : 1;
+	return a->fOrder < b->fOrder ? -1 : a->fOrder > b->fOrder;
+}
+
+/** Prints and frees all collected errors. Must be called with `s_lock` held. */
+static size_t flush_locked(void)
+{
+	size_t const count = s_error_count;
+	if(count)
+		qsort(s_errors, count, sizeof(struct RlcDiagnostic), &compare);
+
+	fflush(stdout);
+	for(size_t i = 0; i < count; i++)
+	{
+		fwrite(s_errors[i].fText, 1, s_errors[i].fLength, stderr);
+		rlc_free((void**)&s_errors[i].fText);
+		rlc_free((void**)&s_errors[i].fFile);
+	}
+	fflush(stderr);
+
+	rlc_vector_free((void**)&s_errors);
+	s_error_count = 0;
+	s_flushed = s_total;
+	return count;
+}
+
+void rlc_diagnostics_set_limit(
+	size_t limit)
+{
+	pthread_mutex_lock(&s_lock);
+	s_limit = limit;
+	pthread_mutex_unlock(&s_lock);
+}
+
+void rlc_diagnostics_error(
+	struct RlcSrcFile const * file,
+	RlcSrcIndex index,
+	char const * format,
+	...)
+{
+	va_list args;
+	va_start(args, format);
+	rlc_diagnostics_error_v(file, index, format, args);
+	va_end(args);
+}
+
+void rlc_diagnostics_error_v(
+	struct RlcSrcFile const * file,
+	RlcSrcIndex index,
+	char const * format,
+	va_list args)
+{
+	RLC_DASSERT(file != NULL);
+	RLC_DASSERT(format != NULL);
+
+	pthread_mutex_lock(&s_lock);
+
+	// The limit is checked before adding an error, so that the last error still receives its notes.
+	if(s_limit && s_total == s_limit)
+	{
+		flush_locked();
+		fputs("error: too many errors, stopping.\n", stderr);
+		fflush(stderr);
+		exit(EXIT_FAILURE);
+	}
+
+	struct RlcDiagnostic * error = &RLC_VECTOR_PUSH(NULL, s_errors, s_error_count);
+	size_t const name_length = strlen(file->fName);
+	error->fFile = NULL;
+	rlc_malloc((void**)&error->fFile, name_length + 1);
+	memcpy(error->fFile, file->fName, name_length + 1);
+	error->fIndex = index;
+	error->fOrder = s_total++;
+	error->fText = NULL;
+	error->fLength = 0;
+	append_line(error, file, index, "error", format, args);
+
+	s_last = error->fOrder;
+
+	pthread_mutex_unlock(&s_lock);
+}
+
+void rlc_diagnostics_note(
+	struct RlcSrcFile const * file,
+	RlcSrcIndex index,
+	char const * format,
+	...)
+{
+	RLC_DASSERT(file != NULL);
+	RLC_DASSERT(format != NULL);
+
+	pthread_mutex_lock(&s_lock);
+	// Errors are stored in the order they were reported, until they are flushed.
+	if(s_last != SIZE_MAX && s_last >= s_flushed)
+	{
+		va_list args;
+		va_start(args, format);
+		append_line(&s_errors[s_last - s_flushed], file, index, "note", format, args);
+		va_end(args);
+	}
+	pthread_mutex_unlock(&s_lock);
+}
+
+size_t rlc_diagnostics_count(void)
+{
+	pthread_mutex_lock(&s_lock);
+	size_t const count = s_total;
+	pthread_mutex_unlock(&s_lock);
+	return count;
+}
+
+size_t rlc_diagnostics_flush(void)
+{
+	pthread_mutex_lock(&s_lock);
+	size_t const count = flush_locked();
+	pthread_mutex_unlock(&s_lock);
+	return count;
+}
+
+_Noreturn void rlc_diagnostics_fail(void)
+{
+	pthread_mutex_lock(&s_lock);
+	flush_locked();
+	exit(EXIT_FAILURE);
+}
@@ -0,0 +1,81 @@
+/** @file diagnostics.h
+	Contains the diagnostics engine that collects the compiler's error messages.
+	Errors are collected instead of terminating the program, so that a single run reports as many errors as possible. They are printed sorted by file and position, so that the output does not depend on the order in which files were parsed. Errors can be reported from multiple threads at once. */
+#ifndef __rlc_diagnostics_h_defined
+#define __rlc_diagnostics_h_defined
+
+#include "src/file.h"
+#include "macros.h"
+
+#include <stddef.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The default number of errors after which compilation stops. */
+#define kRlcDiagnosticsDefaultLimit ((size_t)20)
+
+/** Sets the number of errors after which compilation stops.
+	Once the limit is reached, all collected errors are printed, and the program terminates.
+@param[in] limit:
+	The maximum error count, or 0 for no limit. */
+void rlc_diagnostics_set_limit(
+	size_t limit);
+
+/** Reports an error.
+	The message is prefixed with the file name and position, and should end with a period.
+@param[in] file:
+	The file containing the error.
+	@dassert @nonnull
+@param[in] index:
+	The error's source index.
+@param[in] format:
+	The message's `printf`-style format string.
+	@dassert @nonnull */
+void rlc_diagnostics_error(
+	struct RlcSrcFile const * file,
+	RlcSrcIndex index,
+	char const * format,
+	...);
+
+/** Reports an error, see `rlc_diagnostics_error()`. */
+void rlc_diagnostics_error_v(
+	struct RlcSrcFile const * file,
+	RlcSrcIndex index,
+	char const * format,
+	va_list args);
+
+/** Attaches a line to the error last reported by the calling thread.
+	Notes are printed directly after their error, regardless of their position.
+@param[in] file:
+	The file the note refers to.
+	@dassert @nonnull
+@param[in] index:
+	The note's source index.
+@param[in] format:
+	The note's `printf`-style format string.
+	@dassert @nonnull */
+void rlc_diagnostics_note(
+	struct RlcSrcFile const * file,
+	RlcSrcIndex index,
+	char const * format,
+	...);
+
+/** Retrieves the number of errors reported so far. */
+_Nodiscard size_t rlc_diagnostics_count(void);
+
+/** Prints and discards all collected errors.
+@return
+	The number of printed errors. */
+size_t rlc_diagnostics_flush(void);
+
+/** Prints all collected errors and terminates the program. */
+_Noreturn void rlc_diagnostics_fail(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+#include "hashmap.h"
+#include "malloc.h"
+#include "assert.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+/** The entry count of a map's first allocation. */
+enum { kInitialCapacity = 16 };
+
+static size_t hash_string(
+	void const * key)
+{
+	// FNV-1a.
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for(unsigned char const * c = key; *c; c++)
+		hash = (hash ^ *c) * 0x100000001b3ull;
+	return (size_t) hash;
+}
+
+static size_t hash_pointer(
+	void const * key)
+{
+	uint64_t hash = (uint64_t)(uintptr_t) key * 0x9e3779b97f4a7c15ull;
+	return (size_t) (hash ^ (hash >> 32));
+}
+
+static int equals_string(
+	void const * a,
+	void const * b)
+{
+	return !strcmp(a, b);
+}
+
+static int equals_pointer(
+	void const * a,
+	void const * b)
+{
+	return a == b;
+}
+
+static struct {
+	size_t (*fHash)(void const *);
+	int (*fEquals)(void const *, void const *);
+} const k_key_types[] = {
+	{ &hash_string, &equals_string },
+	{ &hash_pointer, &equals_pointer }
+};
+
+static_assert(RLC_COVERS_ENUM(k_key_types, RlcHashMapKey), "ill-sized key type table.");
+
+/** Hashes a key. Never returns 0, which marks empty entries. */
+static size_t hash(
+	struct RlcHashMap const * this,
+	void const * key)
+{
+	size_t const h = k_key_types[this->fKeyType].fHash(key);
+	return h ? h : 1;
+}
+
+/** Finds a key's entry, or the empty entry it would be inserted at. */
+static struct RlcHashMapEntry * probe(
+	struct RlcHashMap const * this,
+	void const * key,
+	size_t h)
+{
+	size_t const mask = this->fCapacity - 1;
+	for(size_t i = h & mask;; i = (i + 1) & mask)
+	{
+		struct RlcHashMapEntry * entry = &this->fEntries[i];
+		if(!entry->fHash)
+			return entry;
+		if(entry->fHash == h
+		&& k_key_types[this->fKeyType].fEquals(entry->fKey, key))
+			return entry;
+	}
+}
+
+/** Reallocates the entries and reinserts all keys. */
+static void rehash(
+	struct RlcHashMap * this,
+	size_t capacity)
+{
+	struct RlcHashMapEntry * entries = this->fEntries;
+	size_t const old_capacity = this->fCapacity;
+
+	this->fEntries = NULL;
+	this->fCapacity = capacity;
+	rlc_malloc(
+		(void**)&this->fEntries,
+		capacity * sizeof(struct RlcHashMapEntry));
+	memset(this->fEntries, 0, capacity * sizeof(struct RlcHashMapEntry));
+
+	if(entries)
+	{
+		for(size_t i = 0; i < old_capacity; i++)
+			if(entries[i].fHash)
+				*probe(this, entries[i].fKey, entries[i].fHash) = entries[i];
+		rlc_free((void**)&entries);
+	}
+}
+
+void rlc_hash_map_create(
+	struct RlcHashMap * this,
+	enum RlcHashMapKey key_type)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(RLC_IN_ENUM(key_type, RlcHashMapKey));
+
+	this->fKeyType = key_type;
+	this->fEntries = NULL;
+	this->fCapacity = 0;
+	this->fCount = 0;
+}
+
+void rlc_hash_map_destroy(
+	struct RlcHashMap * this)
+{
+	RLC_DASSERT(this != NULL);
+
+	if(this->fEntries)
+		rlc_free((void**)&this->fEntries);
+	this->fCapacity = 0;
+	this->fCount = 0;
+}
+
+void ** rlc_hash_map_find(
+	struct RlcHashMap const * this,
+	void const * key)
+{
+	RLC_DASSERT(this != NULL);
+
+	if(!this->fCount)
+		return NULL;
+
+	struct RlcHashMapEntry * entry = probe(this, key, hash(this, key));
+	return entry->fHash ? &entry->fValue : NULL;
+}
+
+int rlc_hash_map_insert(
+	struct RlcHashMap * this,
+	void const * key,
+	void * value)
+{
+	RLC_DASSERT(this != NULL);
+
+	// Keep the load factor at most 1/2, so that probe sequences stay short.
+	if(2 * (this->fCount + 1) > this->fCapacity)
+		rehash(this, this->fCapacity ? 2 * this->fCapacity : kInitialCapacity);
+
+	size_t const h = hash(this, key);
+	struct RlcHashMapEntry * entry = probe(this, key, h);
+	if(entry->fHash)
+		return 0;
+
+	entry->fHash = h;
+	entry->fKey = key;
+	entry->fValue = value;
+	++this->fCount;
+	return 1;
+}
+
+uint64_t rlc_hash_bytes(
+	void const * data,
+	size_t size,
+	uint64_t seed)
+{
+	static uint64_t const k_prime = 0x9e3779b97f4a7c15u;
+	unsigned char const * bytes = data;
+	uint64_t h = seed ^ (size * k_prime);
+	for(; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(uint64_t));
+		h = (h ^ word) * k_prime;
+		h ^= h >> 29;
+	}
+	for(; size; size--)
+		h = (h ^ *bytes++) * k_prime;
+	return h ^ (h >> 32);
+}
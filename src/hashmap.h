@@ -0,0 +1,118 @@
+/** @file hashmap.h
+	Contains the hash map used to index registries and lists by key. */
+#ifndef __rlc_hashmap_h_defined
+#define __rlc_hashmap_h_defined
+
+#include "macros.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** How a hash map's keys are hashed and compared. */
+enum RlcHashMapKey
+{
+	/** Keys are null-terminated strings, compared by contents. */
+	kRlcHashMapKeyString,
+	/** Keys are addresses, compared by identity. */
+	kRlcHashMapKeyPointer,
+
+	RLC_ENUM_END(RlcHashMapKey)
+};
+
+/** A hash map entry. */
+struct RlcHashMapEntry
+{
+	/** The key's hash, or 0 if the entry is empty. */
+	size_t fHash;
+	/** The entry's key. Not owned by the map. */
+	void const * fKey;
+	/** The entry's value. */
+	void * fValue;
+};
+
+/** An open-addressing hash map.
+	Entries cannot be removed. */
+struct RlcHashMap
+{
+	/** How keys are hashed and compared. */
+	enum RlcHashMapKey fKeyType;
+	/** The entries. Their count is always a power of two. */
+	struct RlcHashMapEntry * fEntries;
+	/** The entry count. */
+	size_t fCapacity;
+	/** The number of keys in the map. */
+	size_t fCount;
+};
+
+/** Creates an empty hash map.
+@memberof RlcHashMap
+@param[out] this:
+	The hash map to create.
+	@dassert @nonnull
+@param[in] key_type:
+	How the map's keys are hashed and compared. */
+void rlc_hash_map_create(
+	struct RlcHashMap * this,
+	enum RlcHashMapKey key_type);
+
+/** Destroys a hash map.
+	Does not destroy the keys or values.
+@memberof RlcHashMap
+@param[in,out] this:
+	The hash map to destroy.
+	@dassert @nonnull */
+void rlc_hash_map_destroy(
+	struct RlcHashMap * this);
+
+/** Looks up a key's value.
+@memberof RlcHashMap
+@param[in] this:
+	The hash map to search.
+	@dassert @nonnull
+@param[in] key:
+	The key to look up.
+@return
+	The address of the key's value, or null if the key is not in the map. */
+_Nodiscard void ** rlc_hash_map_find(
+	struct RlcHashMap const * this,
+	void const * key);
+
+/** Inserts a key, unless it is already in the map.
+@memberof RlcHashMap
+@param[in,out] this:
+	The hash map to insert into.
+	@dassert @nonnull
+@param[in] key:
+	The key to insert. Must remain valid while it is in the map.
+@param[in] value:
+	The key's value.
+@return
+	Whether the key was inserted. If the key was already in the map, its value is left as it is. */
+int rlc_hash_map_insert(
+	struct RlcHashMap * this,
+	void const * key,
+	void * value);
+
+/** Hashes a block of memory, for keys that outlive the program, such as cache file names.
+@param[in] data:
+	The data to hash.
+@param[in] size:
+	The data's size.
+@param[in] seed:
+	The hash to continue from, or 0.
+@return
+	The data's hash. */
+_Nodiscard uint64_t rlc_hash_bytes(
+	void const * data,
+	size_t size,
+	uint64_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
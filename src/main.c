@@ -1,72 +1,640 @@
 #include "scoper/fileregistry.h"
 #include "printer.h"
 #include "parser/symbolconstantexpression.h"
+#include "parser/parsecache.h"
+#include "src/identifier.h"
+#include "diagnostics.h"
 #include "unicode.h"
 #include "malloc.h"
+#include "arena.h"
 #include "fs.h"
+#include "backend.h"
+#include "buildcache.h"
+#include "assert.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <errno.h>
 #include <linux/limits.h>
 #include <unistd.h>
-#include <sys/socket.h>
+#include <signal.h>
+#include <dirent.h>
+#include <sys/stat.h>
 
-void pipe_file(
-	char const * src,
-	int pipe)
+/** How the generated code is optimised. */
+enum BuildProfile
 {
-	char buf[1024];
-	FILE * f = fopen(src, "r");
-	if(!f)
+	/** Unoptimised, with debug information. */
+	kBuildProfileDebug,
+	/** Optimised. */
+	kBuildProfileRelease,
+	/** Optimised across translation units at link time. */
+	kBuildProfileReleaseLto
+};
+
+/** The maximum number of compile or link flags. */
+enum { kMaxFlags = 16 };
+
+/** The null-terminated flags the generated code is compiled with. */
+static char const * s_compile_flags[kMaxFlags + 1] = {
+	"-std=c++2a", "-fcoroutines", "-pthread", "-Wfatal-errors", "-Werror"
+};
+static size_t s_compile_flag_count = 5;
+/** The null-terminated flags translation units are linked with. */
+static char const * s_link_flags[kMaxFlags + 1] = { "-pthread" };
+static size_t s_link_flag_count = 1;
+/** The size of the profile directory's path, which may have the `/a.out.profile` suffix appended to the working directory. */
+enum { kPgoDirectorySize = PATH_MAX + sizeof("/a.out.profile") };
+/** The profile-guided optimisation flags, which name the profile directory. */
+static char s_pgo_flag[sizeof("-fprofile-generate=") + kPgoDirectorySize];
+/** Set for profile-guided optimisation, so that profile data is named independently of where the objects are built. */
+static char s_pgo_prefix_flag[sizeof("-fprofile-prefix-path=") + PATH_MAX];
+
+/** Adds flags to the compile or link flags. */
+static void add_flags(
+	int compile,
+	int link,
+	size_t count,
+	char const * const * flags)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		if(compile)
+		{
+			RLC_ASSERT(s_compile_flag_count < kMaxFlags);
+			s_compile_flags[s_compile_flag_count++] = flags[i];
+		}
+		if(link)
+		{
+			RLC_ASSERT(s_link_flag_count < kMaxFlags);
+			s_link_flags[s_link_flag_count++] = flags[i];
+		}
+	}
+}
+
+/** Selects the flags for a build profile and profile-guided optimisation.
+@param[in] profile:
+	The build profile.
+@param[in] pgo_generate:
+	If not null, the absolute directory that the instrumented program writes its profile to.
+@param[in] pgo_use:
+	If not null, the absolute directory of the profile to optimise with. */
+static void set_build_flags(
+	enum BuildProfile profile,
+	char const * pgo_generate,
+	char const * pgo_use)
+{
+	switch(profile)
+	{
+	case kBuildProfileDebug:
+		add_flags(1, 1, 1, (char const *[]){ "-g" });
+		break;
+	case kBuildProfileRelease:
+		add_flags(1, 0, 1, (char const *[]){ "-O2" });
+		break;
+	case kBuildProfileReleaseLto:
+		// Link-time optimisation happens in the link step, which needs the optimisation flags again.
+		add_flags(1, 1, 2, (char const *[]){ "-O2", "-flto=auto" });
+		break;
+	}
+
+	if(pgo_generate)
+	{
+		snprintf(s_pgo_flag, sizeof(s_pgo_flag), "-fprofile-generate=%s", pgo_generate);
+		// Generated programs may use threads, whose counter updates must not be lost.
+		add_flags(1, 1, 2, (char const *[]){ s_pgo_flag, "-fprofile-update=prefer-atomic" });
+	} else if(pgo_use)
+	{
+		snprintf(s_pgo_flag, sizeof(s_pgo_flag), "-fprofile-use=%s", pgo_use);
+		add_flags(1, 1, 1, (char const *[]){ s_pgo_flag });
+		// Code that changed or never ran is compiled without profile, instead of failing the build. Whether every unit has profile data is checked beforehand.
+		add_flags(1, 0, 2, (char const *[]){ "-Wno-error=missing-profile", "-Wno-error=coverage-mismatch" });
+	}
+	s_compile_flags[s_compile_flag_count] = NULL;
+	s_link_flags[s_link_flag_count] = NULL;
+}
+
+/** Selects the directory whose path is stripped from profile data file names.
+	Profile data is named after the output file's absolute path, so stripping the directory the compiler runs in keeps names stable between builds.
+@param[in] directory:
+	The directory the objects are built in, or null if profile-guided optimisation is disabled.
+@return
+	The flag to pass to the compiler, or null. */
+static char const * pgo_prefix_flag(
+	char const * directory)
+{
+	if(!directory || !s_pgo_flag[0])
+		return NULL;
+	snprintf(s_pgo_prefix_flag, sizeof(s_pgo_prefix_flag), "-fprofile-prefix-path=%s", directory);
+	return s_pgo_prefix_flag;
+}
+
+/** Whether the profile's contents were hashed into `s_profile_digest`. */
+static int s_profile_digested = 0;
+/** The SHA-256 hash of the profile's data files, which compiler results depend on. */
+static uint8_t s_profile_digest[kRlcSha256Size];
+
+/** Selects profile data files for `scandir()`. */
+static int is_profile_data(
+	struct dirent const * entry)
+{
+	size_t const length = strlen(entry->d_name);
+	return length > 5 && !strcmp(entry->d_name + length - 5, ".gcda");
+}
+
+/** Prepares the directory that an instrumented program records its profile in.
+	Profile data is only valid for the partitioning it was recorded with, so the number of translation units is stored alongside it, and data of previous builds is removed.
+@param[in] directory:
+	The profile directory.
+	@dassert @nonnull
+@param[in] unit_count:
+	The number of translation units the program is built from.
+@return
+	Whether the directory was prepared. */
+static int pgo_record(
+	char const * directory,
+	unsigned unit_count)
+{
+	RLC_DASSERT(directory != NULL);
+
+	if(mkdir(directory, 0777) && errno != EEXIST)
+	{
+		perror(directory);
+		return 0;
+	}
+
+	struct dirent ** entries;
+	int const count = scandir(directory, &entries, is_profile_data, alphasort);
+	if(count < 0)
+	{
+		perror(directory);
+		return 0;
+	}
+	char path[PATH_MAX];
+	for(int i = 0; i < count; i++)
+	{
+		snprintf(path, sizeof(path), "%s/%s", directory, entries[i]->d_name);
+		unlink(path);
+		free(entries[i]);
+	}
+	free(entries);
+
+	snprintf(path, sizeof(path), "%s/units", directory);
+	FILE * file = fopen(path, "w");
+	int written = file && fprintf(file, "%u\n", unit_count) > 0;
+	if(file && fclose(file))
+		written = 0;
+	if(!written)
+	{
+		perror(path);
+		return 0;
+	}
+	return 1;
+}
+
+/** Loads a profile recorded by `--pgo-generate`.
+	Reads the number of translation units it was recorded with, and hashes its data files into `s_profile_digest`.
+@param[in] directory:
+	The profile directory.
+	@dassert @nonnull
+@param[out] unit_count:
+	The number of translation units to build, so that every unit finds its profile data.
+	@dassert @nonnull
+@return
+	Whether the profile is complete. */
+static int pgo_load(
+	char const * directory,
+	unsigned * unit_count)
+{
+	RLC_DASSERT(directory != NULL);
+	RLC_DASSERT(unit_count != NULL);
+
+	char path[PATH_MAX];
+	snprintf(path, sizeof(path), "%s/units", directory);
+	FILE * file = fopen(path, "r");
+	int const valid = file && fscanf(file, "%u", unit_count) == 1 && *unit_count;
+	if(file)
+		fclose(file);
+	if(!valid)
+	{
+		fprintf(stderr, "error: %s: not a profile recorded by --pgo-generate.\n", directory);
+		return 0;
+	}
+
+	struct dirent ** entries;
+	int const count = scandir(directory, &entries, is_profile_data, alphasort);
+	if(count < 0)
+	{
+		perror(directory);
+		return 0;
+	}
+	// The directory is emptied when recording, and the program writes data for every unit when it exits.
+	if((unsigned)count != *unit_count)
+		fprintf(stderr, "error: %s: %d of %u translation units have profile data, run the instrumented program first.\n", directory, count, *unit_count);
+
+	struct RlcSha256 hash;
+	rlc_sha256_create(&hash);
+	int success = (unsigned)count == *unit_count;
+	for(int i = 0; i < count; i++)
+	{
+		snprintf(path, sizeof(path), "%s/%s", directory, entries[i]->d_name);
+		char * contents;
+		size_t size;
+		if(success && !rlc_backend_read_file(path, &contents, &size))
+		{
+			perror(path);
+			success = 0;
+		} else if(success)
+		{
+			rlc_sha256_add(&hash, entries[i]->d_name, strlen(entries[i]->d_name) + 1);
+			rlc_sha256_add(&hash, &size, sizeof(size));
+			rlc_sha256_add(&hash, contents, size);
+			rlc_free((void**)&contents);
+		}
+		free(entries[i]);
+	}
+	free(entries);
+
+	rlc_sha256_digest(&hash, s_profile_digest);
+	s_profile_digested = success;
+	return success;
+}
+
+/** The process group of the compiler that the generated code is streamed into, or 0. */
+static volatile sig_atomic_t s_compiler_group = 0;
+/** The file the streamed compiler's error output is written to. */
+static char s_compiler_log[] = "/tmp/.rlc_log_XXXXXX";
+
+/** Terminates the streamed compiler along with this program, as it does not receive the terminal's signals. */
+static void forward_signal(
+	int signal_number)
+{
+	if(s_compiler_group > 0)
+	{
+		kill(-s_compiler_group, signal_number);
+		unlink(s_compiler_log);
+	}
+	signal(signal_number, SIG_DFL);
+	raise(signal_number);
+}
+
+/** Reports leaked allocations, and returns the program's exit code. */
+static int finish(
+	int status)
+{
+	size_t allocs;
+	if((allocs = rlc_allocations()))
+	{
+		fprintf(stderr, "Warning: leaked allocations: %zu (of which %zu arena blocks with %zu bytes).\n",
+			allocs,
+			rlc_arena_blocks(),
+			rlc_arena_bytes());
+	}
+
+	fflush(stdout);
+	fflush(stderr);
+	return status ? 0 : 1;
+}
+
+/** Writes a buffer to a file, or terminates the program. */
+static void write_or_exit(
+	FILE * out,
+	char const * data,
+	size_t size)
+{
+	if(size != fwrite(data, 1, size, out))
 	{
-		perror("fopen");
-		puts(src);
-		puts("\n");
-		abort();
+		perror("fwrite");
+		exit(1);
 	}
+}
+
+/** The generated code, split into sections. */
+struct GeneratedCode
+{
+	/** The declarations shared by all translation units, in order. */
+	char * fHeader[5];
+	size_t fHeaderSize[5];
+	/** The variable and function implementations. */
+	char * fImpl[2];
+	size_t fImplSize[2];
+};
+
+/** Starts the build cache key of code compiled with the given prelude.
+@param[out] key:
+	The key to start.
+@param[in] helper:
+	The path of the helper code that precedes the generated code.
+@param[in] precompiled:
+	Whether `helper` is the prepared prelude, which is passed via `-include`. */
+static void build_key_create(
+	struct RlcBuildCacheKey * key,
+	char const * helper,
+	int precompiled)
+{
+	rlc_build_cache_key_create(key, "c++");
+	for(size_t i = 0; i < s_compile_flag_count; i++)
+		rlc_build_cache_key_add_string(key, s_compile_flags[i]);
+	if(s_profile_digested)
+		rlc_build_cache_key_add(key, s_profile_digest, sizeof(s_profile_digest));
 
-	while(!feof(f))
+	// The prepared prelude's name contains the hash of its contents.
+	if(precompiled)
+	{
+		rlc_build_cache_key_add_string(key, "-include");
+		rlc_build_cache_key_add_string(key, helper);
+	} else
 	{
-		size_t size = fread(buf, 1, sizeof(buf), f);
-		if(!size)
+		char * contents;
+		size_t size;
+		if(!rlc_backend_read_file(helper, &contents, &size))
 		{
-			perror("fread");
+			perror(helper);
 			exit(1);
 		}
+		rlc_build_cache_key_add(key, contents, size);
+		rlc_free((void**)&contents);
+	}
+}
+
+/** Starts the compiler on a translation unit that is written to its standard input.
+@param[in] helper:
+	The path of the helper code that precedes the generated code.
+@param[in] precompiled:
+	Whether `helper` is the prepared prelude, which is passed via `-include`. Otherwise, it is written to the compiler right away.
+@param[in] directory:
+	The directory the compiler runs in.
+@param[in] output:
+	The file to compile to, relative to `directory`.
+@param[in] errors:
+	If not null, the file that the compiler's error output is written to.
+@param[in] object:
+	Whether to compile to an object file, instead of an executable.
+@param[in] group:
+	Whether the compiler leads a new process group, so that it can be stopped with all its processes.
+@param[out] input:
+	Receives the compiler's standard input, or -1.
+@return
+	The compiler's process ID, or -1. */
+static pid_t start_compiler(
+	char const * helper,
+	int precompiled,
+	char const * directory,
+	char const * output,
+	char const * errors,
+	int object,
+	int group,
+	int * input)
+{
+	fflush(stdout);
+
+	char const * args[kMaxFlags + 12];
+	size_t arg = 0;
+	args[arg++] = "c++";
+	for(size_t i = 0; i < s_compile_flag_count; i++)
+		args[arg++] = s_compile_flags[i];
+	if(precompiled)
+	{
+		args[arg++] = "-include";
+		args[arg++] = helper;
+	}
+	char const * const prefix = pgo_prefix_flag(directory);
+	if(prefix)
+		args[arg++] = prefix;
+	if(object)
+		args[arg++] = "-c";
+	args[arg++] = "-x";
+	args[arg++] = "c++";
+	args[arg++] = "-";
+	args[arg++] = "-o";
+	args[arg++] = output;
+	args[arg] = NULL;
+	pid_t const compiler = rlc_backend_spawn((char * const *)args, directory, errors, input, group);
 
-		char const * p = buf;
-		while(size)
+	if(!precompiled && *input != -1)
+	{
+		char * contents;
+		size_t size;
+		if(!rlc_backend_read_file(helper, &contents, &size))
 		{
-			size_t sent = write(pipe, p, size);
-			if(0 == sent)
-			{
-				perror("send");
-				exit(1);
-			}
-			p += sent;
-			size -= sent;
+			perror(helper);
+			exit(1);
 		}
+		rlc_backend_write(*input, &(struct iovec){ contents, size }, 1);
+		rlc_free((void**)&contents);
 	}
+	return compiler;
+}
+
+/** Prints the error output of a compiler, if any.
+@param[in] log:
+	The file the compiler's error output was written to. */
+static void print_log(
+	char const * log)
+{
+	char * contents;
+	size_t size;
+	if(!rlc_backend_read_file(log, &contents, &size))
+		return;
+	fflush(stdout);
+	fwrite(contents, 1, size, stderr);
+	rlc_free((void**)&contents);
 }
 
-void read_into_pipe_and_close(FILE* fd, char ** contents, size_t * size, int pipe)
+/** Splits the generated code into several translation units, and compiles them concurrently.
+	Every unit is streamed into its compiler, preceded by the shared declarations. The objects are built in a temporary directory, which is removed afterwards. If the build cache is enabled, the executable and unchanged units are taken from it.
+@param[in] code:
+	The generated code.
+@param[in] units:
+	The definitions that can be split.
+@param[in] unit_count:
+	The number of translation units.
+@param[in] helper:
+	The path of the helper code that precedes the generated code.
+@param[in] precompiled:
+	Whether `helper` is the prepared prelude, which is passed via `-include`, instead of being written to every unit.
+@param[in] main_file:
+	The path of the code that follows the generated code.
+@param[in] cached:
+	Whether to use the build cache.
+@return
+	Whether the executable was built. */
+static int compile_units(
+	struct GeneratedCode const * code,
+	struct RlcPrinterUnits const * units,
+	unsigned unit_count,
+	char const * helper,
+	int precompiled,
+	char const * main_file,
+	int cached)
 {
-	fclose(fd);
-	char const * p = *contents;
-	while(*size)
+	char * main_code;
+	size_t main_size;
+	if(!rlc_backend_read_file(main_file, &main_code, &main_size))
+	{
+		perror(main_file);
+		return 0;
+	}
+
+	char dir[] = "/tmp/.rlc_build_XXXXXX";
+	if(!mkdtemp(dir))
+	{
+		perror("mkdtemp");
+		rlc_free((void**)&main_code);
+		return 0;
+	}
+
+	struct RlcBuildCacheKey header_key, exe_key;
+	if(cached)
 	{
-		size_t sent = write(pipe, p, *size);
-		if(0 == sent)
+		build_key_create(&header_key, helper, precompiled);
+		rlc_build_cache_key_add_string(&header_key, "-c");
+		for(size_t i = 0; i < 5; i++)
+			rlc_build_cache_key_add(&header_key, code->fHeader[i], code->fHeaderSize[i]);
+		rlc_build_cache_key_create(&exe_key, "c++");
+		for(size_t i = 0; i < s_link_flag_count; i++)
+			rlc_build_cache_key_add_string(&exe_key, s_link_flags[i]);
+	}
+
+	char (*objects)[PATH_MAX] = NULL;
+	pid_t * processes = NULL;
+	int * inputs = NULL;
+	struct RlcBuildCacheKey * keys = NULL;
+	char ** sources = NULL;
+	size_t * source_sizes = NULL;
+	rlc_malloc((void**)&objects, unit_count * sizeof(*objects));
+	rlc_malloc((void**)&processes, unit_count * sizeof(pid_t));
+	rlc_malloc((void**)&inputs, unit_count * sizeof(int));
+	rlc_malloc((void**)&keys, unit_count * sizeof(struct RlcBuildCacheKey));
+	rlc_malloc((void**)&sources, unit_count * sizeof(char *));
+	rlc_malloc((void**)&source_sizes, unit_count * sizeof(size_t));
+
+	// All units are generated first, as the executable is cached by the contents of all units.
+	for(unsigned unit = 0; unit < unit_count; unit++)
+	{
+		snprintf(objects[unit], PATH_MAX, "%s/unit%u.o", dir, unit);
+		FILE * out = open_memstream(&sources[unit], &source_sizes[unit]);
+		if(!out)
 		{
-			perror("send");
+			perror("open_memstream");
 			exit(1);
 		}
-		p += sent;
-		*size -= sent;
+		for(int funcs = 0; funcs < 2; funcs++)
+			rlc_printer_units_write(
+				units,
+				funcs,
+				code->fImpl[funcs],
+				code->fImplSize[funcs],
+				unit,
+				unit_count,
+				out);
+		if(!unit)
+			write_or_exit(out, main_code, main_size);
+		fclose(out);
+
+		if(cached)
+		{
+			keys[unit] = header_key;
+			rlc_build_cache_key_add(&keys[unit], sources[unit], source_sizes[unit]);
+			uint8_t digest[kRlcBuildCacheDigestSize];
+			rlc_build_cache_key_digest(&keys[unit], digest);
+			rlc_build_cache_key_add(&exe_key, digest, sizeof(digest));
+		}
 	}
-	free(*contents);
+
+	int success = 1;
+	if(cached && rlc_build_cache_fetch(&exe_key, "a.out"))
+		goto cleanup;
+
+	// All compilers are started before any unit is written, so that they can read the shared prelude concurrently.
+	for(unsigned unit = 0; unit < unit_count; unit++)
+	{
+		// A process ID of 0 marks units taken from the cache.
+		processes[unit] = 0;
+		inputs[unit] = -1;
+		if(cached && rlc_build_cache_fetch(&keys[unit], objects[unit]))
+			continue;
+
+		char object[32], log[PATH_MAX];
+		snprintf(object, sizeof(object), "unit%u.o", unit);
+		snprintf(log, sizeof(log), "%s/unit%u.log", dir, unit);
+		processes[unit] = start_compiler(helper, precompiled, dir, object, log, 1, 0, &inputs[unit]);
+	}
+
+	for(unsigned unit = 0; unit < unit_count; unit++)
+		if(inputs[unit] != -1)
+		{
+			struct iovec parts[6];
+			for(size_t i = 0; i < 5; i++)
+				parts[i] = (struct iovec){ code->fHeader[i], code->fHeaderSize[i] };
+			parts[5] = (struct iovec){ sources[unit], source_sizes[unit] };
+			rlc_backend_write(inputs[unit], parts, 6);
+			close(inputs[unit]);
+		}
+
+	unsigned failed = unit_count;
+	for(unsigned unit = 0; unit < unit_count; unit++)
+		if(processes[unit])
+		{
+			if(!rlc_backend_wait(processes[unit]))
+			{
+				success = 0;
+				if(failed == unit_count)
+					failed = unit;
+			} else if(cached)
+				rlc_build_cache_store(&keys[unit], objects[unit]);
+		}
+
+	// Every unit compiles the shared declarations, so errors in them are only shown for the first failing unit.
+	for(unsigned unit = 0; unit < unit_count; unit++)
+		if(processes[unit] && (failed == unit_count || failed == unit))
+		{
+			char log[PATH_MAX];
+			snprintf(log, sizeof(log), "%s/unit%u.log", dir, unit);
+			print_log(log);
+		}
+
+	if(success)
+	{
+		char ** args = NULL;
+		rlc_malloc((void**)&args, (s_link_flag_count + unit_count + 4) * sizeof(char *));
+		size_t arg = 0;
+		args[arg++] = "c++";
+		for(size_t i = 0; i < s_link_flag_count; i++)
+			args[arg++] = (char *)s_link_flags[i];
+		for(unsigned unit = 0; unit < unit_count; unit++)
+			args[arg++] = objects[unit];
+		args[arg++] = "-o";
+		args[arg++] = "a.out";
+		args[arg] = NULL;
+		success = rlc_backend_wait(rlc_backend_spawn(args, NULL, NULL, NULL, 0));
+		rlc_free((void**)&args);
+
+		if(success && cached)
+			rlc_build_cache_store(&exe_key, "a.out");
+	}
+
+cleanup:
+	for(unsigned unit = 0; unit < unit_count; unit++)
+	{
+		char log[PATH_MAX];
+		snprintf(log, sizeof(log), "%s/unit%u.log", dir, unit);
+		unlink(log);
+		unlink(objects[unit]);
+		free(sources[unit]);
+	}
+	rmdir(dir);
+
+	rlc_free((void**)&source_sizes);
+	rlc_free((void**)&sources);
+	rlc_free((void**)&keys);
+	rlc_free((void**)&inputs);
+	rlc_free((void**)&processes);
+	rlc_free((void**)&objects);
+	rlc_free((void**)&main_code);
+	return success;
 }
 
 int main(
@@ -78,9 +646,20 @@ int main(
 	{
 		fprintf(argc == 2 ? stdout : stderr,
 			"usage:\n"
-			"\t%s f1 f2 ... fN\n"
+			"\t%s [-j N] [--error-limit N] [--parse-cache DIR] [--parse-cache-stats] [--build-cache DIR] [--build-cache-size MiB] [--cache-stats] [--debug | --release | --release-lto] [--pgo-generate | --pgo-use=PROFILE] f1 f2 ... fN\n"
 			"\t\tcompiles f1...fN into executable 'a.out'.\n"
-			"\t%s --test f1 f2 ... fN\n"
+			"\t\t-j N parses the files and their includes on N threads, and compiles the generated code as N translation units.\n"
+			"\t\t--error-limit N stops after N errors (default 20, 0 for no limit).\n"
+			"\t\t--parse-cache DIR stores parsed files in DIR, and loads unchanged files from it.\n"
+			"\t\t--parse-cache-stats prints which files were loaded from the parse cache.\n"
+			"\t\t--build-cache DIR stores compiled code in DIR, and reuses it when the generated code is unchanged.\n"
+			"\t\t--build-cache-size MiB evicts the least recently used compiled code beyond this size (default 1024).\n"
+			"\t\t--cache-stats prints the build cache's hits, misses, and size.\n"
+			"\t\t--debug compiles without optimisations and with debug information (default).\n"
+			"\t\t--release compiles with optimisations, --release-lto also optimises across translation units.\n"
+			"\t\t--pgo-generate builds an instrumented, optimised executable, which records its profile in 'a.out.profile', replacing any previous profile.\n"
+			"\t\t--pgo-use=PROFILE optimises with a recorded profile, and compiles as many translation units as it was recorded with.\n"
+			"\t%s --test [options] f1 f2 ... fN\n"
 			"\t\tcompiles tests in f1...fN into executable 'a.out'.\n"
 			"\t%s --help\n"
 				"\t\tprints this message.\n"
@@ -142,6 +721,119 @@ int main(
 	}
 
 	int isTest = !strcmp(argv[1], "--test");
+	int first = 1 + isTest;
+
+	size_t jobs = 1;
+	int cacheStats = 0;
+	int buildCacheStats = 0;
+	char const * buildCache = NULL;
+	uint64_t buildCacheSize = kRlcBuildCacheDefaultSize;
+	enum BuildProfile profile = kBuildProfileDebug;
+	int pgoGenerate = 0;
+	char const * pgoUse = NULL;
+	for(; first < argc; ++first)
+	{
+		char const * count;
+		int const isJobs = !strncmp(argv[first], "-j", 2);
+		int const isCacheSize = !strcmp(argv[first], "--build-cache-size");
+		if(isJobs)
+			count = argv[first][2] ? &argv[first][2] : argv[++first];
+		else if(isCacheSize || !strcmp(argv[first], "--error-limit"))
+			count = argv[++first];
+		else if(!strcmp(argv[first], "--parse-cache") && first + 1 < argc)
+		{
+			rlc_parse_cache_enable(argv[++first]);
+			continue;
+		} else if(!strcmp(argv[first], "--parse-cache-stats"))
+		{
+			cacheStats = 1;
+			continue;
+		} else if(!strcmp(argv[first], "--build-cache") && first + 1 < argc)
+		{
+			buildCache = argv[++first];
+			continue;
+		} else if(!strcmp(argv[first], "--cache-stats"))
+		{
+			buildCacheStats = 1;
+			continue;
+		} else if(!strcmp(argv[first], "--debug"))
+		{
+			profile = kBuildProfileDebug;
+			continue;
+		} else if(!strcmp(argv[first], "--release"))
+		{
+			profile = kBuildProfileRelease;
+			continue;
+		} else if(!strcmp(argv[first], "--release-lto"))
+		{
+			profile = kBuildProfileReleaseLto;
+			continue;
+		} else if(!strcmp(argv[first], "--pgo-generate"))
+		{
+			pgoGenerate = 1;
+			continue;
+		} else if(!strncmp(argv[first], "--pgo-use=", 10) && argv[first][10])
+		{
+			pgoUse = &argv[first][10];
+			continue;
+		} else
+			break;
+
+		char * end;
+		size_t value;
+		if(!count || !*count || (value = strtoul(count, &end, 10), *end) || ((isJobs || isCacheSize) && !value))
+		{
+			fprintf(stderr, "usage: %s [--test] [-j N] [--error-limit N] [--parse-cache DIR] [--parse-cache-stats] [--build-cache DIR] [--build-cache-size MiB] [--cache-stats] [--debug | --release | --release-lto] [--pgo-generate | --pgo-use=PROFILE] f1 f2 ... fN\n", argv[0]);
+			return 1;
+		}
+
+		if(isJobs)
+			jobs = value;
+		else if(isCacheSize)
+			buildCacheSize = (uint64_t)value << 20;
+		else
+			rlc_diagnostics_set_limit(value);
+	}
+
+	if(pgoGenerate && pgoUse)
+	{
+		fputs("error: --pgo-generate and --pgo-use are mutually exclusive.\n", stderr);
+		return 1;
+	}
+
+	// Profiles are only useful for optimised builds. The instrumented program writes its profile next to the executable.
+	char cwd[PATH_MAX], pgoDirectory[kPgoDirectorySize];
+	if(!getcwd(cwd, sizeof(cwd)))
+	{
+		perror("getcwd");
+		return 1;
+	}
+	if(pgoGenerate || pgoUse)
+	{
+		if(profile == kBuildProfileDebug)
+			profile = kBuildProfileRelease;
+		if(pgoGenerate)
+			snprintf(pgoDirectory, sizeof(pgoDirectory), "%s/a.out.profile", cwd);
+		else if(!realpath(pgoUse, pgoDirectory))
+		{
+			perror(pgoUse);
+			return 1;
+		}
+	}
+	set_build_flags(
+		profile,
+		pgoGenerate ? pgoDirectory : NULL,
+		pgoUse ? pgoDirectory : NULL);
+
+	// Profile data is named after the translation units, so a recorded profile dictates their number, independently of -j N.
+	unsigned unitCount = jobs;
+	if(pgoGenerate && !pgo_record(pgoDirectory, unitCount))
+		return 1;
+	if(pgoUse && !pgo_load(pgoDirectory, &unitCount))
+		return 1;
+
+	if(buildCache)
+		rlc_build_cache_enable(buildCache, buildCacheSize);
 
 	struct RlcScopedFileRegistry scoped_registry;
 	rlc_scoped_file_registry_create(&scoped_registry);
@@ -167,18 +859,83 @@ int main(
 		open_memstream(&varsImplBuf, &varsImplLen),
 		open_memstream(&funcsImplBuf, &funcsImplLen),
 		NULL,
+		NULL,
 		NULL
 	};
 
+	// Split builds need to know which definitions may go into separate translation units.
+	struct RlcPrinterUnits units = { { NULL, NULL }, { 0, 0 }, 0 };
+	if(unitCount > 1)
+		printer.fUnits = &units;
+
+	char out_file[PATH_MAX];
+	char *rlc_actual;
+	ssize_t rlc_which_len;
+	if((rlc_which_len = readlink("/proc/self/exe", out_file, sizeof(out_file))) == -1)
+	{
+		perror("readlink");
+		return 1;
+	}
+	out_file[rlc_which_len] = '\0';
+	if(!(rlc_actual = realpath(out_file, NULL)))
+	{
+		perror("realpath");
+		return 1;
+	}
+
+	char helper[PATH_MAX], prelude[PATH_MAX];
+	snprintf(helper, sizeof(helper), "%.*s/out/helper.cpp", parent_dir(rlc_actual), rlc_actual);
+	snprintf(out_file, sizeof(out_file), "%.*s/out/%s", parent_dir(rlc_actual), rlc_actual, isTest ? "testmain.cpp" : "exemain.cpp");
+	free(rlc_actual);
+	int const precompiled = rlc_backend_prelude(helper, s_compile_flags, prelude, sizeof(prelude));
+
+	// Without the build cache, a single translation unit is streamed into the compiler. It starts before any code is generated, so that it parses the prelude while the files are parsed and printed.
+	int const cached = rlc_build_cache_enabled();
+	int const streamed = unitCount == 1 && !cached;
+	int input = -1;
+	pid_t compiler = -1;
+	// Compilers that exit early are reported by their exit status, instead of killing the compiler while it writes to them.
+	signal(SIGPIPE, SIG_IGN);
+	// The streamed compiler's errors are printed once it finished, so that a compiler stopped because of diagnostics prints nothing.
+	if(streamed)
+	{
+		int const fd = mkstemp(s_compiler_log);
+		if(fd == -1)
+		{
+			perror("mkstemp");
+			return 1;
+		}
+		close(fd);
+		signal(SIGINT, &forward_signal);
+		signal(SIGTERM, &forward_signal);
+		signal(SIGHUP, &forward_signal);
+		compiler = start_compiler(precompiled ? prelude : helper, precompiled, cwd, "a.out", s_compiler_log, 0, 1, &input);
+		s_compiler_group = compiler;
+	}
+
+	char const ** files = NULL;
+	size_t const file_count = argc - first;
+	if(file_count)
+		rlc_malloc((void**)&files, file_count * sizeof(char const *));
+	for(size_t i = 0; i < file_count; i++)
+		files[i] = to_absolute_path(argv[first + i]);
+
+	if(jobs > 1)
+		rlc_scoped_file_registry_parse(&scoped_registry, files, file_count, jobs);
+
 	int status = 1;
-	for(int i = 1 + isTest; i < argc; i++)
+	for(int i = first; i < argc; i++)
 	{
-		char const * abs = to_absolute_path(argv[i]);
+		char const * abs = files[i - first];
 		struct RlcScopedFile * file;
-		if((file = rlc_scoped_file_registry_get(
+		if(abs && (file = rlc_scoped_file_registry_get(
 			&scoped_registry,
 			abs)))
 		{
+			// Keep parsing to collect all syntax errors, but do not generate code.
+			if(rlc_diagnostics_count())
+				continue;
+
 			fprintf(
 				stdout, "parsed %s\n",
 				argv[i]);
@@ -193,64 +950,124 @@ int main(
 
 		++printer.fCompilationUnit;
 	}
+	if(files)
+		rlc_free((void**)&files);
+
+	if(cacheStats)
+		rlc_parse_cache_print_stats(stderr);
+
+	if(rlc_diagnostics_flush())
+	{
+		// The generated code is incomplete, so it is not compiled.
+		if(input != -1)
+			close(input);
+		rlc_backend_stop(compiler);
+		s_compiler_group = 0;
+		if(streamed)
+			unlink(s_compiler_log);
+		fflush(stdout);
+		return 1;
+	}
 
 	rlc_parsed_symbol_constant_print(printer.fSymbolConstants);
 	rlc_parsed_symbol_constant_free();
 
 	rlc_scoped_file_registry_destroy(&scoped_registry);
+	rlc_identifier_free();
+	rlc_parse_cache_free();
 
-	int pipefd;
-	static char pipename[] = "/tmp/.rlc_pipe_XXXXXX.cpp\0";
-	if(-1 == (pipefd = mkstemps(pipename, 4)))
-	{
-		perror("mkstemp");
-		return 1;
-	}
-	char out_file[PATH_MAX];
-	char *rlc_actual;
-	ssize_t rlc_which_len;
-	if((rlc_which_len = readlink("/proc/self/exe", out_file, sizeof(out_file))) == -1)
+	fclose(printer.fSymbolConstants);
+	fclose(printer.fTypes);
+	fclose(printer.fFuncs);
+	fclose(printer.fTypesImpl);
+	fclose(printer.fVars);
+	fclose(printer.fVarsImpl);
+	fclose(printer.fFuncsImpl);
+	struct GeneratedCode const code = {
+		{ symbolConstantsBuf, typesBuf, funcsBuf, typesImplBuf, varsBuf },
+		{ symbolConstantsLen, typesLen, funcsLen, typesImplLen, varsLen },
+		{ varsImplBuf, funcsImplBuf },
+		{ varsImplLen, funcsImplLen }
+	};
+
+	if(unitCount > 1)
 	{
-		perror("readlink");
-		return 1;
-	}
-	out_file[rlc_which_len] = '\0';
-	if(!(rlc_actual = realpath(out_file, NULL)))
+		fflush(stdout);
+		status = compile_units(&code, &units, unitCount, precompiled ? prelude : helper, precompiled, out_file, cached);
+	} else
 	{
-		perror("realpath");
-		return 1;
-	}
+		char * main_code = NULL;
+		size_t main_size = 0;
+		if(!rlc_backend_read_file(out_file, &main_code, &main_size))
+		{
+			perror(out_file);
+			if(input != -1)
+				close(input);
+			rlc_backend_stop(compiler);
+			s_compiler_group = 0;
+			if(streamed)
+				unlink(s_compiler_log);
+			return 1;
+		}
 
-	snprintf(out_file, sizeof(out_file), "%.*s/out/helper.cpp", parent_dir(rlc_actual), rlc_actual);
-	pipe_file(out_file, pipefd);
-	read_into_pipe_and_close(printer.fSymbolConstants, &symbolConstantsBuf, &symbolConstantsLen, pipefd);
-	read_into_pipe_and_close(printer.fTypes, &typesBuf, &typesLen, pipefd);
-	read_into_pipe_and_close(printer.fFuncs, &funcsBuf, &funcsLen, pipefd);
-	read_into_pipe_and_close(printer.fTypesImpl, &typesImplBuf, &typesImplLen, pipefd);
-	read_into_pipe_and_close(printer.fVars, &varsBuf, &varsLen, pipefd);
-	read_into_pipe_and_close(printer.fVarsImpl, &varsImplBuf, &varsImplLen, pipefd);
-	read_into_pipe_and_close(printer.fFuncsImpl, &funcsImplBuf, &funcsImplLen, pipefd);
-	snprintf(out_file, sizeof(out_file), "%.*s/out/%s", parent_dir(rlc_actual), rlc_actual, isTest ? "testmain.cpp" : "exemain.cpp");
-	pipe_file(out_file, pipefd);
-	free(rlc_actual);
-	shutdown(pipefd, SHUT_WR);
+		struct iovec parts[] = {
+			{ symbolConstantsBuf, symbolConstantsLen },
+			{ typesBuf, typesLen },
+			{ funcsBuf, funcsLen },
+			{ typesImplBuf, typesImplLen },
+			{ varsBuf, varsLen },
+			{ varsImplBuf, varsImplLen },
+			{ funcsImplBuf, funcsImplLen },
+			{ main_code, main_size }
+		};
+		size_t const part_count = sizeof(parts) / sizeof(*parts);
 
-	fflush(stdout);
+		struct RlcBuildCacheKey key;
+		int hit = 0;
+		if(cached)
+		{
+			build_key_create(&key, precompiled ? prelude : helper, precompiled);
+			rlc_build_cache_key_add_string(&key, "-x c++ -");
+			for(size_t i = 0; i < part_count; i++)
+				rlc_build_cache_key_add(&key, parts[i].iov_base, parts[i].iov_len);
+			if(!(hit = rlc_build_cache_fetch(&key, "a.out")))
+				compiler = start_compiler(precompiled ? prelude : helper, precompiled, cwd, "a.out", NULL, 0, 0, &input);
+		}
 
-	char command[PATH_MAX+128];
-	snprintf(command, sizeof(command), "c++ -std=c++2a -fcoroutines -pthread -x c++ -Wfatal-errors -Werror %s -o a.out -g",
-		pipename);
-	if((status = !system(command)))
+		if(hit)
+			status = 1;
+		else
+		{
+			if(input != -1)
+			{
+				rlc_backend_write(input, parts, part_count);
+				close(input);
+			}
+			if((status = rlc_backend_wait(compiler)) && cached)
+				rlc_build_cache_store(&key, "a.out");
+			s_compiler_group = 0;
+			if(streamed)
+			{
+				print_log(s_compiler_log);
+				unlink(s_compiler_log);
+			}
+		}
+		rlc_free((void**)&main_code);
+	}
+
+	if(status)
 		puts("compiled!");
-	close(pipefd);
 
-	size_t allocs;
-	if((allocs = rlc_allocations()))
-	{
-		fprintf(stderr, "Warning: leaked allocations: %zu.\n", allocs);
-	}
+	rlc_build_cache_trim();
+	if(buildCacheStats)
+		rlc_build_cache_print_stats(stderr);
+	rlc_build_cache_free();
 
-	fflush(stdout);
-	fflush(stderr);
-	return status ? 0 : 1;
+	for(size_t i = 0; i < 5; i++)
+		free(code.fHeader[i]);
+	free(varsImplBuf);
+	free(funcsImplBuf);
+	rlc_printer_units_destroy(&units);
+
+	return finish(status);
 }
\ No newline at end of file
@@ -1,9 +1,11 @@
 #include "malloc.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdatomic.h>
 #include "assert.h"
 
-static size_t s_rlc_allocations = 0;
+/** Shared by all threads, as files are parsed in parallel. */
+static atomic_size_t s_rlc_allocations = 0;
 
 void rlc_malloc(
 	void ** ptr,
@@ -20,7 +22,7 @@ void rlc_malloc(
 		exit(EXIT_FAILURE);
 	}
 
-	s_rlc_allocations++;
+	atomic_fetch_add_explicit(&s_rlc_allocations, 1, memory_order_relaxed);
 }
 
 void rlc_realloc(
@@ -49,15 +51,16 @@ void rlc_free(
 	RLC_DASSERT(ptr);
 	RLC_DASSERT(*ptr);
 
-	RLC_DASSERT(s_rlc_allocations && "Memory was redundantly freed.");
+	RLC_DASSERT(atomic_load_explicit(&s_rlc_allocations, memory_order_relaxed)
+		&& "Memory was redundantly freed.");
 
 	free(*ptr);
 	*ptr = NULL;
 
-	s_rlc_allocations--;
+	atomic_fetch_sub_explicit(&s_rlc_allocations, 1, memory_order_relaxed);
 }
 
 size_t rlc_allocations()
 {
-	return s_rlc_allocations;
+	return atomic_load_explicit(&s_rlc_allocations, memory_order_relaxed);
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 /** @file malloc.h
 	Contains memory management functions to enable safer memory management.
 	rlc_malloc and rlc_free count the number of allocated objects, so that memory
-	leaks are easier to be found out. */
+	leaks are easier to be found out. The count is shared by all threads. */
 
 #ifndef __rlc_malloc_h_defined
 #define __rlc_malloc_h_defined
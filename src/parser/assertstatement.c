@@ -1,6 +1,6 @@
 #include "assertstatement.h"
 #include "expression.h"
-#include "../malloc.h"
+#include "../src/identifier.h"
 #include "../assert.h"
 
 void rlc_parsed_assert_statement_create(
@@ -13,19 +13,6 @@ void rlc_parsed_assert_statement_create(
 	this->fAssertion = NULL;
 }
 
-void rlc_parsed_assert_statement_destroy(
-	struct RlcParsedAssertStatement * this)
-{
-	if(this->fAssertion)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fAssertion);
-		rlc_free((void**)&this->fAssertion);
-	}
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 _Nodiscard int rlc_parsed_assert_statement_parse(
 	struct RlcParsedAssertStatement * out,
 	struct RlcParser * parser)
@@ -75,10 +62,12 @@ void rlc_parsed_assert_statement_print(
 	rlc_parsed_expression_print(this->fAssertion, file, out);
 	fputs(", (", out);
 	struct RlcSrcString span = {
-		this->fAssertion->fStart.content.start,
-		rlc_src_string_end(&this->fAssertion->fEnd.content)
-			- this->fAssertion->fStart.content.start
+		this->fAssertion->fStart,
+		this->fAssertion->fEnd - this->fAssertion->fStart,
+		kRlcIdentifierNone
 	};
+	// An assertion that is a single name is printed like that name.
+	span.identifier = rlc_identifier_find(&file->fContents[span.start], span.length);
 	rlc_src_string_print(&span, file, out);
 	struct RlcSrcPosition pos;
 	rlc_src_file_position(file, &pos, span.start);
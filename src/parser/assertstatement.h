@@ -19,9 +19,6 @@ struct RlcParsedAssertStatement
 void rlc_parsed_assert_statement_create(
 	struct RlcParsedAssertStatement * this);
 
-void rlc_parsed_assert_statement_destroy(
-	struct RlcParsedAssertStatement * this);
-
 _Nodiscard int rlc_parsed_assert_statement_parse(
 	struct RlcParsedAssertStatement * out,
 	struct RlcParser * parser);
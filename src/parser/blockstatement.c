@@ -1,7 +1,6 @@
 #include "blockstatement.h"
 
 #include "../assert.h"
-#include "../malloc.h"
 
 void rlc_parsed_block_statement_create(
 	struct RlcParsedBlockStatement * this)
@@ -15,17 +14,6 @@ void rlc_parsed_block_statement_create(
 	rlc_parsed_statement_list_create(&this->fList);
 }
 
-void rlc_parsed_block_statement_destroy(
-	struct RlcParsedBlockStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-
-	rlc_parsed_statement_list_destroy(&this->fList);
-}
-
 int rlc_parsed_block_statement_parse(
 	struct RlcParsedBlockStatement * out,
 	struct RlcParser * parser)
@@ -56,21 +44,30 @@ int rlc_parsed_block_statement_parse(
 		return 1;
 	}
 
+	struct RlcParserRecovery recovery;
+	rlc_parser_recovery_push(parser, &recovery);
+
 	struct RlcParsedStatement * stmt;
 	while(!rlc_parser_consume(
 		parser,
 		NULL,
 		kRlcTokBraceClose))
 	{
+		rlc_parser_recovery_mark(parser, &recovery);
+		if(setjmp(recovery.fJump))
+			continue;
+
 		if(!(stmt = rlc_parsed_statement_parse(
 			parser,
 			RLC_ALL_FLAGS(RlcParsedStatementType))))
 			rlc_parser_fail(parser, "expected statement");
 		rlc_parsed_statement_list_add(
 			&out->fList,
-			stmt);
+			stmt,
+			parser->fArena);
 	}
 
+	rlc_parser_recovery_pop(parser, &recovery);
 	return 1;
 }
 
@@ -26,14 +26,6 @@ struct RlcParsedBlockStatement
 void rlc_parsed_block_statement_create(
 	struct RlcParsedBlockStatement * this);
 
-/** Destroys a block statement.
-@memberof RlcParsedBlockStatement
-@param[in,out] this:
-	The block statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_block_statement_destroy(
-	struct RlcParsedBlockStatement * this);
-
 /** Parses a block statement.
 @memberof RlcParsedBlockStatement
 @param[out] out:
@@ -12,15 +12,6 @@ void rlc_parsed_break_statement_create(
 		kRlcParsedBreakStatement);
 }
 
-void rlc_parsed_break_statement_destroy(
-	struct RlcParsedBreakStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 int rlc_parsed_break_statement_parse(
 	struct RlcParsedBreakStatement * out,
 	struct RlcParser * parser)
@@ -31,14 +31,6 @@ struct RlcParsedBreakStatement
 void rlc_parsed_break_statement_create(
 	struct RlcParsedBreakStatement * this);
 
-/** Destroys a break statement.
-@memberof RlcParsedBreakStatement
-@param[in,out] this:
-	The break statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_break_statement_destroy(
-	struct RlcParsedBreakStatement * this);
-
 /** Parses a break statement.
 @memberof RlcParsedBreakStatement
 @param[out] out:
@@ -2,7 +2,6 @@
 #include "switchstatement.h"
 
 #include "../assert.h"
-#include "../malloc.h"
 
 void rlc_parsed_case_statement_create(
 	struct RlcParsedCaseStatement * this)
@@ -19,24 +18,6 @@ void rlc_parsed_case_statement_create(
 
 }
 
-void rlc_parsed_case_statement_destroy(
-	struct RlcParsedCaseStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_expression_list_destroy(&this->fValues);
-	this->fIsDefault = 1;
-
-	if(this->fBody)
-	{
-		rlc_parsed_statement_destroy_virtual(this->fBody);
-		rlc_free((void**)&this->fBody);
-	}
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 int rlc_parsed_case_statement_parse(
 	struct RlcParsedCaseStatement * out,
 	struct RlcParser * parser)
@@ -71,7 +52,8 @@ int rlc_parsed_case_statement_parse(
 				&out->fValues,
 				rlc_parsed_expression_parse(
 					parser,
-					RLC_ALL_FLAGS(RlcParsedExpressionType)));
+					RLC_ALL_FLAGS(RlcParsedExpressionType)),
+				parser->fArena);
 		} while(rlc_parser_consume(
 			parser,
 			NULL,
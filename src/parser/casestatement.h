@@ -43,14 +43,6 @@ struct RlcParsedCaseStatement
 void rlc_parsed_case_statement_create(
 	struct RlcParsedCaseStatement * this);
 
-/** Destroys a parsed case statement.
-@memberof RlcParsedCaseStatement
-@param[in,out] this:
-	The case statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_case_statement_destroy(
-	struct RlcParsedCaseStatement * this);
-
 /** Parses a case statement.
 @memberof RlcParsedCaseStatement
 @param[out] out:
@@ -1,6 +1,6 @@
 #include "castexpression.h"
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 void rlc_parsed_cast_expression_create(
 	struct RlcParsedCastExpression * this,
@@ -12,36 +12,14 @@ void rlc_parsed_cast_expression_create(
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedCastExpression,
-		first,
-		last);
+		first.content.start,
+		rlc_src_string_end(&last.content));
 
 	this->fValues = NULL;
 	this->fValueCount = 0;
 }
 
 
-void rlc_parsed_cast_expression_destroy(
-	struct RlcParsedCastExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fValues)
-	{
-		for(RlcSrcIndex i = 0; i < this->fValueCount; i++)
-		{
-			rlc_parsed_expression_destroy_virtual(this->fValues[i]);
-			rlc_free((void**)&this->fValues[i]);
-		}
-		rlc_free((void**)&this->fValues);
-		this->fValueCount = 0;
-	}
-
-	rlc_parsed_type_name_destroy(&this->fType);
-
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedExpression));
-}
-
 int rlc_parsed_cast_expression_parse(
 	struct RlcParsedCastExpression * out,
 	struct RlcParser * parser)
@@ -100,8 +78,7 @@ int rlc_parsed_cast_expression_parse(
 			if(!value)
 				rlc_parser_fail(parser, "expected expression");
 
-			rlc_realloc((void**)&values, ++valueCount * sizeof(struct RlcParsedExpression *));
-			values[valueCount-1] = value;
+			RLC_VECTOR_PUSH(parser->fArena, values, valueCount) = value;
 		} while(k_lookup[type].allowMultipleArgs
 				&& rlc_parser_consume(parser, NULL, kRlcTokComma));
 
@@ -48,14 +48,6 @@ void rlc_parsed_cast_expression_create(
 	struct RlcToken first,
 	struct RlcToken last);
 
-/** Destroys a cast expression.
-@memberof RlcParsedCastExpression
-@param[in,out] this:
-	The cast expression to destroy.
-	@dassert @nonnull */
-void rlc_parsed_cast_expression_destroy(
-	struct RlcParsedCastExpression * this);
-
 /** Parses a cast expression.
 @memberof RlcParsedCastExpression
 @param[out] out:
@@ -11,20 +11,11 @@ void rlc_parsed_character_expression_create(
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedCharacterExpression,
-		*token,
-		*token);
+		token->content.start,
+		rlc_src_string_end(&token->content));
 	this->fToken = *token;
 }
 
-void rlc_parsed_character_expression_destroy(
-	struct RlcParsedCharacterExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedExpression));
-}
-
 int rlc_parsed_character_expression_parse(
 	struct RlcParsedCharacterExpression * out,
 	struct RlcParser * parser)
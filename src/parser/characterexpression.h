@@ -34,14 +34,6 @@ void rlc_parsed_character_expression_create(
 	struct RlcParsedCharacterExpression * this,
 	struct RlcToken const * token);
 
-/** Destroys a parsed character expression.
-@memberof RlcParsedCharacterExpression
-@param[in,out] this:
-	The character expression to destroy.
-	@dassert @nonnull */
-void rlc_parsed_character_expression_destroy(
-	struct RlcParsedCharacterExpression * this);
-
 /** Parses a parsed character expression.
 @memberof RlcParsedCharacterExpression
 @param[out] out:
@@ -2,7 +2,7 @@
 #include "constructor.h"
 
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 void rlc_parsed_class_create(
 	struct RlcParsedClass * this,
@@ -30,33 +30,6 @@ void rlc_parsed_class_create(
 	this->fHasDestructor = 0;
 }
 
-void rlc_parsed_class_destroy(
-	struct RlcParsedClass * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_scope_entry_destroy_base(RLC_BASE_CAST(this, RlcParsedScopeEntry));
-
-	rlc_parsed_template_decl_destroy(&this->fTemplateDecl);
-
-	rlc_parsed_member_list_destroy(&this->fMembers);
-	rlc_parsed_member_list_destroy(&this->fConstructors);
-
-	if(this->fHasDestructor)
-	{
-		rlc_parsed_destructor_destroy(&this->fDestructor);
-		this->fHasDestructor = 0;
-	}
-
-	if(this->fInheritanceCount)
-	{
-		for(RlcSrcSize i = 0; i < this->fInheritanceCount; i++)
-			rlc_parsed_symbol_destroy(&this->fInheritances[i].fBase);
-		rlc_free((void**)&this->fInheritances);
-		this->fInheritanceCount = 0;
-	}
-}
-
 int rlc_parsed_class_parse(
 	struct RlcParsedClass * out,
 	struct RlcParser * parser,
@@ -94,11 +67,10 @@ int rlc_parsed_class_parse(
 	{
 		do
 		{
-			rlc_realloc(
-				(void**)&out->fInheritances,
-				++out->fInheritanceCount * sizeof(struct RlcParsedInheritance));
-			struct RlcParsedInheritance * in =
-				&out->fInheritances[out->fInheritanceCount-1];
+			struct RlcParsedInheritance * in = &RLC_VECTOR_PUSH(
+				parser->fArena,
+				out->fInheritances,
+				out->fInheritanceCount);
 
 			int _ = rlc_visibility_parse(&in->fVisibility, parser, kRlcVisibilityPublic);
 			(void) _;
@@ -120,13 +92,27 @@ int rlc_parsed_class_parse(
 	struct RlcParsedMemberCommon common;
 	rlc_parsed_member_common_create(&common, kRlcVisibilityPublic);
 
+	struct RlcParserRecovery recovery;
+	rlc_parser_recovery_push(parser, &recovery);
+
 	struct RlcParsedMember * member;
-	while((member = rlc_parsed_member_parse(
-		parser,
-		&common,
-		RLC_ALL_FLAGS(RlcParsedMemberType)
-		& (out->fHasDestructor ? ~RLC_FLAG(kRlcParsedDestructor) : ~0))))
+	for(;;)
 	{
+		rlc_parser_recovery_mark(parser, &recovery);
+		if(setjmp(recovery.fJump))
+			continue;
+
+		if(!(member = rlc_parsed_member_parse(
+			parser,
+			&common,
+			RLC_ALL_FLAGS(RlcParsedMemberType)
+			& (out->fHasDestructor ? ~RLC_FLAG(kRlcParsedDestructor) : ~0))))
+		{
+			if(rlc_parser_eof(parser) || rlc_parser_is_current(parser, kRlcTokBraceClose))
+				break;
+			rlc_parser_fail(parser, "expected member");
+		}
+
 		if(RLC_DERIVING_TYPE(member) == kRlcParsedDestructor)
 		{
 			out->fHasDestructor = 1;
@@ -134,20 +120,22 @@ int rlc_parsed_class_parse(
 				member,
 				RlcParsedMember,
 				struct RlcParsedDestructor);
-			rlc_free((void**)&member);
 		} else if(RLC_DERIVING_TYPE(member) == kRlcParsedConstructor)
 		{
 			rlc_parsed_member_list_add(
 				&out->fConstructors,
-				member);
+				member,
+				parser->fArena);
 		} else
 		{
 			// add the member to the members list.
 			rlc_parsed_member_list_add(
 				&out->fMembers,
-				member);
+				member,
+				parser->fArena);
 		}
 	}
+	rlc_parser_recovery_pop(parser, &recovery);
 
 	rlc_parser_expect(
 		parser,
@@ -270,6 +258,12 @@ static void rlc_parsed_class_print_impl(
 		fputs("();\n", out);
 
 		FILE * out = printer->fFuncsImpl;
+		rlc_printer_begin_definition(
+			printer,
+			out,
+			this->fDestructor.fIsInline
+				? kRlcPrinterDefinitionShared
+				: rlc_printer_definition(printer, NULL));
 		rlc_printer_print_ctx_tpl(printer, file, out);
 		rlc_printer_print_ctx_symbol(printer, file, out);
 		fputs("::~", out);
@@ -284,6 +278,7 @@ static void rlc_parsed_class_print_impl(
 			file,
 			out);
 		fputs("#undef _return\n", out);
+		rlc_printer_end_definition(printer, out);
 	}
 	else
 	{
@@ -437,6 +432,10 @@ static void rlc_parsed_class_print_impl(
 		fputs(";\n", out);
 
 		FILE * out = printer->fFuncsImpl;
+		rlc_printer_begin_definition(
+			printer,
+			out,
+			rlc_printer_definition(printer, &ctor->fTemplates));
 		rlc_printer_print_ctx_tpl(printer, file, out);
 		rlc_parsed_template_decl_print(&ctor->fTemplates, file, out);
 		rlc_printer_print_ctx_symbol(printer, file, out);
@@ -479,6 +478,7 @@ static void rlc_parsed_class_print_impl(
 			rlc_parsed_block_statement_print(&ctor->fBody, file, out);
 			fputs("\n#undef _return\n", out);
 		} else fputs("{;}\n", out);
+		rlc_printer_end_definition(printer, out);
 	}
 
 	fprintf(out, " };\n");
@@ -519,17 +519,6 @@ void rlc_parsed_member_class_create(
 		member);
 }
 
-void rlc_parsed_member_class_destroy(
-	struct RlcParsedMemberClass * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_class_destroy(
-		RLC_BASE_CAST(this, RlcParsedClass));
-	rlc_parsed_member_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedMember));
-}
-
 int rlc_parsed_member_class_parse(
 	struct RlcParsedMemberClass * out,
 	struct RlcParser * parser,
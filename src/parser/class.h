@@ -64,14 +64,6 @@ void rlc_parsed_class_create(
 	struct RlcSrcString const * name,
 	struct RlcParsedTemplateDecl const * templates);
 
-/** Destroys a parsed class.
-@memberof RlcParsedClass
-@param[in,out] this:
-	The parsed class to destroy.
-	@dassert @nonnull */
-void rlc_parsed_class_destroy(
-	struct RlcParsedClass * this);
-
 /** Tries to parse a class.
 @memberof RlcParsedClass
 @param[out] out:
@@ -115,14 +107,6 @@ void rlc_parsed_member_class_create(
 	struct RlcParsedMemberClass * this,
 	struct RlcParsedMemberCommon const * member);
 
-/** Destroys a member class.
-@memberof RlcParsedMemberClass
-@param[in,out] this:
-	The member class to destroy.
-	@dassert @nonnull */
-void rlc_parsed_member_class_destroy(
-	struct RlcParsedMemberClass * this);
-
 /** Parses a member class.
 @memberof RlcParsedMemberClass
 @param[out] this:
@@ -1,6 +1,6 @@
 #include "constructor.h"
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 void rlc_parsed_constructor_create(
 	struct RlcParsedConstructor * this,
@@ -24,36 +24,6 @@ void rlc_parsed_constructor_create(
 	this->fInitialiserCount = 0;
 }
 
-void rlc_parsed_constructor_destroy(
-	struct RlcParsedConstructor * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_member_destroy_base(RLC_BASE_CAST(this, RlcParsedMember));
-
-	rlc_parsed_template_decl_destroy(&this->fTemplates);
-
-	if(this->fArguments)
-	{
-		for(size_t i = this->fArgumentCount; i--;)
-			rlc_parsed_variable_destroy(&this->fArguments[i]);
-		rlc_free((void**)&this->fArguments);
-		this->fArgumentCount = 0;
-	}
-
-	if(this->fInitialisers)
-	{
-		for(size_t i = this->fInitialiserCount; i--;)
-			rlc_parsed_initialiser_destroy(&this->fInitialisers[i]);
-		rlc_free((void**)&this->fInitialisers);
-		this->fInitialiserCount = 0;
-	}
-
-	if(this->fIsDefinition)
-		rlc_parsed_block_statement_destroy(&this->fBody);
-	this->fIsInline = 0;
-}
-
 int rlc_parsed_constructor_parse(
 	struct RlcParsedConstructor * out,
 	struct RlcParser * parser,
@@ -104,7 +74,8 @@ int rlc_parsed_constructor_parse(
 
 			rlc_parsed_constructor_add_argument(
 				out,
-				&argument);
+				&argument,
+				parser->fArena);
 		} while(rlc_parser_consume(
 			parser,
 			NULL,
@@ -151,7 +122,8 @@ int rlc_parsed_constructor_parse(
 
 			rlc_parsed_constructor_add_initialiser(
 				out,
-				&initialiser);
+				&initialiser,
+				parser->fArena);
 		} while(rlc_parser_consume(
 			parser,
 			NULL,
@@ -172,7 +144,8 @@ int rlc_parsed_constructor_parse(
 
 			rlc_parsed_constructor_add_initialiser(
 				out,
-				&initialiser);
+				&initialiser,
+				parser->fArena);
 		} while(rlc_parser_consume(
 			parser,
 			NULL,
@@ -195,30 +168,26 @@ int rlc_parsed_constructor_parse(
 
 void rlc_parsed_constructor_add_argument(
 	struct RlcParsedConstructor * this,
-	struct RlcParsedVariable * argument)
+	struct RlcParsedVariable * argument,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(argument != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fArguments,
-		sizeof(struct RlcParsedVariable) * ++this->fArgumentCount);
-
-	this->fArguments[this->fArgumentCount-1] = *argument;
+	RLC_VECTOR_PUSH(arena, this->fArguments, this->fArgumentCount) = *argument;
 }
 
 void rlc_parsed_constructor_add_initialiser(
 	struct RlcParsedConstructor * this,
-	struct RlcParsedInitialiser * initialiser)
+	struct RlcParsedInitialiser * initialiser,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(initialiser != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fInitialisers,
-		sizeof(struct RlcParsedVariable) * ++this->fInitialiserCount);
-
-	this->fInitialisers[this->fInitialiserCount-1] = *initialiser;
+	RLC_VECTOR_PUSH(arena, this->fInitialisers, this->fInitialiserCount) = *initialiser;
 }
 
 void rlc_parsed_initialiser_create(
@@ -231,25 +200,6 @@ void rlc_parsed_initialiser_create(
 }
 
 
-void rlc_parsed_initialiser_destroy(
-	struct RlcParsedInitialiser * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_symbol_destroy(&this->fMember);
-
-	if(this->fArguments)
-	{
-		while(this->fArgumentCount--)
-		{
-			rlc_parsed_expression_destroy_virtual(this->fArguments[this->fArgumentCount]);
-			rlc_free((void**)&this->fArguments[this->fArgumentCount]);
-		}
-
-		rlc_free((void**)&this->fArguments);
-	}
-}
-
 void rlc_parsed_initialiser_parse(
 	struct RlcParsedInitialiser * out,
 	struct RlcParser * parser)
@@ -271,7 +221,8 @@ void rlc_parsed_initialiser_parse(
 			out,
 			rlc_parsed_expression_parse(
 				parser,
-				RLC_ALL_FLAGS(RlcParsedExpressionType)));
+				RLC_ALL_FLAGS(RlcParsedExpressionType)),
+			parser->fArena);
 		return;
 	}
 
@@ -291,7 +242,8 @@ void rlc_parsed_initialiser_parse(
 				out,
 				rlc_parsed_expression_parse(
 					parser,
-					RLC_ALL_FLAGS(RlcParsedExpressionType)));
+					RLC_ALL_FLAGS(RlcParsedExpressionType)),
+				parser->fArena);
 		} while(rlc_parser_consume(
 			parser,
 			NULL,
@@ -307,14 +259,12 @@ void rlc_parsed_initialiser_parse(
 
 void rlc_parsed_initialiser_add_argument(
 	struct RlcParsedInitialiser * this,
-	struct RlcParsedExpression * argument)
+	struct RlcParsedExpression * argument,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(argument != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fArguments,
-		sizeof(struct RlcParsedExpression*) * ++this->fArgumentCount);
-
-	this->fArguments[this->fArgumentCount-1] = argument;
+	RLC_VECTOR_PUSH(arena, this->fArguments, this->fArgumentCount) = argument;
 }
\ No newline at end of file
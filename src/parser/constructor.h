@@ -54,14 +54,6 @@ void rlc_parsed_constructor_create(
 	struct RlcParsedConstructor * this,
 	struct RlcParsedMemberCommon const * member);
 
-/** Destroys a constructor.
-@memberof RlcParsedConstructor
-@param[in,out] this:
-	The constructor to destroy.
-	@dassert @nonnull */
-void rlc_parsed_constructor_destroy(
-	struct RlcParsedConstructor * this);
-
 /** Parses a constructor.
 @memberof RlcParsedConstructor
 @param[out] out:
@@ -87,10 +79,14 @@ _Nodiscard int rlc_parsed_constructor_parse(
 @param[in] argument:
 	The argument to add.
 	@pass_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_constructor_add_argument(
 	struct RlcParsedConstructor * this,
-	struct RlcParsedVariable * argument);
+	struct RlcParsedVariable * argument,
+	struct RlcArena * arena);
 
 /** Adds an initialiser to a constructor.
 @memberof RlcParsedConstructor
@@ -100,10 +96,14 @@ void rlc_parsed_constructor_add_argument(
 @param[in] initialiser:
 	The initialiser to add.
 	@pass_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_constructor_add_initialiser(
 	struct RlcParsedConstructor * this,
-	struct RlcParsedInitialiser * initialiser);
+	struct RlcParsedInitialiser * initialiser,
+	struct RlcArena * arena);
 
 /** A member initaliser inside a constructor as used by the parser.
 @related RlcParsedConstructor */
@@ -125,14 +125,6 @@ struct RlcParsedInitialiser
 void rlc_parsed_initialiser_create(
 	struct RlcParsedInitialiser * this);
 
-/** Destroys an initialiser.
-@memberof RlcParsedInitialiser
-@param[in,out] this:
-	The initialiser to destroy.
-	@dassert @nonnull */
-void rlc_parsed_initialiser_destroy(
-	struct RlcParsedInitialiser * this);
-
 /** Parses an initialiser.
 @memberof RlcParsedInitialiser
 @param[out] out:
@@ -153,10 +145,14 @@ void rlc_parsed_initialiser_parse(
 @param[in] argument:
 	The argument to add.
 	@pass_pointer_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_initialiser_add_argument(
 	struct RlcParsedInitialiser * this,
-	struct RlcParsedExpression * argument);
+	struct RlcParsedExpression * argument,
+	struct RlcArena * arena);
 
 #ifdef __cplusplus
 }
@@ -12,15 +12,6 @@ void rlc_parsed_continue_statement_create(
 		kRlcParsedContinueStatement);
 }
 
-void rlc_parsed_continue_statement_destroy(
-	struct RlcParsedContinueStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 int rlc_parsed_continue_statement_parse(
 	struct RlcParsedContinueStatement * out,
 	struct RlcParser * parser)
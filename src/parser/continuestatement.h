@@ -31,14 +31,6 @@ struct RlcParsedContinueStatement
 void rlc_parsed_continue_statement_create(
 	struct RlcParsedContinueStatement * this);
 
-/** Destroys a continue statement.
-@memberof RlcParsedContinueStatement
-@param[in,out] this:
-	The continue statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_continue_statement_destroy(
-	struct RlcParsedContinueStatement * this);
-
 /** Parses a continue statement.
 @memberof RlcParsedContinueStatement
 @param[out] out:
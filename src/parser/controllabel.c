@@ -45,7 +45,7 @@ void rlc_parsed_control_label_print_name(
 		fputc('_', out);
 		struct RlcScopedText text;
 		rlc_scoped_text_create(&text, file, &this->fLabel);
-		for(int i = 0; i < text.fElements * text.fSymbolSize; i++)
+		for(size_t i = 0; i < text.fElements * text.fSymbolSize; i++)
 		{
 			char const * byte = ((char*)text.fRaw)+i;
 			fputc(hex[*byte & 0xf], out);
@@ -21,18 +21,6 @@ void rlc_parsed_destructor_create(
 }
 
 
-void rlc_parsed_destructor_destroy(
-	struct RlcParsedDestructor * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fIsDefinition)
-	{
-		rlc_parsed_block_statement_destroy(&this->fBody);
-		this->fIsDefinition = 0;
-	}
-}
-
 int rlc_parsed_destructor_parse(
 	struct RlcParsedDestructor * out,
 	struct RlcParser * parser,
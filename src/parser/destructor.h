@@ -36,14 +36,6 @@ void rlc_parsed_destructor_create(
 	struct RlcParsedDestructor * this,
 	struct RlcParsedMemberCommon const * member);
 
-/** Destroys a destructor.
-@memberof RlcParsedDestructor
-@param[in,out] this:
-	The destructor to destroy.
-	@dassert @nonnull */
-void rlc_parsed_destructor_destroy(
-	struct RlcParsedDestructor * this);
-
 /** Parses a destructor.
 @memberof RlcParsedDestructor
 @param[out] out:
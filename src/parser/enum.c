@@ -3,7 +3,7 @@
 
 #include "../tokeniser/tokens.h"
 
-#include "../malloc.h"
+#include "../vector.h"
 #include "../assert.h"
 
 void rlc_parsed_enum_constant_create(
@@ -23,30 +23,13 @@ void rlc_parsed_enum_constant_create(
 
 void rlc_parsed_enum_constant_add_name(
 	struct RlcParsedEnumConstant * this,
-	struct RlcSrcString const * nameToken)
+	struct RlcSrcString const * nameToken,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fAliasTokens,
-		sizeof(*this->fAliasTokens) * ++this->fAliasCount);
-
-	this->fAliasTokens[this->fAliasCount-1] = *nameToken;
-}
-
-void rlc_parsed_enum_constant_destroy(
-	struct RlcParsedEnumConstant * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-
-	if(this->fAliasTokens)
-	{
-		rlc_free((void**)&this->fAliasTokens);
-		this->fAliasCount = 0;
-	}
+	RLC_VECTOR_PUSH(arena, this->fAliasTokens, this->fAliasCount) = *nameToken;
 }
 
 int rlc_parsed_enum_constant_parse(
@@ -79,7 +62,8 @@ int rlc_parsed_enum_constant_parse(
 
 		rlc_parsed_enum_constant_add_name(
 			out,
-			&name.content);
+			&name.content,
+			parser->fArena);
 		rlc_parsed_symbol_constant_register(rlc_parser_file(parser), &name.content);
 	}
 
@@ -102,33 +86,16 @@ void rlc_parsed_enum_create(
 	this->fConstantCount = 0;
 }
 
-void rlc_parsed_enum_destroy(
-	struct RlcParsedEnum * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	for(size_t i = 0; i < this->fConstantCount; i++)
-		rlc_parsed_enum_constant_destroy(
-			&this->fConstants[i]);
-
-	if(this->fConstants)
-	{
-		rlc_free((void**)&this->fConstants);
-		this->fConstantCount = 0;
-	}
-}
-
 void rlc_parsed_enum_add_constant(
 	struct RlcParsedEnum * this,
-	struct RlcParsedEnumConstant const * constant)
+	struct RlcParsedEnumConstant const * constant,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(constant != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fConstants,
-		sizeof(struct RlcParsedEnumConstant) * ++this->fConstantCount);
-	this->fConstants[this->fConstantCount-1] = *constant;
+	RLC_VECTOR_PUSH(arena, this->fConstants, this->fConstantCount) = *constant;
 }
 
 int rlc_parsed_enum_parse(
@@ -174,7 +141,8 @@ int rlc_parsed_enum_parse(
 
 		rlc_parsed_enum_add_constant(
 			out,
-			&constant);
+			&constant,
+			parser->fArena);
 
 	} while(rlc_parser_consume(
 		parser,
@@ -413,17 +381,6 @@ void rlc_parsed_member_enum_create(
 		member);
 }
 
-void rlc_parsed_member_enum_destroy(
-	struct RlcParsedMemberEnum * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_enum_destroy(
-		RLC_BASE_CAST(this, RlcParsedEnum));
-	rlc_parsed_member_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedMember));
-}
-
 int rlc_parsed_member_enum_parse(
 	struct RlcParsedMemberEnum * out,
 	struct RlcParser * parser,
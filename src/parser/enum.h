@@ -38,16 +38,14 @@ void rlc_parsed_enum_constant_create(
 	The enum constant to add a name to.
 	@dassert @nonnull
 @param[in] name:
-	The alias. */
+	The alias.
+@param[in,out] arena:
+	The arena to allocate from.
+	@dassert @nonnull */
 void rlc_parsed_enum_constant_add_name(
 	struct RlcParsedEnumConstant * this,
-	struct RlcSrcString const * name);
-
-/** Destroys an enum constant.
-@param[in,out] this:
-	The constant to destroy. */
-void rlc_parsed_enum_constant_destroy(
-	struct RlcParsedEnumConstant * this);
+	struct RlcSrcString const * name,
+	struct RlcArena * arena);
 
 /** Parses an enum constant.
 @param[in,out] parser:
@@ -98,23 +96,20 @@ void rlc_parsed_enum_create(
 	struct RlcParsedEnum * this,
 	struct RlcSrcString const * name);
 
-/** Destroys an enum.
-@memberof RlcParsedEnum
-@param[in,out] this:
-	The enum to destroy. */
-void rlc_parsed_enum_destroy(
-	struct RlcParsedEnum * this);
-
 /** Adds a constant to an enum.
 @param[in,out] this:
 	The enum to add a constant to.
 @param[in] constant:
 	The constant to add.
 	@pass_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_enum_add_constant(
 	struct RlcParsedEnum * this,
-	struct RlcParsedEnumConstant const * constant);
+	struct RlcParsedEnumConstant const * constant,
+	struct RlcArena * arena);
 
 /** Parses an enum.
 @param[in,out] parser:
@@ -140,13 +135,6 @@ void rlc_parsed_member_enum_create(
 	struct RlcParsedMemberEnum * this,
 	struct RlcParsedMemberCommon const * member);
 
-/** Destroys a member enum.
-@param[in,out] this:
-	The member enum to destroy.
-	@dassert @nonnull */
-void rlc_parsed_member_enum_destroy(
-	struct RlcParsedMemberEnum * this);
-
 /** Parses a member enum.
 @param[out] out:
 	The member enum to parse.
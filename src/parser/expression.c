@@ -12,94 +12,84 @@
 #include "symbolconstantexpression.h"
 
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 
-#include <string.h>
+#include <stdint.h>
 
 void rlc_parsed_expression_create(
 	struct RlcParsedExpression * this,
 	enum RlcParsedExpressionType type,
-	struct RlcToken first,
-	struct RlcToken last)
+	RlcSrcIndex start,
+	RlcSrcIndex end)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(RLC_IN_ENUM(type, RlcParsedExpressionType));
 
 	RLC_DERIVING_TYPE(this) = type;
-	this->fStart = first;
-	this->fEnd = last;
+	this->fStart = start;
+	this->fEnd = end;
 }
 
-void rlc_parsed_expression_destroy_virtual(
-	struct RlcParsedExpression * this)
+_Nodiscard static int dummy_rlc_parsed_operator_expression_parse(
+	struct RlcParsedExpression ** out,
+	struct RlcParser * parser)
 {
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(RLC_IN_ENUM(RLC_DERIVING_TYPE(this), RlcParsedExpressionType));
-
-	typedef void (*destructor_t) (void *);
-
-	static destructor_t const k_vtable[] = {
-		(destructor_t)&rlc_parsed_symbol_expression_destroy,
-		(destructor_t)&rlc_parsed_symbol_child_expression_destroy,
-		(destructor_t)&rlc_parsed_number_expression_destroy,
-		(destructor_t)&rlc_parsed_character_expression_destroy,
-		(destructor_t)&rlc_parsed_string_expression_destroy,
-		(destructor_t)&rlc_parsed_operator_expression_destroy,
-		(destructor_t)&rlc_parsed_this_expression_destroy,
-		(destructor_t)&rlc_parsed_null_expression_destroy,
-		(destructor_t)&rlc_parsed_cast_expression_destroy,
-		(destructor_t)&rlc_parsed_sizeof_expression_destroy,
-		(destructor_t)&rlc_parsed_symbol_constant_expression_destroy
-	};
-
-	static_assert(RLC_COVERS_ENUM(k_vtable, RlcParsedExpressionType), "ill sized vtable.");
-
-	static intptr_t const k_offsets[] = {
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedSymbolExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedSymbolChildExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedNumberExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedCharacterExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedStringExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedOperatorExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedThisExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedNullExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedCastExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedSizeofExpression),
-		RLC_DERIVE_OFFSET(RlcParsedExpression, struct RlcParsedSymbolConstantExpression),
-	};
-
-	static_assert(RLC_COVERS_ENUM(k_offsets, RlcParsedExpressionType), "ill sized offset table.");
+	*out = rlc_parsed_operator_expression_parse(parser);
 
-	k_vtable[RLC_DERIVING_TYPE(this)]((uint8_t*)this + k_offsets[RLC_DERIVING_TYPE(this)]);
-}
-
-void rlc_parsed_expression_destroy_base(
-	struct RlcParsedExpression * this)
-{
-	RLC_DASSERT(this != NULL);
+	return *out != NULL;
 }
 
-union RlcExpressionStorage
-{
-	struct RlcParsedExpression * fPointer;
-	struct RlcParsedNumberExpression fRlcParsedNumberExpression;
-	struct RlcParsedSymbolExpression fRlcParsedSymbolExpression;
-	struct RlcParsedSymbolChildExpression fRlcParsedSymbolChildExpression;
-	struct RlcParsedOperatorExpression fRlcParsedOperatorExpression;
-	struct RlcParsedThisExpression fRlcParsedThisExpression;
-	struct RlcParsedThisExpression fRlcParsedNullExpression;
-	struct RlcParsedCastExpression fRlcParsedCastExpression;
-	struct RlcParsedSizeofExpression fRlcParsedSizeofExpression;
-	struct RlcParsedSymbolConstantExpression fRlcParsedSymbolConstantExpression;
+#define OPERATOR RLC_FLAG(kRlcParsedOperatorExpression)
+#define SYMBOL RLC_FLAG(kRlcParsedSymbolExpression) \
+	| RLC_FLAG(kRlcParsedSymbolChildExpression)
+
+/** The FIRST sets of the expressions, indexed by token type.
+	Operator expressions start with their prefix operators, or any other expression, including parenthesised ones. */
+static int const k_first[RLC_COUNT(RlcTokenType)] = {
+	[kRlcTokIdentifier] = OPERATOR | SYMBOL,
+	[kRlcTokDestructor] = OPERATOR | SYMBOL,
+	[kRlcTokBracketOpen] = OPERATOR | SYMBOL,
+	[kRlcTokDoubleColon] = OPERATOR | RLC_FLAG(kRlcParsedSymbolExpression),
+	[kRlcTokNumberLiteral] = OPERATOR | RLC_FLAG(kRlcParsedNumberExpression),
+	[kRlcTokFloatLiteral] = OPERATOR | RLC_FLAG(kRlcParsedNumberExpression),
+	[kRlcTokCharacterLiteral] = OPERATOR | RLC_FLAG(kRlcParsedCharacterExpression),
+	[kRlcTokStringLiteral] = OPERATOR | RLC_FLAG(kRlcParsedStringExpression),
+	[kRlcTokThis] = OPERATOR | RLC_FLAG(kRlcParsedThisExpression),
+	[kRlcTokNull] = OPERATOR | RLC_FLAG(kRlcParsedNullExpression),
+	[kRlcTokLess] = OPERATOR | RLC_FLAG(kRlcParsedCastExpression),
+	[kRlcTokDoubleLess] = OPERATOR | RLC_FLAG(kRlcParsedCastExpression),
+	[kRlcTokTripleLess] = OPERATOR | RLC_FLAG(kRlcParsedCastExpression),
+	[kRlcTokSizeof] = OPERATOR | RLC_FLAG(kRlcParsedSizeofExpression),
+	[kRlcTokColon] = OPERATOR | RLC_FLAG(kRlcParsedSymbolConstantExpression),
+	[kRlcTokParentheseOpen] = OPERATOR,
+	// prefix operators.
+	[kRlcTokMinus] = OPERATOR,
+	[kRlcTokPlus] = OPERATOR,
+	[kRlcTokTilde] = OPERATOR,
+	[kRlcTokExclamationMark] = OPERATOR,
+	[kRlcTokAnd] = OPERATOR,
+	[kRlcTokDoubleAnd] = OPERATOR,
+	[kRlcTokAsterisk] = OPERATOR,
+	[kRlcTokDoublePlus] = OPERATOR,
+	[kRlcTokDoubleMinus] = OPERATOR,
+	[kRlcTokDoubleDotExclamationMark] = OPERATOR,
+	[kRlcTokDoubleDotQuestionMark] = OPERATOR,
+	[kRlcTokAt] = OPERATOR,
+	[kRlcTokDoubleAt] = OPERATOR,
+	[kRlcTokLessMinus] = OPERATOR,
+	[kRlcTokDoubleHash] = OPERATOR,
+	[kRlcTokTripleAnd] = OPERATOR
 };
 
-_Nodiscard static int dummy_rlc_parsed_operator_expression_parse(
-	union RlcExpressionStorage * storage,
-	struct RlcParser * parser)
+#undef OPERATOR
+#undef SYMBOL
+
+int rlc_parsed_expression_first(
+	enum RlcTokenType type)
 {
-	storage->fPointer = rlc_parsed_operator_expression_parse(parser);
+	RLC_DASSERT(RLC_IN_ENUM(type, RlcTokenType));
 
-	return storage->fPointer != NULL;
+	return k_first[type];
 }
 
 struct RlcParsedExpression * rlc_parsed_expression_parse(
@@ -108,10 +98,8 @@ struct RlcParsedExpression * rlc_parsed_expression_parse(
 {
 	RLC_DASSERT(parser != NULL);
 
-	union RlcExpressionStorage storage;
-
 	typedef _Nodiscard int (*parse_fn_t)(
-		union RlcExpressionStorage *,
+		void *,
 		struct RlcParser *);
 
 
@@ -122,6 +110,7 @@ struct RlcParsedExpression * rlc_parsed_expression_parse(
 		RLC_DERIVE_OFFSET(RlcParsedExpression, struct Type), \
 		ispointer }
 
+	// Operator expressions contain all other expressions, so they are tried first.
 	static struct {
 		enum RlcParsedExpressionType fType;
 		parse_fn_t fParseFn;
@@ -136,38 +125,49 @@ struct RlcParsedExpression * rlc_parsed_expression_parse(
 		ENTRY(RlcParsedSymbolExpression, &rlc_parsed_symbol_expression_parse, 0),
 		ENTRY(RlcParsedSymbolChildExpression, &rlc_parsed_symbol_child_expression_parse, 0),
 		ENTRY(RlcParsedThisExpression, &rlc_parsed_this_expression_parse, 0),
-		ENTRY(RlcParsedThisExpression, &rlc_parsed_null_expression_parse, 0),
+		ENTRY(RlcParsedNullExpression, &rlc_parsed_null_expression_parse, 0),
 		ENTRY(RlcParsedCastExpression, &rlc_parsed_cast_expression_parse, 0),
 		ENTRY(RlcParsedSizeofExpression, &rlc_parsed_sizeof_expression_parse, 0),
 		ENTRY(RlcParsedSymbolConstantExpression, &rlc_parsed_symbol_constant_expression_parse, 0)
 	};
+#undef ENTRY
 
 	static_assert(RLC_COVERS_ENUM(k_parse_lookup, RlcParsedExpressionType), "ill-sized parse table.");
 
+	if(rlc_parser_eof(parser))
+		return NULL;
+
 	struct RlcParsedExpression * ret = NULL;
 
-	for(size_t i = 0; i < _countof(k_parse_lookup); i++)
-	{
-		if(RLC_FLAG(k_parse_lookup[i].fType) & flags)
-		{
-			if(k_parse_lookup[i].fParseFn(
-				&storage,
-				parser))
-			{
-				if(!k_parse_lookup[i].fIsPointer)
-				{
-					void * temp = NULL;
-					rlc_malloc(&temp, k_parse_lookup[i].fTypeSize);
+	// Only try the expressions that can start with the current token.
+	int candidates = k_first[rlc_parser_current(parser).type] & flags;
+	// Parse directly into the arena. Parsers that fail consume no tokens, so the memory is reused by the next candidate.
+	void * node = NULL;
+	size_t node_size = 0;
 
-					memcpy(temp, &storage, k_parse_lookup[i].fTypeSize);
+	for(size_t i = 0; candidates; i++)
+	{
+		RLC_DASSERT(i < _countof(k_parse_lookup));
+		if(!(RLC_FLAG(k_parse_lookup[i].fType) & candidates))
+			continue;
+		candidates &= ~RLC_FLAG(k_parse_lookup[i].fType);
 
-					ret = (void*) ((uint8_t*)temp + k_parse_lookup[i].fOffset);
+		if(k_parse_lookup[i].fIsPointer)
+		{
+			if(k_parse_lookup[i].fParseFn(&ret, parser))
+				return ret;
+			continue;
+		}
 
-					return ret;
-				} else
-					return storage.fPointer;
-			}
+		if(node_size < k_parse_lookup[i].fTypeSize)
+		{
+			node = NULL;
+			node_size = k_parse_lookup[i].fTypeSize;
+			rlc_arena_malloc(parser->fArena, &node, node_size);
 		}
+
+		if(k_parse_lookup[i].fParseFn(node, parser))
+			return (void*) ((uint8_t*)node + k_parse_lookup[i].fOffset);
 	}
 
 	struct RlcToken tok;
@@ -182,8 +182,10 @@ struct RlcParsedExpression * rlc_parsed_expression_parse(
 			{
 				opexp = make_operator_expression(
 					kTuple,
-					ret->fStart, tok);
-				rlc_parsed_operator_expression_add(opexp, ret);
+					ret->fStart,
+					rlc_src_string_end(&tok.content),
+					parser->fArena);
+				rlc_parsed_operator_expression_add(opexp, ret, parser->fArena);
 			}
 
 			ret = rlc_parsed_expression_parse(
@@ -193,9 +195,9 @@ struct RlcParsedExpression * rlc_parsed_expression_parse(
 				rlc_parser_fail(parser, "expected expression");
 
 			if(opexp)
-				rlc_parsed_operator_expression_add(opexp, ret);
+				rlc_parsed_operator_expression_add(opexp, ret, parser->fArena);
 			else
-				ret->fStart = tok;
+				ret->fStart = tok.content.start;
 
 		} while(kRlcTokComma == rlc_parser_expect(
 			parser,
@@ -207,7 +209,7 @@ struct RlcParsedExpression * rlc_parsed_expression_parse(
 		if(opexp)
 		{
 			ret = RLC_BASE_CAST(opexp, RlcParsedExpression);
-			ret->fEnd = tok;
+			ret->fEnd = rlc_src_string_end(&tok.content);
 		}
 		return ret;
 	}
@@ -277,33 +279,14 @@ void rlc_parsed_expression_list_create(
 	this->fCount = 0;
 }
 
-void rlc_parsed_expression_list_destroy(
-	struct RlcParsedExpressionList * this)
-{
-	RLC_DASSERT(this != NULL);
-
-
-	if(this->fValues)
-	{
-		for(size_t i = 0; i < this->fCount; i++)
-		{
-			rlc_parsed_expression_destroy_virtual(this->fValues[i]);
-			rlc_free((void**)&this->fValues[i]);
-		}
-		rlc_free((void**)&this->fValues);
-	}
-	this->fCount = 0;
-}
-
 void rlc_parsed_expression_list_append(
 	struct RlcParsedExpressionList * this,
-	struct RlcParsedExpression * value)
+	struct RlcParsedExpression * value,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(value != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fValues,
-		sizeof(struct RlcParsedExpression *) * ++this->fCount);
-	this->fValues[this->fCount-1] = value;
+	RLC_VECTOR_PUSH(arena, this->fValues, this->fCount) = value;
 }
\ No newline at end of file
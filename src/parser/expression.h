@@ -48,10 +48,10 @@ struct RlcParsedExpression
 {
 	RLC_ABSTRACT(RlcParsedExpression);
 
-	/** The expression's first token. */
-	struct RlcToken fStart;
-	/** The expression's last token.*/
-	struct RlcToken fEnd;
+	/** The source index of the expression's first character. */
+	RlcSrcIndex fStart;
+	/** The source index behind the expression's last character. */
+	RlcSrcIndex fEnd;
 };
 
 /** Creates an expression.
@@ -60,28 +60,15 @@ struct RlcParsedExpression
 	@dassert @nonnull
 @param[in] type:
 	The deriving type.
-@param[in] first:
-	The expression's first token. */
+@param[in] start:
+	The source index of the expression's first character.
+@param[in] end:
+	The source index behind the expression's last character. */
 void rlc_parsed_expression_create(
 	struct RlcParsedExpression * this,
 	enum RlcParsedExpressionType type,
-	struct RlcToken first,
-	struct RlcToken last);
-
-/** Destroys an expression.
-@memberof RlcParsedExpression
-@param[in] this:
-	The expression to destroy.*/
-void rlc_parsed_expression_destroy_virtual(
-	struct RlcParsedExpression * this);
-
-/** Destroys the expression base instance.
-@memberof RlcParsedExpression
-@param[in,out] this:
-	The expression base instance to destroy.
-	@dassert @nonnull */
-void rlc_parsed_expression_destroy_base(
-	struct RlcParsedExpression * this);
+	RlcSrcIndex start,
+	RlcSrcIndex end);
 
 /** Parses an expression.
 @memberof RlcParsedExpression
@@ -93,6 +80,16 @@ struct RlcParsedExpression * rlc_parsed_expression_parse(
 	struct RlcParser * parser,
 	int flags);
 
+/** Retrieves which expressions can start with a token.
+@memberof RlcParsedExpression
+@param[in] type:
+	The token's type.
+	@dassert `type` is a valid token type.
+@return
+	The `RlcParsedExpressionType` flags of the expressions that can start with the token. Operator expressions contain all other expressions, so the flags are nonzero exactly if any expression can start with the token. */
+_Nodiscard int rlc_parsed_expression_first(
+	enum RlcTokenType type);
+
 void rlc_parsed_expression_print(
 	struct RlcParsedExpression const * this,
 	struct RlcSrcFile const * file,
@@ -115,14 +112,6 @@ struct RlcParsedExpressionList
 void rlc_parsed_expression_list_create(
 	struct RlcParsedExpressionList * this);
 
-/** Destroys an expression list.
-@memberof RlcParsedExpressionList
-@param[in,out] this:
-	The expression list to destroy.
-	@dassert @nonnull */
-void rlc_parsed_expression_list_destroy(
-	struct RlcParsedExpressionList * this);
-
 /** Appends an expression to an expression list.
 @memberof RlcParsedExpressionList
 @param[in,out] this:
@@ -131,10 +120,14 @@ void rlc_parsed_expression_list_destroy(
 @param[in] expression:
 	The expression to append to the list.
 	@pass_pointer_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_expression_list_append(
 	struct RlcParsedExpressionList * this,
-	struct RlcParsedExpression * expression);
+	struct RlcParsedExpression * expression,
+	struct RlcArena * arena);
 
 #ifdef __cplusplus
 }
@@ -1,7 +1,6 @@
 #include "expressionstatement.h"
 
 #include "../assert.h"
-#include "../malloc.h"
 
 void rlc_parsed_expression_statement_create(
 	struct RlcParsedExpressionStatement * this)
@@ -15,20 +14,6 @@ void rlc_parsed_expression_statement_create(
 	this->fExpression = NULL;
 }
 
-void rlc_parsed_expression_statement_destroy(
-	struct RlcParsedExpressionStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fExpression)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fExpression);
-		rlc_free((void**)&this->fExpression);
-	}
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 int rlc_parsed_expression_statement_parse(
 	struct RlcParsedExpressionStatement * out,
 	struct RlcParser * parser)
@@ -45,10 +30,7 @@ int rlc_parsed_expression_statement_parse(
 
 
 	if(!out->fExpression)
-	{
-		rlc_parsed_expression_statement_destroy(out);
 		return 0;
-	}
 
 	rlc_parser_expect(
 		parser,
@@ -24,14 +24,6 @@ struct RlcParsedExpressionStatement
 void rlc_parsed_expression_statement_create(
 	struct RlcParsedExpressionStatement * this);
 
-/** Destroys an expression statement.
-@memberof RlcParsedExpressionStatement
-@param[in,out] this:
-	The expression statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_expression_statement_destroy(
-	struct RlcParsedExpressionStatement * this);
-
 /** Parses an expression statement.
 @memberof RlcParsedExpressionStatement
 @param[out] out:
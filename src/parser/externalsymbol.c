@@ -22,20 +22,6 @@ void rlc_parsed_external_symbol_create(
 	this->fIsFunction = 0;
 }
 
-void rlc_parsed_external_symbol_destroy(
-	struct RlcParsedExternalSymbol * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-
-	if(this->fIsFunction)
-		rlc_parsed_function_destroy(&this->fFunction);
-	else
-		rlc_parsed_type_name_destroy(&this->fType);
-}
-
 int rlc_parsed_external_symbol_parse(
 	struct RlcParsedExternalSymbol * out,
 	struct RlcParser * parser,
@@ -47,14 +47,6 @@ void rlc_parsed_external_symbol_create(
 	struct RlcToken const * linkname,
 	struct RlcSrcString const * name);
 
-/** Destroys an external symbol.
-@memberof RlcParsedExternalSymbol
-@param[in,out] this:
-	The external symbol to destroy.
-	@dassert @nonnull */
-void rlc_parsed_external_symbol_destroy(
-	struct RlcParsedExternalSymbol * this);
-
 /** Parses an external symbol declaration.
 @memberof RlcParsedExternalSymbol
 @param[out] out:
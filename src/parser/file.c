@@ -1,9 +1,11 @@
 #include "file.h"
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 #include "../printer.h"
+#include "parsecache.h"
 
 #include <stdio.h>
+#include <sys/mman.h>
 
 int rlc_parsed_file_create(
 	struct RlcParsedFile * this,
@@ -17,35 +19,67 @@ int rlc_parsed_file_create(
 
 	struct RlcParser parser;
 
+	rlc_arena_create(&this->fArena);
 	this->fIncludes = NULL;
 	this->fIncludeCount = 0;
 	rlc_parsed_scope_entry_list_create(&this->fScopeEntries);
-	rlc_parser_create(&parser, &this->fSource);
+	this->fCache = NULL;
+	this->fCacheSize = 0;
+
+	if(rlc_parse_cache_load(this))
+		return 1;
+
+	rlc_parser_create(&parser, &this->fSource, &this->fArena);
+
+	// Syntax errors skip the failed include or scope entry, and parsing continues with the next one.
+	struct RlcParserRecovery recovery;
+	rlc_parser_recovery_push(&parser, &recovery);
 
 	struct RlcParsedIncludeStatement include;
-	while(rlc_parsed_include_statement_parse(
-		&include,
-		&parser))
+	for(;;)
 	{
-		rlc_realloc(
-			(void**)&this->fIncludes,
-			sizeof(struct RlcParsedIncludeStatement) * ++this->fIncludeCount);
-		this->fIncludes[this->fIncludeCount-1] = include;
+		rlc_parser_recovery_mark(&parser, &recovery);
+		if(setjmp(recovery.fJump))
+			continue;
+
+		if(!rlc_parsed_include_statement_parse(
+			&include,
+			&parser))
+			break;
+		RLC_VECTOR_PUSH(&this->fArena, this->fIncludes, this->fIncludeCount) = include;
 	}
+	RLC_VECTOR_SHRINK(&this->fArena, this->fIncludes, this->fIncludeCount);
 
 	struct RlcParsedScopeEntry * entry;
 	while(!rlc_parser_eof(&parser))
 	{
+		rlc_parser_recovery_mark(&parser, &recovery);
+		if(setjmp(recovery.fJump))
+			continue;
+
 		if((entry = rlc_parsed_scope_entry_parse(&parser)))
 			rlc_parsed_scope_entry_list_add(
 				&this->fScopeEntries,
-				entry);
+				entry,
+				&this->fArena);
 		else
 			rlc_parser_fail(&parser, "expected scope entry");
 	}
+	RLC_VECTOR_SHRINK(
+		&this->fArena,
+		this->fScopeEntries.fEntries,
+		this->fScopeEntries.fEntryCount);
 
+	rlc_parser_recovery_pop(&parser, &recovery);
+	// Trees with errors are never cached, so that their errors are reported again.
+	int const failed = !rlc_parser_eof(&parser)
+		|| parser.fErrorToken != SIZE_MAX
+		|| parser.fTokens.fTokeniser.fError;
 	rlc_parser_destroy(&parser);
 
+	if(!failed)
+		rlc_parse_cache_store(this);
+
 	return 1;
 }
 
@@ -54,11 +88,17 @@ void rlc_parsed_file_destroy(
 {
 	RLC_DASSERT(this != NULL);
 
-	if(this->fIncludes)
-		rlc_free((void**)&this->fIncludes);
+	this->fIncludes = NULL;
 	this->fIncludeCount = 0;
+	rlc_parsed_scope_entry_list_create(&this->fScopeEntries);
 
-	rlc_parsed_scope_entry_list_destroy(&this->fScopeEntries);
+	rlc_arena_destroy(&this->fArena);
+	if(this->fCache)
+	{
+		munmap(this->fCache, this->fCacheSize);
+		this->fCache = NULL;
+		this->fCacheSize = 0;
+	}
 	rlc_src_file_destroy(&this->fSource);
 }
 
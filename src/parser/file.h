@@ -5,6 +5,7 @@
 
 #include "scopeentry.h"
 #include "includestatement.h"
+#include "../arena.h"
 
 #include <stdio.h>
 
@@ -19,12 +20,18 @@ struct RlcParsedFile
 {
 	/** The source file. */
 	struct RlcSrcFile fSource;
+	/** The arena holding the file's syntax tree. */
+	struct RlcArena fArena;
 	/** The file's include statements. */
 	struct RlcParsedIncludeStatement * fIncludes;
 	/** The file's include statement count.*/
 	size_t fIncludeCount;
 	/** The file's parsed scope entries. */
 	struct RlcParsedScopeEntryList fScopeEntries;
+	/** If the syntax tree was loaded from the parse cache, the cache entry's memory mapping, and the arena is empty. */
+	void * fCache;
+	/** The size of `fCache`. */
+	size_t fCacheSize;
 };
 
 /** Creates a parsed file from a preprocessed file.
@@ -43,6 +50,7 @@ _Nodiscard int rlc_parsed_file_create(
 	char const * filename);
 
 /** Destroys a parsed file.
+	Releases the whole syntax tree at once.
 @memberof RlcParsedFile
 @param[in,out] this:
 	The parsed file to destroy.
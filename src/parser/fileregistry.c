@@ -1,6 +1,7 @@
 #include "fileregistry.h"
 #include "../assert.h"
 #include "../malloc.h"
+#include "../vector.h"
 #include "../tokeniser/tokens.h"
 #include "../tokeniser/tokeniser.h"
 
@@ -14,6 +15,8 @@ void rlc_parsed_file_registry_create(
 	this->fFailedFileCount = 0;
 	this->fFiles = NULL;
 	this->fFileCount = 0;
+	rlc_hash_map_create(&this->fIndex, kRlcHashMapKeyString);
+	pthread_mutex_init(&this->fLock, NULL);
 }
 
 void rlc_parsed_file_registry_destroy(
@@ -21,11 +24,13 @@ void rlc_parsed_file_registry_destroy(
 {
 	RLC_DASSERT(this != NULL);
 
-	if(this->fFailedFiles)
-	{
-		rlc_free((void**)&this->fFailedFiles);
-		this->fFailedFileCount = 0;
-	}
+	rlc_hash_map_destroy(&this->fIndex);
+	pthread_mutex_destroy(&this->fLock);
+
+	for(size_t i = 0; i < this->fFailedFileCount; i++)
+		rlc_free((void**)&this->fFailedFiles[i]);
+	rlc_vector_free((void**)&this->fFailedFiles);
+	this->fFailedFileCount = 0;
 
 	if(this->fFiles)
 	{
@@ -34,7 +39,7 @@ void rlc_parsed_file_registry_destroy(
 			rlc_parsed_file_destroy(this->fFiles[i]);
 			rlc_free((void**)&this->fFiles[i]);
 		}
-		rlc_free((void**)&this->fFiles);
+		rlc_vector_free((void**)&this->fFiles);
 		this->fFileCount = 0;
 	}
 }
@@ -46,21 +51,21 @@ static void rlc_parsed_file_registry_add_parsed_file(
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(file != NULL);
 
-	rlc_realloc(
-		(void**)&this->fFiles,
-		sizeof(struct RlcParsedFile *) * ++this->fFileCount);
-	this->fFiles[this->fFileCount-1] = file;
+	RLC_VECTOR_PUSH(NULL, this->fFiles, this->fFileCount) = file;
+	rlc_hash_map_insert(&this->fIndex, rlc_parsed_file_name(file), file);
 }
 
 static void rlc_parsed_file_registry_add_failure(
 	struct RlcParsedFileRegistry * this,
 	char const * name)
 {
-	rlc_realloc(
-		(void**)&this->fFailedFiles,
-		sizeof(char const *) * ++this->fFailedFileCount);
+	size_t const len = strlen(name);
+	char * copy = NULL;
+	rlc_malloc((void**)&copy, len + 1);
+	memcpy(copy, name, len + 1);
 
-	this->fFailedFiles[this->fFailedFileCount-1] = name;
+	RLC_VECTOR_PUSH(NULL, this->fFailedFiles, this->fFailedFileCount) = copy;
+	rlc_hash_map_insert(&this->fIndex, copy, NULL);
 }
 
 struct RlcParsedFile * rlc_parsed_file_registry_get(
@@ -70,41 +75,45 @@ struct RlcParsedFile * rlc_parsed_file_registry_get(
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(file != NULL);
 
-	// Look whether the file was already parsed.
-	for(size_t i = 0; i < this->fFileCount; i++)
-	{
-		if(!strcmp(
-			rlc_parsed_file_name(this->fFiles[i]),
-			file))
-		{
-			return this->fFiles[i];
-		}
-	}
-
-	// Look whether the file failed already before.
-	for(size_t i = 0; i < this->fFailedFileCount; i++)
-	{
-		if(!strcmp(
-			this->fFailedFiles[i],
-			file))
-		{
-			return NULL;
-		}
-	}
-
-	// Try to parse the file.
+	// Look whether the file was already parsed, or failed before.
+	pthread_mutex_lock(&this->fLock);
+	void ** known = rlc_hash_map_find(&this->fIndex, file);
+	struct RlcParsedFile * result = known ? *known : NULL;
+	pthread_mutex_unlock(&this->fLock);
+	if(known)
+		return result;
 
-	// Read the file.
+	// Try to parse the file, without blocking other threads.
 	struct RlcParsedFile * parsed_file = NULL;
 	rlc_malloc((void**)&parsed_file, sizeof(struct RlcParsedFile));
+	int const success = rlc_parsed_file_create(parsed_file, file);
 
-	if(!rlc_parsed_file_create(parsed_file, file))
+	pthread_mutex_lock(&this->fLock);
+	// Another thread may have finished the same file in the meantime.
+	if((known = rlc_hash_map_find(&this->fIndex, file)))
 	{
-		rlc_parsed_file_registry_add_failure(this, file);
-		return NULL;
+		result = *known;
+		// Keep the duplicate alive, as registered symbol constants may point into its source text.
+		if(success)
+			RLC_VECTOR_PUSH(NULL, this->fFiles, this->fFileCount) = parsed_file;
+		pthread_mutex_unlock(&this->fLock);
+
+		if(!success)
+			rlc_free((void**)&parsed_file);
+		return result;
 	}
 
 	// Add the file to the registry and return it.
-	rlc_parsed_file_registry_add_parsed_file(this, parsed_file);
-	return parsed_file;
+	if(success)
+	{
+		rlc_parsed_file_registry_add_parsed_file(this, parsed_file);
+		result = parsed_file;
+	} else
+	{
+		rlc_parsed_file_registry_add_failure(this, file);
+		rlc_free((void**)&parsed_file);
+	}
+	pthread_mutex_unlock(&this->fLock);
+
+	return result;
 }
\ No newline at end of file
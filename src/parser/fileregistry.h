@@ -2,17 +2,20 @@
 #define __rlc_parser_fileregistry_h_defined
 
 #include "file.h"
+#include "../hashmap.h"
 
 #include <stddef.h>
+#include <pthread.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/** A registry for parsed files. */
+/** A registry for parsed files.
+	Files can be retrieved from multiple threads at once. */
 struct RlcParsedFileRegistry
 {
-	/** File names that failed with and error. */
+	/** File names that failed with and error. Owned by the registry. */
 	char const * * fFailedFiles;
 	/** How many files failed with an error. */
 	size_t fFailedFileCount;
@@ -20,6 +23,10 @@ struct RlcParsedFileRegistry
 	struct RlcParsedFile ** fFiles;
 	/** How many files were parsed. */
 	size_t fFileCount;
+	/** Maps file names to parsed files, and failed file names to null. */
+	struct RlcHashMap fIndex;
+	/** Protects the registry's contents. Files are parsed without holding it. */
+	pthread_mutex_t fLock;
 };
 
 /** Creates a parsed file registry.
@@ -39,7 +46,7 @@ void rlc_parsed_file_registry_destroy(
 	struct RlcParsedFileRegistry * this);
 
 /** Retrieves a parsed file from the file registry.
-	If the requested file did not exist, tries to parse it.
+	If the requested file did not exist, tries to parse it. If multiple threads parse the same file at once, all of them return the first parsed instance.
 @memberof RlcParsedFileRegistry
 @param[in,out] this:
 	The file registry to retrieve a file from.
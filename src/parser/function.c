@@ -1,7 +1,7 @@
 #include "function.h"
 
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 #include "../resolver/resolver.h"
 
 void rlc_parsed_function_create(
@@ -33,63 +33,16 @@ void rlc_parsed_function_create(
 	this->fIsShortHandBody = 0;
 }
 
-void rlc_parsed_function_destroy(
-	struct RlcParsedFunction * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fHasReturnType)
-		rlc_parsed_type_name_destroy(&this->fReturnType);
-	this->fHasReturnType = 0;
-
-	if(this->fArguments)
-	{
-		for(size_t i = 0; i < this->fArgumentCount; i++)
-			rlc_parsed_variable_destroy(&this->fArguments[i]);
-		rlc_free((void**)&this->fArguments);
-	}
-	this->fArgumentCount = 0;
-
-	this->fIsInline = 0;
-
-	if(this->fHasBody)
-	{
-		if(!this->fIsShortHandBody)
-		{
-			rlc_parsed_block_statement_destroy(&this->fBodyStatement);
-		} else
-		{
-			if(this->fReturnValue)
-			{
-				rlc_parsed_expression_destroy_virtual(
-					this->fReturnValue);
-
-				rlc_free((void**)&this->fReturnValue);
-			}
-		}
-		this->fHasBody = 0;
-	}
-
-	rlc_parsed_template_decl_destroy(&this->fTemplates);
-
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-
-	this->fIsShortHandBody = 0;
-}
-
 void rlc_parsed_function_add_argument(
 	struct RlcParsedFunction * this,
-	struct RlcParsedVariable * variable)
+	struct RlcParsedVariable * variable,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(variable != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fArguments,
-		sizeof(struct RlcParsedVariable) * ++this->fArgumentCount);
-
-	this->fArguments[this->fArgumentCount - 1] = *variable;
+	RLC_VECTOR_PUSH(arena, this->fArguments, this->fArgumentCount) = *variable;
 }
 
 int rlc_parsed_function_parse(
@@ -180,7 +133,7 @@ int rlc_parsed_function_parse(
 				struct RlcParsedVariable rhs;
 				if(!rlc_parsed_variable_parse(&rhs, parser, NULL, 0,0,0,0,1))
 					rlc_parser_fail(parser, "expected argument");
-				rlc_parsed_function_add_argument(out, &rhs);
+				rlc_parsed_function_add_argument(out, &rhs, parser->fArena);
 				rlc_parser_expect(parser, NULL, 1, kRlcTokParentheseClose);
 
 				if(!i && arity == 2)
@@ -224,7 +177,8 @@ int rlc_parsed_function_parse(
 			{
 				rlc_parsed_function_add_argument(
 					out,
-					&argument);
+					&argument,
+					parser->fArena);
 
 				if(!rlc_parser_consume(
 					parser,
@@ -439,7 +393,7 @@ static void rlc_parsed_function_print_head_2(
 		{
 			fputs("operator ", out);
 			if(this->fIsAsync)
-				fputs("::std::future<", out);
+				fputs("::__rl::Future<", out);
 			rlc_parsed_type_name_print(&this->fReturnType, file, out);
 			if(this->fIsAsync)
 					fputc('>', out);
@@ -482,7 +436,7 @@ static void rlc_parsed_function_print_head_3(
 			{
 				fputs(" -> ", out);
 				if(this->fIsAsync)
-					fputs("::std::future<", out);
+					fputs("::__rl::Task<", out);
 				fputs("::__rl::auto_t<decltype(", out);
 				rlc_parsed_expression_print(this->fReturnValue, file, out);
 				fputs(")>\n", out);
@@ -505,7 +459,7 @@ static void rlc_parsed_function_print_head_3(
 		{
 			fputs(" -> ", out);
 			if(this->fIsAsync)
-				fputs("::std::future<", out);
+				fputs("::__rl::Task<", out);
 			rlc_parsed_type_name_print(&this->fReturnType, file, out);
 			if(this->fIsAsync)
 				fputc('>', out);
@@ -554,16 +508,43 @@ static void rlc_parsed_function_print_body(
 	fputs("\n#undef _return\n", out);
 }
 
+/** Whether a function's return type is deduced from its body. */
+static int rlc_parsed_function_has_deduced_return(
+	struct RlcParsedFunction const * this)
+{
+	return this->fType != kRlcFunctionTypeCast
+		&& this->fHasReturnType == kRlcFunctionReturnTypeAuto
+		&& !this->fIsShortHandBody;
+}
+
 void rlc_parsed_function_print(
 	struct RlcParsedFunction const * this,
 	struct RlcSrcFile const * file,
 	struct RlcPrinter const * printer)
 {
 
+	enum RlcPrinterDefinition const definition = rlc_printer_definition(
+		printer,
+		&this->fTemplates);
+	// Deduced return types must be visible to all callers, so in split mode, such functions are defined in every unit.
+	int const deduced = printer->fUnits
+		&& definition == kRlcPrinterDefinitionExclusive
+		&& rlc_parsed_function_has_deduced_return(this);
+
+	if(deduced)
+		fputs("inline ", printer->fFuncs);
 	rlc_parsed_function_print_head(this, file, printer->fFuncs, 1);
 	fputs(";\n", printer->fFuncs);
+
+	rlc_printer_begin_definition(
+		printer,
+		printer->fFuncsImpl,
+		deduced ? kRlcPrinterDefinitionShared : definition);
+	if(deduced)
+		fputs("inline ", printer->fFuncsImpl);
 	rlc_parsed_function_print_head(this, file, printer->fFuncsImpl, 1);
 	rlc_parsed_function_print_body(this, file, printer->fFuncsImpl);
+	rlc_printer_end_definition(printer, printer->fFuncsImpl);
 }
 
 void rlc_parsed_member_function_create(
@@ -631,18 +612,6 @@ int rlc_parsed_member_function_parse(
 	return 1;
 }
 
-void rlc_parsed_member_function_destroy(
-	struct RlcParsedMemberFunction * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_function_destroy(
-		RLC_BASE_CAST(this, RlcParsedFunction));
-
-	rlc_parsed_member_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedMember));
-}
-
 void rlc_parsed_member_function_print(
 	struct RlcParsedMemberFunction const * this,
 	struct RlcSrcFile const * file,
@@ -716,6 +685,20 @@ void rlc_parsed_member_function_print(
 	{
 		out = printer->fFuncsImpl;
 
+		enum RlcPrinterDefinition const definition = rlc_printer_definition(
+			printer,
+			&RLC_BASE_CAST(this, RlcParsedFunction)->fTemplates);
+		int const deduced = printer->fUnits
+			&& definition == kRlcPrinterDefinitionExclusive
+			&& rlc_parsed_function_has_deduced_return(
+				RLC_BASE_CAST(this, RlcParsedFunction));
+		rlc_printer_begin_definition(
+			printer,
+			out,
+			deduced ? kRlcPrinterDefinitionShared : definition);
+		if(deduced)
+			fputs("inline ", out);
+
 		rlc_printer_print_ctx_tpl(printer, file, out);
 		rlc_parsed_template_decl_print(
 			&RLC_BASE_CAST(this, RlcParsedFunction)->fTemplates,
@@ -748,6 +731,7 @@ void rlc_parsed_member_function_print(
 			RLC_BASE_CAST(this, RlcParsedFunction),
 			file,
 			out);
+		rlc_printer_end_definition(printer, out);
 	}
 
 	if(RLC_BASE_CAST(this, RlcParsedFunction)->fType == kRlcFunctionTypeOperator)
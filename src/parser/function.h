@@ -85,13 +85,6 @@ void rlc_parsed_function_create(
 	struct RlcSrcString const * name,
 	struct RlcParsedTemplateDecl const * templates);
 
-/** Destroys a parsed function.
-@memberof RlcParsedFunction
-@param[in] this:
-	The function to destroy. @dassert @nonnull */
-void rlc_parsed_function_destroy(
-	struct RlcParsedFunction * this);
-
 /** Adds an argument to a function.
 @memberof RlcParsedFunction
 @param[in,out] this:
@@ -100,10 +93,14 @@ void rlc_parsed_function_destroy(
 @param[in,out] variable:
 	The argument to add.
 	@instance_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_function_add_argument(
 	struct RlcParsedFunction * this,
-	struct RlcParsedVariable * variable);
+	struct RlcParsedVariable * variable,
+	struct RlcArena * arena);
 
 /** Parses a function.
 @memberof RlcParsedFunction
@@ -162,14 +159,6 @@ void rlc_parsed_member_function_create(
 	struct RlcParsedMemberFunction * this,
 	struct RlcParsedMemberCommon const * member);
 
-/** Destroys a parsed member function.
-@memberof RlcParsedMemberFunction
-@param[in] this:
-	The parsed member function to destroy.
-	@dassert @nonnull */
-void rlc_parsed_member_function_destroy(
-	struct RlcParsedMemberFunction * this);
-
 _Nodiscard int rlc_parsed_member_function_parse(
 	struct RlcParsedMemberFunction * out,
 	struct RlcParser * parser,
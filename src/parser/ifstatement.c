@@ -1,7 +1,6 @@
 #include "ifstatement.h"
 
 #include "../assert.h"
-#include "../malloc.h"
 
 static int const kBodyStatementFlags =
 	RLC_ALL_FLAGS(RlcParsedStatementType)
@@ -24,33 +23,6 @@ void rlc_parsed_if_statement_create(
 	this->fElse = NULL;
 }
 
-void rlc_parsed_if_statement_destroy(
-	struct RlcParsedIfStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fCondition.fIsVariable)
-	{
-		rlc_parsed_variable_destroy(&this->fCondition.fVariable);
-	} else if(this->fCondition.fExpression)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fCondition.fExpression);
-		rlc_free((void**)&this->fCondition.fExpression);
-	}
-
-	if(this->fIf)
-	{
-		rlc_parsed_statement_destroy_virtual(this->fIf);
-		rlc_free((void**)&this->fIf);
-	}
-
-	if(this->fElse)
-	{
-		rlc_parsed_statement_destroy_virtual(this->fElse);
-		rlc_free((void**)&this->fElse);
-	}
-}
-
 int rlc_parsed_if_statement_parse(
 	struct RlcParsedIfStatement * out,
 	struct RlcParser * parser)
@@ -49,14 +49,6 @@ struct RlcParsedIfStatement
 void rlc_parsed_if_statement_create(
 	struct RlcParsedIfStatement * this);
 
-/** Destroys an if statement.
-@memberof RlcParsedIfStatement
-@param[out] this:
-	The if statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_if_statement_destroy(
-	struct RlcParsedIfStatement * this);
-
 /** Parses an if statement.
 @memberof RlcParsedIfStatement
 @param[out] out:
@@ -1,7 +1,6 @@
 #include "loopstatement.h"
 
 #include "../assert.h"
-#include "../malloc.h"
 
 void rlc_parsed_loop_statement_create(
 	struct RlcParsedLoopStatement * this)
@@ -20,45 +19,6 @@ void rlc_parsed_loop_statement_create(
 	this->fPostLoop = NULL;
 }
 
-void rlc_parsed_loop_statement_destroy(
-	struct RlcParsedLoopStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this,RlcParsedStatement));
-
-	if(this->fIsVariableInitial)
-	{
-		rlc_parsed_variable_destroy(&this->fInitial.fVariable);
-	} else if(this->fInitial.fExpression)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fInitial.fExpression);
-		rlc_free((void**)&this->fInitial.fExpression);
-	}
-
-	if(this->fIsVariableCondition)
-	{
-		rlc_parsed_variable_destroy(&this->fCondition.fVariable);
-	} else if(this->fCondition.fExpression)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fCondition.fExpression);
-		rlc_free((void**)&this->fCondition.fExpression);
-	}
-
-	if(this->fBody)
-	{
-		rlc_parsed_statement_destroy_virtual(this->fBody);
-		rlc_free((void**)&this->fBody);
-	}
-
-	if(this->fPostLoop)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fPostLoop);
-		rlc_free((void**)&this->fPostLoop);
-	}
-}
-
 static void parse_initial(
 	struct RlcParsedLoopStatement * out,
 	struct RlcParser * parser)
@@ -56,14 +56,6 @@ struct RlcParsedLoopStatement
 	@dassert @nonnull */
 void rlc_parsed_loop_statement_create(
 	struct RlcParsedLoopStatement * this);
-/** Destroys a loop statement.
-@memberof RlcParsedLoopStatement
-@param[out] this:
-	The loop statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_loop_statement_destroy(
-	struct RlcParsedLoopStatement * this);
-
 /** Parses a loop statement.
 @memberof RlcParsedLoopStatement
 @param[out] out:
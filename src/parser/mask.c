@@ -1,5 +1,5 @@
 #include "mask.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 void rlc_parsed_mask_create(
 	struct RlcParsedMask * this,
@@ -23,24 +23,6 @@ void rlc_parsed_mask_create(
 	this->fFunctionCount = 0;
 }
 
-void rlc_parsed_mask_destroy(
-	struct RlcParsedMask * this)
-{
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-
-	rlc_parsed_template_decl_destroy(&this->fTemplates);
-
-	for(RlcSrcSize i = 0; i < this->fFunctionCount; i++)
-		rlc_parsed_member_function_destroy(&this->fFunctions[i]);
-
-	if(this->fFunctions)
-	{
-		rlc_free((void**)&this->fFunctions);
-		this->fFunctionCount = 0;
-	}
-}
-
 int rlc_parsed_mask_parse(
 	struct RlcParsedMask * out,
 	struct RlcParser * parser,
@@ -94,10 +76,7 @@ int rlc_parsed_mask_parse(
 		if(!RLC_BASE(&memfn, RlcParsedFunction)->fHasBody)
 			++mask_fns;
 
-		rlc_realloc(
-			(void**)&out->fFunctions,
-			++out->fFunctionCount * sizeof(struct RlcParsedMemberFunction));
-		out->fFunctions[out->fFunctionCount-1] = memfn;
+		RLC_VECTOR_PUSH(parser->fArena, out->fFunctions, out->fFunctionCount) = memfn;
 	}
 
 	rlc_parser_expect(
@@ -36,14 +36,6 @@ void rlc_parsed_mask_create(
 	struct RlcSrcString const * name,
 	struct RlcParsedTemplateDecl const * templates);
 
-/** Destroys a parsed mask.
-@memberof RlcParsedMask
-@param[in,out] this:
-	The parsed mask to destroy.
-	@dassert @nonnull */
-void rlc_parsed_mask_destroy(
-	struct RlcParsedMask * this);
-
 /** Parses a mask.
 @memberof RlcParsedMask
 @param[out] out:
@@ -10,7 +10,7 @@
 #include "destructor.h"
 
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 #include <string.h>
 
@@ -46,56 +46,6 @@ void rlc_parsed_member_create(
 	this->fAttribute = member->attribute;
 }
 
-void rlc_parsed_member_delete_virtual(
-	struct RlcParsedMember * this)
-{
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(RLC_IN_ENUM(RLC_DERIVING_TYPE(this), RlcParsedMemberType));
-
-	typedef void (*destructor_t)(
-		void * this);
-
-	static destructor_t const k_vtable[] = {
-		(destructor_t)&rlc_parsed_member_function_destroy,
-		(destructor_t)&rlc_parsed_member_variable_destroy,
-		(destructor_t)&rlc_parsed_member_rawtype_destroy,
-		(destructor_t)&rlc_parsed_member_union_destroy,
-		(destructor_t)&rlc_parsed_member_class_destroy,
-		(destructor_t)&rlc_parsed_member_enum_destroy,
-		(destructor_t)&rlc_parsed_member_typedef_destroy,
-		(destructor_t)&rlc_parsed_constructor_destroy,
-		(destructor_t)&rlc_parsed_destructor_destroy
-	};
-
-	static_assert(RLC_COVERS_ENUM(k_vtable, RlcParsedMemberType), "ill-sized vtable.");
-
-	static intptr_t const k_offsets[] = {
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedMemberFunction),
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedMemberVariable),
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedMemberRawtype),
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedMemberUnion),
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedMemberClass),
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedMemberEnum),
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedMemberTypedef),
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedConstructor),
-		RLC_DERIVE_OFFSET(RlcParsedMember, struct RlcParsedDestructor)
-	};
-
-	static_assert(RLC_COVERS_ENUM(k_offsets, RlcParsedMemberType), "ill-sized offset table.");
-
-
-	void * p = (uint8_t*)this + k_offsets[RLC_DERIVING_TYPE(this)];
-	k_vtable[RLC_DERIVING_TYPE(this)](p);
-
-	rlc_free(&p);
-}
-
-void rlc_parsed_member_destroy_base(
-	struct RlcParsedMember * this)
-{
-	RLC_DASSERT(this != NULL);
-}
-
 struct RlcSrcString const * rlc_parsed_member_name(
 	struct RlcParsedMember const * this)
 {
@@ -383,7 +333,7 @@ struct RlcParsedMember * rlc_parsed_member_parse(
 				member))
 			{
 				void * temp = NULL;
-				rlc_malloc(&temp, k_parse_lookup[i].fTypeSize);
+				rlc_arena_malloc(parser->fArena, &temp, k_parse_lookup[i].fTypeSize);
 
 				memcpy(temp, &pack, k_parse_lookup[i].fTypeSize);
 
@@ -459,33 +409,14 @@ void rlc_parsed_member_list_create(
 
 void rlc_parsed_member_list_add(
 	struct RlcParsedMemberList * this,
-	struct RlcParsedMember * member)
+	struct RlcParsedMember * member,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(member != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fEntries,
-		++this->fEntryCount * sizeof(struct RlcParsedMember *));
-
-	this->fEntries[this->fEntryCount-1] = member;
-}
-
-void rlc_parsed_member_list_destroy(
-	struct RlcParsedMemberList * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fEntries)
-	{
-		for(size_t i = 0; i < this->fEntryCount; i++)
-		{
-			rlc_parsed_member_delete_virtual(this->fEntries[i]);
-		}
-		rlc_free((void**)&this->fEntries);
-	}
-
-	this->fEntryCount = 0;
+	RLC_VECTOR_PUSH(arena, this->fEntries, this->fEntryCount) = member;
 }
 
 void rlc_parsed_member_list_print(
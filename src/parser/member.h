@@ -142,23 +142,6 @@ void rlc_parsed_member_create(
 	enum RlcParsedMemberType type,
 	struct RlcParsedMemberCommon const * common);
 
-/** Destroys and deletes a parsed member.
-@memberof RlcParsedMember
-@param[in] this:
-	The member to destroy and delete.
-	@dassert @nonnull */
-void rlc_parsed_member_delete_virtual(
-	struct RlcParsedMember * this);
-
-/** Destroys a parsed member.
-	This function is to be called by deriving destructors.
-@memberof RlcParsedMember
-@param[in] this:
-	The member to destroy.
-	@dassert @nonnull */
-void rlc_parsed_member_destroy_base(
-	struct RlcParsedMember * this);
-
 /** Returns the name of a parsed member.
 @memberof RlcParsedMember
 @param[in] this:
@@ -217,17 +200,14 @@ void rlc_parsed_member_list_create(
 @param[in] member:
 	The member to add to the list.
 	@pass_pointer_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_member_list_add(
 	struct RlcParsedMemberList * this,
-	struct RlcParsedMember * member);
-
-/** Destroys a member list.
-@param[in,out] this:
-	The member list to destroy. */
-void rlc_parsed_member_list_destroy(
-	struct RlcParsedMemberList * this);
-
+	struct RlcParsedMember * member,
+	struct RlcArena * arena);
 
 void rlc_parsed_member_list_print(
 	struct RlcParsedMemberList const * this,
@@ -1,7 +1,6 @@
 #include "namespace.h"
 
 #include "../assert.h"
-#include "../malloc.h"
 
 void rlc_parsed_namespace_create(
 	struct RlcParsedNamespace * this,
@@ -16,16 +15,6 @@ void rlc_parsed_namespace_create(
 	rlc_parsed_scope_entry_list_create(&this->fEntryList);
 }
 
-void rlc_parsed_namespace_destroy(
-	struct RlcParsedNamespace * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_scope_entry_list_destroy(&this->fEntryList);
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-}
-
 int rlc_parsed_namespace_parse(
 	struct RlcParsedNamespace * out,
 	struct RlcParser * parser,
@@ -63,13 +52,26 @@ int rlc_parsed_namespace_parse(
 		NULL,
 		kRlcTokBraceOpen))
 	{
-		for(struct RlcParsedScopeEntry * scopeEntry;
-			(scopeEntry = rlc_parsed_scope_entry_parse(parser));)
+		struct RlcParserRecovery recovery;
+		rlc_parser_recovery_push(parser, &recovery);
+		for(struct RlcParsedScopeEntry * scopeEntry;;)
 		{
+			rlc_parser_recovery_mark(parser, &recovery);
+			if(setjmp(recovery.fJump))
+				continue;
+
+			if(!(scopeEntry = rlc_parsed_scope_entry_parse(parser)))
+			{
+				if(rlc_parser_eof(parser) || rlc_parser_is_current(parser, kRlcTokBraceClose))
+					break;
+				rlc_parser_fail(parser, "expected scope entry");
+			}
 			rlc_parsed_scope_entry_list_add(
 				&out->fEntryList,
-				scopeEntry);
+				scopeEntry,
+				parser->fArena);
 		}
+		rlc_parser_recovery_pop(parser, &recovery);
 
 		rlc_parser_expect(
 			parser,
@@ -84,7 +86,8 @@ int rlc_parsed_namespace_parse(
 
 		rlc_parsed_scope_entry_list_add(
 			&out->fEntryList,
-			inner);
+			inner,
+			parser->fArena);
 	}
 
 	rlc_parser_untrace(parser, &tracer);
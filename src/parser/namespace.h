@@ -30,15 +30,6 @@ void rlc_parsed_namespace_create(
 	struct RlcParsedNamespace * this,
 	struct RlcSrcString const * name);
 
-/** Destroys a namespace.
-@memberof RlcParsedNamespace
-
-@param[in,out] this:
-	The namespace to destroy.
-	@dassert @nonnull */
-void rlc_parsed_namespace_destroy(
-	struct RlcParsedNamespace * this);
-
 /** Parses a namespace.
 @param[out] out:
 	The namespace to parse.
@@ -30,14 +30,6 @@ void rlc_parsed_null_expression_create(
 	struct RlcParsedNullExpression * this,
 	struct RlcToken token);
 
-/** Destroys a `this` expression.
-@memberof RlcParsedNullExpression
-@param[in,out] this:
-	The `this` expression to destroy.
-	@dassert @nonnull */
-void rlc_parsed_null_expression_destroy(
-	struct RlcParsedNullExpression * this);
-
 /** Parses a `this` expression.
 @memberof RlcParsedNullExpression
 @param[out] out:
@@ -1,6 +1,5 @@
 #include "numberexpression.h"
 
-#include "../malloc.h"
 #include "../assert.h"
 #include "../scoper/number.h"
 
@@ -14,22 +13,12 @@ void rlc_parsed_number_expression_create(
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedNumberExpression,
-		*token,
-		*token);
+		token->content.start,
+		rlc_src_string_end(&token->content));
 
 	this->fNumberToken = *token;
 }
 
-void rlc_parsed_number_expression_destroy(
-	struct RlcParsedNumberExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(RLC_DERIVING_TYPE(RLC_BASE_CAST(this,RlcParsedExpression)) == kRlcParsedNumberExpression);
-
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedExpression));
-}
-
 int rlc_parsed_number_expression_parse(
 	struct RlcParsedNumberExpression * out,
 	struct RlcParser * parser)
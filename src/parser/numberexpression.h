@@ -34,14 +34,6 @@ void rlc_parsed_number_expression_create(
 	struct RlcParsedNumberExpression * this,
 	struct RlcToken const * token);
 
-/** Destroys a number expression.
-@memberof RlcParsedNumberExpression
-
-@param[in,out] this:
-	The number expression to destroy. */
-void rlc_parsed_number_expression_destroy(
-	struct RlcParsedNumberExpression * this);
-
 /** Parses a number expression.
 @memberof RlcParsedNumberExpression
 @param[out] out:
@@ -1,195 +1,251 @@
 #include "operatorexpression.h"
 
 #include "../assert.h"
+#include "../vector.h"
 #include "../malloc.h"
 
+#include <string.h>
+
 void rlc_parsed_operator_expression_create(
 	struct RlcParsedOperatorExpression * this,
-	struct RlcToken first,
-	struct RlcToken last)
+	RlcSrcIndex start,
+	RlcSrcIndex end)
 {
 	RLC_DASSERT(this != NULL);
 
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this,RlcParsedExpression),
 		kRlcParsedOperatorExpression,
-		first,
-		last);
+		start,
+		end);
 
 	this->fExpressions = NULL;
 	this->fExpressionCount = 0;
 }
 
-void rlc_parsed_operator_expression_destroy(
-	struct RlcParsedOperatorExpression * this)
+enum OperatorType { kUnary, kBinary, kNary = kBinary };
+
+/** How tightly binary operators bind. Higher precedences bind tighter. */
+enum Precedence
 {
-	RLC_DASSERT(this != NULL);
+	/** Marks tokens that are no binary operators. */
+	kPrecedenceNone,
+	/** The `else` part of a `?:` expression, which extends as far as possible. */
+	kPrecedenceElse,
+	kPrecedenceAssign,
+	kPrecedenceStreamFeed,
+	kPrecedenceConditional,
+	kPrecedenceLogOr,
+	kPrecedenceLogAnd,
+	kPrecedenceCompare,
+	kPrecedenceBitOr,
+	kPrecedenceBitXor,
+	kPrecedenceBitAnd,
+	kPrecedenceShift,
+	kPrecedenceAdd,
+	kPrecedenceMul,
+	kPrecedenceBind,
+	/** Operands that are no binary expressions. */
+	kPrecedencePrefix
+};
 
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this,RlcParsedExpression));
+/** How chains of operators with equal precedence are grouped. */
+enum Associativity
+{
+	/** `a+b+c` is `a+(b+c)`. */
+	kRightAssociative,
+	/** `a.*b.*c` is not an expression, parsing ends before the second operator. */
+	kNonAssociative
+};
 
-	for(size_t i = 0; i < this->fExpressionCount; i++)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fExpressions[i]);
-		rlc_free((void**)&this->fExpressions[i]);
-	}
+/** A prefix or postfix operator. */
+struct UnaryOperator
+{
+	/** Whether the token is an operator. */
+	int fIsOperator;
+	/** The operator, if any. */
+	enum RlcOperator fOp;
+};
 
-	if(this->fExpressions)
-	{
-		rlc_free((void**)&this->fExpressions);
-	}
-	this->fExpressionCount = 0;
-}
+#define UNARY(tok, op) [tok] = { 1, op }
+
+// prefix operators, indexed by token type.
+static struct UnaryOperator const k_unary[RLC_COUNT(RlcTokenType)] = {
+	UNARY(kRlcTokMinus, kNeg),
+	UNARY(kRlcTokPlus, kPos),
+	UNARY(kRlcTokTilde, kBitNot),
+	UNARY(kRlcTokExclamationMark, kLogNot),
+	UNARY(kRlcTokAnd, kAddress),
+	UNARY(kRlcTokDoubleAnd, kMove),
+	UNARY(kRlcTokAsterisk, kDereference),
+	UNARY(kRlcTokDoublePlus, kPreIncrement),
+	UNARY(kRlcTokDoubleMinus, kPreDecrement),
+	UNARY(kRlcTokDoubleDotExclamationMark, kExpectDynamic),
+	UNARY(kRlcTokDoubleDotQuestionMark, kMaybeDynamic),
+	UNARY(kRlcTokAt, kAsync),
+	UNARY(kRlcTokDoubleAt, kFullAsync),
+	UNARY(kRlcTokLessMinus, kAwait),
+	UNARY(kRlcTokDoubleHash, kCount),
+	UNARY(kRlcTokTripleAnd, kRealAddr)
+},
+// postfix operators, indexed by token type.
+k_unary_postfix[RLC_COUNT(RlcTokenType)] = {
+	UNARY(kRlcTokDoublePlus, kPostIncrement),
+	UNARY(kRlcTokDoubleMinus, kPostDecrement),
+	UNARY(kRlcTokTripleDot, kVariadicExpand)
+};
 
-enum OperatorType { kUnary, kBinary, kNary = kBinary };
+#undef UNARY
 
-static struct {
-	enum RlcTokenType fTok;
+/** A binary operator. */
+struct BinaryOperator
+{
+	/** The operator. */
 	enum RlcOperator fOp;
-}
-// prefix operators.
-const k_unary[] = {
-	{ kRlcTokMinus, kNeg },
-	{ kRlcTokPlus, kPos },
-	{ kRlcTokTilde, kBitNot },
-	{ kRlcTokExclamationMark, kLogNot },
-	{ kRlcTokAnd, kAddress },
-	{ kRlcTokDoubleAnd, kMove },
-	{ kRlcTokAsterisk, kDereference },
-	{ kRlcTokDoublePlus, kPreIncrement },
-	{ kRlcTokDoubleMinus, kPreDecrement },
-	{ kRlcTokDoubleDotExclamationMark, kExpectDynamic },
-	{ kRlcTokDoubleDotQuestionMark, kMaybeDynamic },
-	{ kRlcTokAt, kAsync },
-	{ kRlcTokDoubleAt, kFullAsync },
-	{ kRlcTokLessMinus, kAwait },
-	{ kRlcTokDoubleHash, kCount },
-	{ kRlcTokTripleAnd, kRealAddr }
-},
-// postfix operators.
-k_unary_postfix[] = {
-	{ kRlcTokDoublePlus, kPostIncrement },
-	{ kRlcTokDoubleMinus, kPostDecrement },
-	{ kRlcTokTripleDot, kVariadicExpand }
-},
-// binary operators.
-k_binary[] = {
+	/** The operator's precedence, or `kPrecedenceNone` if the token is no binary operator. */
+	enum Precedence fPrecedence;
+	/** The operator's associativity. */
+	enum Associativity fAssociativity;
+};
+
+#define BINARY(tok, op, prec) [tok] = { op, kPrecedence##prec, kRightAssociative }
+
+// binary operators, indexed by token type.
+static struct BinaryOperator const k_binary[RLC_COUNT(RlcTokenType)] = {
 	// bind operators.
-	{ kRlcTokDotAsterisk, kBindReference },
-	{ kRlcTokMinusGreaterAsterisk, kBindPointer },
+	[kRlcTokDotAsterisk] = { kBindReference, kPrecedenceBind, kNonAssociative },
+	[kRlcTokMinusGreaterAsterisk] = { kBindPointer, kPrecedenceBind, kNonAssociative },
 
 	// multiplicative operators.
-	{ kRlcTokPercent, kMod },
-	{ kRlcTokForwardSlash, kDiv },
-	{ kRlcTokAsterisk, kMul },
+	BINARY(kRlcTokPercent, kMod, Mul),
+	BINARY(kRlcTokForwardSlash, kDiv, Mul),
+	BINARY(kRlcTokAsterisk, kMul, Mul),
 
 	// additive operators.
-	{ kRlcTokMinus, kSub },
-	{ kRlcTokPlus, kAdd },
+	BINARY(kRlcTokMinus, kSub, Add),
+	BINARY(kRlcTokPlus, kAdd, Add),
 
 	// bit shift operators.
-	{ kRlcTokDoubleLess, kShiftLeft },
-	{ kRlcTokDoubleGreater, kShiftRight },
-	{ kRlcTokTripleLess, kRotateLeft },
-	{ kRlcTokTripleGreater, kRotateRight },
+	BINARY(kRlcTokDoubleLess, kShiftLeft, Shift),
+	BINARY(kRlcTokDoubleGreater, kShiftRight, Shift),
+	BINARY(kRlcTokTripleLess, kRotateLeft, Shift),
+	BINARY(kRlcTokTripleGreater, kRotateRight, Shift),
 
 	// bit arithmetic operators.
-	{ kRlcTokAnd, kBitAnd },
-	{ kRlcTokCircumflex, kBitXor },
-	{ kRlcTokPipe, kBitOr },
+	BINARY(kRlcTokAnd, kBitAnd, BitAnd),
+	BINARY(kRlcTokCircumflex, kBitXor, BitXor),
+	BINARY(kRlcTokPipe, kBitOr, BitOr),
 
 	// numeric comparisons.
-	{ kRlcTokLess, kLess },
-	{ kRlcTokLessEqual, kLessEquals },
-	{ kRlcTokGreater, kGreater },
-	{ kRlcTokGreaterEqual, kGreaterEquals },
-	{ kRlcTokDoubleEqual, kEquals },
-	{ kRlcTokExclamationMarkEqual, kNotEquals },
+	BINARY(kRlcTokLess, kLess, Compare),
+	BINARY(kRlcTokLessEqual, kLessEquals, Compare),
+	BINARY(kRlcTokGreater, kGreater, Compare),
+	BINARY(kRlcTokGreaterEqual, kGreaterEquals, Compare),
+	BINARY(kRlcTokDoubleEqual, kEquals, Compare),
+	BINARY(kRlcTokExclamationMarkEqual, kNotEquals, Compare),
 
 	// boolean arithmetic.
-	{ kRlcTokDoubleAnd, kLogAnd },
-	{ kRlcTokDoublePipe, kLogOr },
+	BINARY(kRlcTokDoubleAnd, kLogAnd, LogAnd),
+	BINARY(kRlcTokDoublePipe, kLogOr, LogOr),
+
+	// conditional operator, parsed separately.
+	BINARY(kRlcTokQuestionMark, kConditional, Conditional),
 
 	// stream feed operator.
-	{ kRlcTokLessMinus, kStreamFeed },
+	BINARY(kRlcTokLessMinus, kStreamFeed, StreamFeed),
 
 	// assignments.
-	{ kRlcTokColonEqual, kAssign },
-	{ kRlcTokPlusEqual, kAddAssign },
-	{ kRlcTokMinusEqual, kSubAssign },
-	{ kRlcTokAsteriskEqual, kMulAssign },
-	{ kRlcTokForwardSlashEqual, kDivAssign },
-	{ kRlcTokPercentEqual, kModAssign },
-	{ kRlcTokAndEqual, kBitAndAssign },
-	{ kRlcTokPipeEqual, kBitOrAssign },
-	{ kRlcTokCircumflexEqual, kBitXorAssign },
-	{ kRlcTokDoubleLessEqual, kShiftLeftAssign },
-	{ kRlcTokDoubleGreaterEqual, kShiftRightAssign }
+	BINARY(kRlcTokColonEqual, kAssign, Assign),
+	BINARY(kRlcTokPlusEqual, kAddAssign, Assign),
+	BINARY(kRlcTokMinusEqual, kSubAssign, Assign),
+	BINARY(kRlcTokAsteriskEqual, kMulAssign, Assign),
+	BINARY(kRlcTokForwardSlashEqual, kDivAssign, Assign),
+	BINARY(kRlcTokPercentEqual, kModAssign, Assign),
+	BINARY(kRlcTokAndEqual, kBitAndAssign, Assign),
+	BINARY(kRlcTokPipeEqual, kBitOrAssign, Assign),
+	BINARY(kRlcTokCircumflexEqual, kBitXorAssign, Assign),
+	BINARY(kRlcTokDoubleLessEqual, kShiftLeftAssign, Assign),
+	BINARY(kRlcTokDoubleGreaterEqual, kShiftRightAssign, Assign)
 };
 
-static size_t const k_binary_groups[] = {
-	2, // .* ->*
-	3, // % / *
-	2, // + -
-	4, // << >> <<< >>>
-	1, // &
-	1, // ^
-	1, // |
-	6, // < <= > >= == !=
-	1, // &&
-	1, // ||
-	0, // ?:
-	1, // <-
-	11 // :=
-};
+#undef BINARY
+
+/** Consumes the current token if it is a prefix or postfix operator.
+@param[in] table:
+	`k_unary` or `k_unary_postfix`.
+@param[out] token:
+	The operator's token. */
+static int consume_unary(
+	struct RlcParser * parser,
+	struct UnaryOperator const * table,
+	enum RlcOperator * op,
+	struct RlcToken * token)
+{
+	if(rlc_parser_eof(parser))
+		return 0;
+
+	struct RlcToken const current = rlc_parser_current(parser);
+	if(!table[current.type].fIsOperator)
+		return 0;
+
+	*op = table[current.type].fOp;
+	if(token)
+		*token = current;
+	rlc_parser_skip(parser);
+	return 1;
+}
+
+/** Looks up the current token as binary operator, without consuming it.
+@return
+	The operator, or null if the current token is no binary operator. */
+static struct BinaryOperator const * peek_binary(
+	struct RlcParser * parser)
+{
+	if(rlc_parser_eof(parser))
+		return NULL;
+
+	struct BinaryOperator const * binary = &k_binary[rlc_parser_current(parser).type];
+	return binary->fPrecedence != kPrecedenceNone ? binary : NULL;
+}
 
 int rlc_operator_parse_unary_prefix(
 	enum RlcOperator * op,
 	struct RlcParser * parser)
 {
-	for(unsigned i = 0; i < _countof(k_unary); i++)
-		if(rlc_parser_consume(parser, NULL, k_unary[i].fTok))
-		{
-			*op = k_unary[i].fOp;
-			return 1;
-		}
-	return 0;
+	return consume_unary(parser, k_unary, op, NULL);
 }
 int rlc_operator_parse_unary_postfix(
 	enum RlcOperator * op,
 	struct RlcParser * parser)
 {
-	for(unsigned i = 0; i < _countof(k_unary_postfix); i++)
-		if(rlc_parser_consume(parser, NULL, k_unary_postfix[i].fTok))
-		{
-			*op = k_unary_postfix[i].fOp;
-			return 1;
-		}
-	return 0;
+	return consume_unary(parser, k_unary_postfix, op, NULL);
 }
 int rlc_operator_parse_binary(
 	enum RlcOperator * op,
 	struct RlcParser * parser)
 {
-	for(unsigned i = 0; i < _countof(k_binary); i++)
-		if(rlc_parser_consume(parser, NULL, k_binary[i].fTok))
-		{
-			*op = k_binary[i].fOp;
-			return 1;
-		}
-	return 0;
+	struct BinaryOperator const * binary = peek_binary(parser);
+	// `?:` is no plain binary operator.
+	if(!binary || binary->fOp == kConditional)
+		return 0;
+
+	*op = binary->fOp;
+	rlc_parser_skip(parser);
+	return 1;
 }
 
 struct RlcParsedOperatorExpression * make_operator_expression(
 	enum RlcOperator type,
-	struct RlcToken first,
-	struct RlcToken last)
+	RlcSrcIndex start,
+	RlcSrcIndex end,
+	struct RlcArena * arena)
 {
 	struct RlcParsedOperatorExpression * out = NULL;
-	rlc_malloc(
+	rlc_arena_malloc(
+		arena,
 		(void**)&out,
 		sizeof(struct RlcParsedOperatorExpression));
-	rlc_parsed_operator_expression_create(out, first, last);
+	rlc_parsed_operator_expression_create(out, start, end);
 	out->fOperator = type;
 
 	return out;
@@ -198,35 +254,19 @@ struct RlcParsedOperatorExpression * make_operator_expression(
 static struct RlcParsedOperatorExpression * make_binary_expression(
 	enum RlcOperator type,
 	struct RlcParsedExpression * lhs,
-	struct RlcParsedExpression * rhs)
+	struct RlcParsedExpression * rhs,
+	struct RlcArena * arena)
 {
-	if(!lhs)
-	{
-		if(rhs)
-		{
-			rlc_parsed_expression_destroy_virtual(rhs);
-			rlc_free((void**)&rhs);
-		}
-
-		return NULL;
-	}
-	else if(!rhs)
-	{
-		if(lhs)
-		{
-			rlc_parsed_expression_destroy_virtual(lhs);
-			rlc_free((void**)&lhs);
-		}
-
+	if(!lhs || !rhs)
 		return NULL;
-	}
 
 	struct RlcParsedOperatorExpression * out = make_operator_expression(
 		type,
 		lhs->fStart,
-		rhs->fEnd);
-	rlc_parsed_operator_expression_add(out, lhs);
-	rlc_parsed_operator_expression_add(out, rhs);
+		rhs->fEnd,
+		arena);
+	rlc_parsed_operator_expression_add(out, lhs, arena);
+	rlc_parsed_operator_expression_add(out, rhs, arena);
 
 	return out;
 }
@@ -234,15 +274,16 @@ static struct RlcParsedOperatorExpression * make_binary_expression(
 static struct RlcParsedOperatorExpression * make_unary_expression(
 	enum RlcOperator type,
 	struct RlcParsedExpression * operand,
-	struct RlcToken first,
-	struct RlcToken last)
+	RlcSrcIndex start,
+	RlcSrcIndex end,
+	struct RlcArena * arena)
 {
 	if(!operand)
 		return NULL;
 
 	struct RlcParsedOperatorExpression * out =
-		make_operator_expression(type, first, last);
-	rlc_parsed_operator_expression_add(out, operand);
+		make_operator_expression(type, start, end, arena);
+	rlc_parsed_operator_expression_add(out, operand, arena);
 
 	return out;
 }
@@ -266,29 +307,21 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 	for(int postfix = 1; postfix--;)
 	{
 		{
-			int found = 0;
+			enum RlcOperator op;
 			struct RlcToken token;
-			for(size_t i = _countof(k_unary_postfix); i--;)
-				if(rlc_parser_consume(
-					parser,
-					&token,
-					k_unary_postfix[i].fTok))
-				{
-					struct RlcParsedOperatorExpression * temp =
-						make_unary_expression(
-							k_unary_postfix[i].fOp,
-							out,
-							out->fStart,
-							token);
-					out = RLC_BASE_CAST(
-						temp,
-						RlcParsedExpression);
-
-					found = 1;
-					break;
-				}
-			if(found)
+			if(consume_unary(parser, k_unary_postfix, &op, &token))
 			{
+				struct RlcParsedOperatorExpression * temp =
+					make_unary_expression(
+						op,
+						out,
+						out->fStart,
+						rlc_src_string_end(&token.content),
+						parser->fArena);
+				out = RLC_BASE_CAST(
+					temp,
+					RlcParsedExpression);
+
 				++postfix;
 				continue;
 			}
@@ -305,7 +338,8 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 					out,
 					rlc_parsed_expression_parse(
 						parser,
-						RLC_ALL_FLAGS(RlcParsedExpressionType)));
+						RLC_ALL_FLAGS(RlcParsedExpressionType)),
+					parser->fArena);
 			// index expression.
 			if(!(out = RLC_BASE_CAST(
 				binary,
@@ -314,11 +348,13 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 				rlc_parser_fail(parser, "expected an expression");
 			}
 
+			struct RlcToken end;
 			rlc_parser_expect(
 				parser,
-				&out->fEnd,
+				&end,
 				1,
 				kRlcTokBracketClose);
+			out->fEnd = rlc_src_string_end(&end.content);
 
 			++postfix;
 			continue;
@@ -334,14 +370,16 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 					kCall,
 					out,
 					out->fStart,
-					out->fStart);
+					out->fEnd,
+					parser->fArena);
 
 			out = RLC_BASE_CAST(temp, RlcParsedExpression);
 
 			int arguments = 0;
+			struct RlcToken end;
 			while(!rlc_parser_consume(
 				parser,
-				&out->fEnd,
+				&end,
 				kRlcTokParentheseClose))
 			{
 				// parse comma, if necessary.
@@ -365,8 +403,10 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 						out,
 						RlcParsedExpression,
 						struct RlcParsedOperatorExpression),
-					arg);
+					arg,
+					parser->fArena);
 			}
+			out->fEnd = rlc_src_string_end(&end.content);
 
 			++postfix;
 			continue;
@@ -402,7 +442,8 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 								k_ops[i].fCtorOperator,
 								out,
 								out->fStart,
-								out->fEnd);
+								out->fEnd,
+								parser->fArena);
 
 						if(!rlc_parser_consume(parser, &end, kRlcTokBraceClose))
 						{
@@ -414,11 +455,12 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 										RLC_ALL_FLAGS(RlcParsedExpressionType));
 								if(!exp)
 									rlc_parser_fail(parser, "expected expression");
-								rlc_parsed_operator_expression_add(temp, exp);
+								rlc_parsed_operator_expression_add(temp, exp, parser->fArena);
 							} while(rlc_parser_consume(parser, NULL, kRlcTokComma));
 							rlc_parser_expect(parser, &end, 1, kRlcTokBraceClose);
 						}
-						RLC_BASE_CAST(temp, RlcParsedExpression)->fEnd = end;
+						RLC_BASE_CAST(temp, RlcParsedExpression)->fEnd =
+							rlc_src_string_end(&end.content);
 					} else if(rlc_parser_consume(parser, NULL, kRlcTokParentheseOpen))
 					{
 						struct RlcToken end;
@@ -426,7 +468,8 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 							k_ops[i].fTupleOperator,
 							out,
 							out->fStart,
-							out->fEnd);
+							out->fEnd,
+							parser->fArena);
 
 						struct RlcParsedExpression * exp =
 							rlc_parsed_expression_parse(
@@ -434,16 +477,18 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 								RLC_ALL_FLAGS(RlcParsedExpressionType));
 						if(!exp)
 							rlc_parser_fail(parser, "expected expression");
-						rlc_parsed_operator_expression_add(temp, exp);
+						rlc_parsed_operator_expression_add(temp, exp, parser->fArena);
 						rlc_parser_expect(parser, &end, 1, kRlcTokParentheseClose);
-						RLC_BASE_CAST(temp, RlcParsedExpression)->fEnd = end;
+						RLC_BASE_CAST(temp, RlcParsedExpression)->fEnd =
+							rlc_src_string_end(&end.content);
 					} else if(rlc_parser_consume(parser, &dtor_token, kRlcTokTilde))
 					{
 						temp = make_unary_expression(
 							k_ops[i].fDtorOperator,
 							out,
 							out->fStart,
-							dtor_token);
+							rlc_src_string_end(&dtor_token.content),
+							parser->fArena);
 					} else
 					{
 						temp = make_binary_expression(
@@ -451,7 +496,8 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 							out,
 							rlc_parsed_expression_parse(
 								parser,
-								RLC_FLAG(kRlcParsedSymbolChildExpression)));
+								RLC_FLAG(kRlcParsedSymbolChildExpression)),
+							parser->fArena);
 					}
 
 					if(!(out = RLC_BASE_CAST(temp, RlcParsedExpression)))
@@ -469,77 +515,198 @@ static _Nodiscard struct RlcParsedExpression * parse_postfix(
 	return out;
 }
 
-static struct RlcParsedExpression * parse_prefix(
-	struct RlcParser * parser)
+/** An operator whose right-hand operand is still being parsed. */
+struct PendingOperator
+{
+	/** The left-hand operand. For `kPrecedenceElse`, the conditional expression that lacks its `else` part. Null for prefix operators. */
+	struct RlcParsedExpression * fLhs;
+	/** The operator. Prefix operators have `kPrecedencePrefix`, so that they are applied before any binary operator. */
+	struct BinaryOperator fOperator;
+	/** The start of a prefix operator. */
+	RlcSrcIndex fStart;
+	/** Whether the prefix operator set the parser's context. */
+	int fTraced;
+};
+
+/** The operators whose right-hand operand is being parsed, from the loosest to the tightest binding one. Long operator chains and prefix sequences grow this stack instead of the call stack. */
+struct PendingStack
+{
+	struct PendingOperator * fData;
+	size_t fCount;
+	size_t fCapacity;
+	/** The context of the asynchronous call whose operand is being parsed. */
+	struct RlcParserTracer fTrace;
+	/** Whether `fTrace` is the parser's current context. */
+	int fTracing;
+};
+
+/** The `else` part of a conditional expression, parsed like a right-hand operand. */
+static struct BinaryOperator const k_else = { kConditional, kPrecedenceElse, kRightAssociative };
+
+/** Pushes an operator whose right-hand operand is parsed next. */
+static void push_pending(
+	struct RlcParser * parser,
+	struct PendingStack * stack,
+	struct PendingOperator operator)
+{
+	if(stack->fCount == stack->fCapacity)
+	{
+		// Grown in the file's arena, as syntax errors jump out of the parse without freeing anything.
+		struct PendingOperator * grown = NULL;
+		rlc_arena_malloc(
+			parser->fArena,
+			(void**)&grown,
+			2 * stack->fCapacity * sizeof(struct PendingOperator));
+		memcpy(grown, stack->fData, stack->fCount * sizeof(struct PendingOperator));
+		stack->fData = grown;
+		stack->fCapacity *= 2;
+	}
+	stack->fData[stack->fCount++] = operator;
+}
+
+/** Parses an operand, and pushes its prefix operators.
+@return
+	The operand without its prefix operators, or null if there is no operand. */
+static struct RlcParsedExpression * parse_operand(
+	struct RlcParser * parser,
+	struct PendingStack * stack)
 {
 	RLC_DASSERT(parser != NULL);
 
+	enum RlcOperator prefix;
 	struct RlcToken start;
-	for(size_t i = _countof(k_unary); i--;)
+	int prefixed = 0;
+	while(consume_unary(parser, k_unary, &prefix, &start))
 	{
-		if(rlc_parser_consume(
-			parser,
-			&start,
-			k_unary[i].fTok))
+		int traced = 0;
+		if((prefix == kAsync || prefix == kFullAsync) && !stack->fTracing)
 		{
-			int isAsync = k_unary[i].fOp == kAsync || k_unary[i].fOp == kFullAsync;
-			struct RlcParserTracer trace;
-			if(isAsync)
-				rlc_parser_trace(parser, "asynchronous call", &trace);
+			rlc_parser_trace(parser, "asynchronous call", &stack->fTrace);
+			stack->fTracing = traced = 1;
+		}
 
-			struct RlcParsedExpression * operand = parse_prefix(parser);
+		push_pending(parser, stack, (struct PendingOperator){
+			NULL,
+			{ prefix, kPrecedencePrefix, kRightAssociative },
+			start.content.start,
+			traced
+		});
+		prefixed = 1;
+	}
 
-			if(k_unary[i].fOp == kAsync || k_unary[i].fOp == kFullAsync)
-			{
-				struct RlcParsedOperatorExpression * op;
-				if((op = RLC_DYNAMIC_CAST(operand, RlcParsedExpression, RlcParsedOperatorExpression)))
-				{
-					if(op->fOperator != kCall)
-						rlc_parser_fail(parser, "expected call expression");
-					rlc_parser_untrace(parser, &trace);
-					op->fOperator = k_unary[i].fOp;
-					return operand;
-				}
-			}
+	struct RlcParsedExpression * operand = parse_postfix(parser);
+	if(!operand && prefixed)
+		rlc_parser_fail(parser, "expected expression");
+	return operand;
+}
 
-			struct RlcParsedOperatorExpression * unary = NULL;
-			if(!(unary = make_unary_expression(
-					k_unary[i].fOp,
-					operand,
-					start,
-					operand->fEnd)))
-			{
-				rlc_parser_fail(parser, "expected expression");
-			}
+/** Applies a prefix operator to its operand. Asynchronous prefixes turn call expressions into asynchronous calls. */
+static struct RlcParsedExpression * reduce_prefix(
+	struct RlcParser * parser,
+	struct PendingStack * stack,
+	struct PendingOperator const * pending,
+	struct RlcParsedExpression * operand)
+{
+	enum RlcOperator const prefix = pending->fOperator.fOp;
+	if(prefix == kAsync || prefix == kFullAsync)
+	{
+		struct RlcParsedOperatorExpression * op;
+		if((op = RLC_DYNAMIC_CAST(operand, RlcParsedExpression, RlcParsedOperatorExpression))
+		&& op->fOperator != kCall)
+			rlc_parser_fail(parser, "expected call expression");
+
+		if(pending->fTraced)
+		{
+			rlc_parser_untrace(parser, &stack->fTrace);
+			stack->fTracing = 0;
+		}
 
-			return RLC_BASE_CAST(unary, RlcParsedExpression);
+		if(op)
+		{
+			op->fOperator = prefix;
+			return operand;
 		}
 	}
 
-	// no prefixes?
-	return parse_postfix(parser);
+	return RLC_BASE_CAST(
+		make_unary_expression(
+			prefix,
+			operand,
+			pending->fStart,
+			operand->fEnd,
+			parser->fArena),
+		RlcParsedExpression);
 }
 
-static struct RlcParsedExpression * parse_binary(
+/** Applies the innermost pending operator to its right-hand operand, and pops it. */
+static struct RlcParsedExpression * reduce(
 	struct RlcParser * parser,
-	size_t group)
+	struct PendingStack * stack,
+	struct RlcParsedExpression * rhs)
+{
+	struct PendingOperator const * pending = &stack->fData[--stack->fCount];
+	switch(pending->fOperator.fPrecedence)
+	{
+	case kPrecedencePrefix:
+		return reduce_prefix(parser, stack, pending, rhs);
+	case kPrecedenceElse:
+		rlc_parsed_operator_expression_add(
+			RLC_DERIVE_CAST(
+				pending->fLhs,
+				RlcParsedExpression,
+				struct RlcParsedOperatorExpression),
+			rhs,
+			parser->fArena);
+		return pending->fLhs;
+	default:
+		return RLC_BASE_CAST(
+			make_binary_expression(
+				pending->fOperator.fOp,
+				pending->fLhs,
+				rhs,
+				parser->fArena),
+			RlcParsedExpression);
+	}
+}
+
+struct RlcParsedExpression * rlc_parsed_operator_expression_parse(
+	struct RlcParser * parser)
 {
 	RLC_DASSERT(parser != NULL);
 
-	struct RlcParsedExpression * lhs = group
-		? parse_binary(parser, group-1)
-		: parse_prefix(parser);
+	struct PendingOperator local[32];
+	struct PendingStack stack;
+	stack.fData = local;
+	stack.fCount = 0;
+	stack.fCapacity = _countof(local);
+	stack.fTracing = 0;
 
-	if(!lhs)
+	struct RlcParsedExpression * rhs = parse_operand(parser, &stack);
+	if(!rhs)
 		return NULL;
 
-	// Special ?: group?
-	if(k_binary_groups[group] == 0)
+	// The precedence of the operator that produced `rhs`.
+	enum Precedence precedence = kPrecedencePrefix;
+
+	for(struct BinaryOperator const * binary; (binary = peek_binary(parser));)
 	{
-		if(rlc_parser_consume(
-			parser,
-			NULL,
-			kRlcTokQuestionMark))
+		// Apply the pending operators that bind tighter, which includes all prefix operators.
+		while(stack.fCount
+		&& (stack.fData[stack.fCount-1].fOperator.fPrecedence > binary->fPrecedence
+			|| (stack.fData[stack.fCount-1].fOperator.fPrecedence == binary->fPrecedence
+				&& binary->fAssociativity == kNonAssociative)))
+		{
+			precedence = stack.fData[stack.fCount-1].fOperator.fPrecedence;
+			rhs = reduce(parser, &stack, rhs);
+		}
+
+		// An operand that already has an operator of the same or looser binding ends the expression.
+		if(precedence <= binary->fPrecedence)
+			break;
+
+		rlc_parser_skip(parser);
+
+		if(binary->fOp == kConditional)
 		{
 			struct RlcParsedExpression * then = rlc_parsed_operator_expression_parse(parser);
 			if(!then)
@@ -553,77 +720,39 @@ static struct RlcParsedExpression * parse_binary(
 				1,
 				kRlcTokColon);
 
-			struct RlcParsedExpression * other = rlc_parsed_operator_expression_parse(parser);
-			if(!other)
-			{
-				rlc_parser_fail(parser, "expected expression");
-			}
-
-			struct RlcParsedOperatorExpression * cond = make_binary_expression(
-				kConditional,
-				lhs,
-				then);
-			rlc_parsed_operator_expression_add(cond, other);
-
-			return RLC_BASE_CAST(cond, RlcParsedExpression);
-		}
-	}
-
-	size_t start = 0;
-	for(size_t i = 0; i < group; i++)
-		start += k_binary_groups[i];
-
-	for(size_t i = start + k_binary_groups[group]; i-->start;)
-	{
-		if(rlc_parser_consume(
-			parser,
-			NULL,
-			k_binary[i].fTok))
-		{
-			struct RlcParsedOperatorExpression * op =
+			rhs = RLC_BASE_CAST(
 				make_binary_expression(
-					k_binary[i].fOp,
-					lhs,
-					group
-						? parse_binary(parser, group)
-						: parse_prefix(parser));
-			if(!op)
-				rlc_parser_fail(parser, "expected expression");
-			return RLC_BASE_CAST(op, RlcParsedExpression);
+					kConditional,
+					rhs,
+					then,
+					parser->fArena),
+				RlcParsedExpression);
+			binary = &k_else;
 		}
-	}
-
-	return lhs;
-}
 
-struct RlcParsedExpression * rlc_parsed_operator_expression_parse(
-	struct RlcParser * parser)
-{
-	RLC_DASSERT(parser != NULL);
-
-	// parse the expression.
-	struct RlcParsedExpression * left = parse_binary(parser, _countof(k_binary_groups)-1);
+		push_pending(parser, &stack, (struct PendingOperator){ rhs, *binary, 0, 0 });
 
-	if(!left)
-	{
-		return NULL;
+		if(!(rhs = parse_operand(parser, &stack)))
+			rlc_parser_fail(parser, "expected expression");
+		precedence = kPrecedencePrefix;
 	}
 
-	return left;
+	while(stack.fCount)
+		rhs = reduce(parser, &stack, rhs);
+
+	return rhs;
 }
 
 void rlc_parsed_operator_expression_add(
 	struct RlcParsedOperatorExpression * this,
-	struct RlcParsedExpression * expression)
+	struct RlcParsedExpression * expression,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(expression != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fExpressions,
-		sizeof(struct RlcParsedExpression*) * ++this->fExpressionCount);
-
-	this->fExpressions[this->fExpressionCount-1] = expression;
+	RLC_VECTOR_PUSH(arena, this->fExpressions, this->fExpressionCount) = expression;
 	RLC_BASE_CAST(this, RlcParsedExpression)->fEnd = expression->fEnd;
 }
 
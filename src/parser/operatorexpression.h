@@ -64,7 +64,8 @@ struct RlcParsedOperatorExpression
 
 	/** The expression's operator. */
 	enum RlcOperator fOperator;
-	/** The expression list. */
+	/** The operands.
+		The array is allocated in the file's arena next to the expression and its operands, so walking a tree stays within a small region of memory. */
 	struct RlcParsedExpression ** fExpressions;
 	/** The expression count. */
 	size_t fExpressionCount;
@@ -75,20 +76,14 @@ struct RlcParsedOperatorExpression
 @param[out] this:
 	The operator expression to create.
 	@dassert @nonnull
-@param[in] first:
-	The first token of the expression. */
+@param[in] start:
+	The source index of the expression's first character.
+@param[in] end:
+	The source index behind the expression's last character. */
 void rlc_parsed_operator_expression_create(
 	struct RlcParsedOperatorExpression * this,
-	struct RlcToken first,
-	struct RlcToken last);
-
-/** Destroys an operator expression.
-@memberof RlcParsedOperatorExpression
-@param[out] this:
-	The operator expression to destroy.
-	@dassert @nonnull */
-void rlc_parsed_operator_expression_destroy(
-	struct RlcParsedOperatorExpression * this);
+	RlcSrcIndex start,
+	RlcSrcIndex end);
 
 /** Parses an operator expression.
 @memberof RlcParsedOperatorExpression
@@ -102,8 +97,9 @@ _Nodiscard struct RlcParsedExpression * rlc_parsed_operator_expression_parse(
 
 struct RlcParsedOperatorExpression * make_operator_expression(
 	enum RlcOperator type,
-	struct RlcToken first,
-	struct RlcToken last);
+	RlcSrcIndex start,
+	RlcSrcIndex end,
+	struct RlcArena * arena);
 
 /** Adds an expression to an operator expression's list.
 @memberof RlcParsedOperatorExpression
@@ -113,10 +109,14 @@ struct RlcParsedOperatorExpression * make_operator_expression(
 @param[in] expression:
 	The expression to add.
 	@pass_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_operator_expression_add(
 	struct RlcParsedOperatorExpression * this,
-	struct RlcParsedExpression * expression);
+	struct RlcParsedExpression * expression,
+	struct RlcArena * arena);
 
 void rlc_parsed_operator_expression_print(
 	struct RlcParsedOperatorExpression const * this,
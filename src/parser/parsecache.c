@@ -0,0 +1,1442 @@
+#include "parsecache.h"
+#include "file.h"
+
+#include "class.h"
+#include "mask.h"
+#include "rawtype.h"
+#include "union.h"
+#include "namespace.h"
+#include "function.h"
+#include "variable.h"
+#include "enum.h"
+#include "typedef.h"
+#include "externalsymbol.h"
+#include "test.h"
+#include "constructor.h"
+#include "destructor.h"
+
+#include "assertstatement.h"
+#include "expressionstatement.h"
+#include "blockstatement.h"
+#include "ifstatement.h"
+#include "loopstatement.h"
+#include "variablestatement.h"
+#include "returnstatement.h"
+#include "switchstatement.h"
+#include "casestatement.h"
+#include "trystatement.h"
+#include "throwstatement.h"
+#include "breakstatement.h"
+#include "continuestatement.h"
+
+#include "symbolexpression.h"
+#include "symbolchildexpression.h"
+#include "stringexpression.h"
+#include "operatorexpression.h"
+#include "castexpression.h"
+#include "sizeofexpression.h"
+#include "symbolconstantexpression.h"
+#include "numberexpression.h"
+#include "characterexpression.h"
+#include "thisexpression.h"
+#include "nullexpression.h"
+
+#include "../assert.h"
+#include "../malloc.h"
+#include "../vector.h"
+#include "../hashmap.h"
+#include "../sha256.h"
+#include "../src/identifier.h"
+
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/** The layout version of cache entries. Must be changed whenever the syntax tree's types change. */
+#define kFormatVersion ((uint64_t)3)
+
+/** The start of a cache entry.
+	It is followed by the image at `k_image_offset`, the relocation table, the name table, and the symbol constant table. */
+struct RlcParseCacheHeader
+{
+	/** Identifies cache entries. */
+	char fMagic[8];
+	/** The compiler version that wrote the entry. */
+	uint64_t fVersion;
+	/** The SHA-256 digest of the source file's contents. */
+	uint8_t fContentDigest[kRlcSha256Size];
+	/** The source file's length. */
+	uint64_t fContentLength;
+	/** The size of the image, a multiple of the arena's alignment. */
+	uint64_t fImageSize;
+	/** The number of 32-bit image offsets of pointers. */
+	uint64_t fRelocationCount;
+	/** The number of 32-bit image offsets of identifiers, whose IDs are only valid in the compiler that interned them. */
+	uint64_t fNameCount;
+	/** The number of symbol constants the file registers. */
+	uint64_t fConstantCount;
+	/** The image offset of the include statements, or `k_null`. */
+	uint64_t fIncludes;
+	uint64_t fIncludeCount;
+	/** The image offset of the scope entries, or `k_null`. */
+	uint64_t fEntries;
+	uint64_t fEntryCount;
+};
+
+static char const k_magic[8] = { 'r', 'l', 'c', 'p', 'a', 'r', 's', 'e' };
+/** Marks null root pointers. */
+static uint64_t const k_null = UINT64_MAX;
+/** The image's offset in a cache entry. */
+static size_t const k_image_offset = (sizeof(struct RlcParseCacheHeader) + alignof(max_align_t) - 1)
+	& ~(alignof(max_align_t) - 1);
+
+/** A file's cache statistics. */
+struct RlcParseCacheStat
+{
+	char * fName;
+	int fHit;
+};
+
+/** Protects the statistics. */
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+/** The cache directory, or null if the cache is disabled. */
+static char * s_directory = NULL;
+/** The version of this compiler. */
+static uint64_t s_version = 0;
+static struct RlcParseCacheStat * s_stats = NULL;
+static size_t s_stat_count = 0;
+
+void rlc_parse_cache_enable(
+	char const * directory)
+{
+	RLC_DASSERT(directory != NULL);
+	RLC_DASSERT(s_directory == NULL);
+
+	size_t const length = strlen(directory);
+	rlc_malloc((void**)&s_directory, length + 1);
+	memcpy(s_directory, directory, length + 1);
+	mkdir(directory, 0777);
+
+	// Any rebuild of the compiler may change how files are parsed, so the executable identifies the version.
+	struct stat info;
+	uint64_t exe[4] = { kFormatVersion, 0, 0, 0 };
+	if(!stat("/proc/self/exe", &info))
+	{
+		exe[1] = info.st_size;
+		exe[2] = info.st_mtim.tv_sec;
+		exe[3] = info.st_mtim.tv_nsec ^ ((uint64_t)info.st_ino << 32);
+	}
+	s_version = rlc_hash_bytes(exe, sizeof(exe), sizeof(void *));
+}
+
+/** Computes the digest that identifies a source file's contents. */
+static void content_digest(
+	struct RlcSrcFile const * source,
+	uint8_t digest[kRlcSha256Size])
+{
+	struct RlcSha256 hash;
+	rlc_sha256_create(&hash);
+	rlc_sha256_add(&hash, source->fContents, source->fContentLength);
+	rlc_sha256_digest(&hash, digest);
+}
+
+/** Builds the path of a file's cache entry. */
+static void entry_path(
+	char * path,
+	size_t size,
+	uint8_t const digest[kRlcSha256Size])
+{
+	int length = snprintf(path, size, "%s/", s_directory);
+	for(size_t i = 0; i < kRlcSha256Size; i++)
+		length += snprintf(path + length, size - length, "%02x", digest[i]);
+	snprintf(path + length, size - length, "-%016llx.rlpc", (unsigned long long) s_version);
+}
+
+static void record(
+	char const * name,
+	int hit)
+{
+	size_t const length = strlen(name);
+	char * copy = NULL;
+	rlc_malloc((void**)&copy, length + 1);
+	memcpy(copy, name, length + 1);
+
+	pthread_mutex_lock(&s_lock);
+	RLC_VECTOR_PUSH(NULL, s_stats, s_stat_count) = (struct RlcParseCacheStat){ copy, hit };
+	pthread_mutex_unlock(&s_lock);
+}
+
+/** Maps a cache entry and relocates its image.
+@return
+	The entry's header, or null if the entry is missing or does not belong to the file. */
+static struct RlcParseCacheHeader * map_entry(
+	char const * path,
+	struct RlcSrcFile const * source,
+	uint8_t const digest[kRlcSha256Size],
+	size_t * size)
+{
+	int const fd = open(path, O_RDONLY | O_CLOEXEC);
+	if(fd < 0)
+		return NULL;
+
+	struct stat info;
+	void * mapping = MAP_FAILED;
+	if(!fstat(fd, &info) && (uint64_t)info.st_size >= k_image_offset)
+		// Private, so that relocating does not change the entry. Populating copies all pages at once, instead of faulting on each relocated page.
+		mapping = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+	close(fd);
+	if(mapping == MAP_FAILED)
+		return NULL;
+
+	*size = info.st_size;
+	struct RlcParseCacheHeader * header = mapping;
+	char * image = (char *)mapping + k_image_offset;
+	size_t const available = *size - k_image_offset;
+
+	if(memcmp(header->fMagic, k_magic, sizeof(k_magic))
+	|| header->fVersion != s_version
+	|| memcmp(header->fContentDigest, digest, kRlcSha256Size)
+	|| header->fContentLength != source->fContentLength
+	|| header->fImageSize > available
+	|| header->fRelocationCount > (available - header->fImageSize) / sizeof(uint32_t)
+	|| header->fNameCount > (available - header->fImageSize) / sizeof(uint32_t) - header->fRelocationCount
+	|| header->fConstantCount > (available - header->fImageSize
+			- (header->fRelocationCount + header->fNameCount) * sizeof(uint32_t))
+		/ sizeof(struct RlcSrcString))
+	{
+		munmap(mapping, *size);
+		return NULL;
+	}
+
+	// Damaged entries are rejected instead of producing a broken tree.
+	uint32_t const * relocations = (uint32_t const *)(image + header->fImageSize);
+	for(uint64_t i = 0; i < header->fRelocationCount; i++)
+	{
+		uintptr_t * pointer = (uintptr_t *)(image + relocations[i]);
+		if(relocations[i] % sizeof(uintptr_t)
+		|| relocations[i] + sizeof(uintptr_t) > header->fImageSize
+		|| *pointer >= header->fImageSize)
+		{
+			munmap(mapping, *size);
+			return NULL;
+		}
+		*pointer += (uintptr_t) image;
+	}
+
+	// Names are interned again, as IDs differ between compiler runs.
+	uint32_t const * names = relocations + header->fRelocationCount;
+	for(uint64_t i = 0; i < header->fNameCount; i++)
+	{
+		struct RlcSrcString * name = (struct RlcSrcString *)(image + names[i]);
+		if(names[i] % alignof(struct RlcSrcString)
+		|| names[i] + sizeof(struct RlcSrcString) > header->fImageSize
+		|| !name->length
+		|| !rlc_src_string_valid(name, source))
+		{
+			munmap(mapping, *size);
+			return NULL;
+		}
+		name->identifier = rlc_identifier_intern(&source->fContents[name->start], name->length);
+	}
+
+	struct RlcSrcString const * constants = (struct RlcSrcString const *)(names + header->fNameCount);
+	for(uint64_t i = 0; i < header->fConstantCount; i++)
+		if(!constants[i].length || !rlc_src_string_valid(&constants[i], source))
+		{
+			munmap(mapping, *size);
+			return NULL;
+		}
+
+	return header;
+}
+
+int rlc_parse_cache_load(
+	struct RlcParsedFile * file)
+{
+	RLC_DASSERT(file != NULL);
+	RLC_DASSERT(file->fCache == NULL);
+
+	if(!s_directory)
+		return 0;
+
+	struct RlcSrcFile const * source = &file->fSource;
+	uint8_t digest[kRlcSha256Size];
+	content_digest(source, digest);
+	char path[4096];
+	entry_path(path, sizeof(path), digest);
+
+	size_t size;
+	struct RlcParseCacheHeader const * header = map_entry(path, source, digest, &size);
+	record(source->fName, header != NULL);
+	if(!header)
+		return 0;
+
+	char * image = (char *)header + k_image_offset;
+	struct RlcSrcString const * constants = (struct RlcSrcString const *)(image
+		+ header->fImageSize
+		+ (header->fRelocationCount + header->fNameCount) * sizeof(uint32_t));
+	for(uint64_t i = 0; i < header->fConstantCount; i++)
+		rlc_parsed_symbol_constant_register(source, &constants[i]);
+
+	file->fIncludes = header->fIncludes == k_null
+		? NULL
+		: (struct RlcParsedIncludeStatement *)(image + header->fIncludes);
+	file->fIncludeCount = header->fIncludeCount;
+	file->fScopeEntries.fEntries = header->fEntries == k_null
+		? NULL
+		: (struct RlcParsedScopeEntry **)(image + header->fEntries);
+	file->fScopeEntries.fEntryCount = header->fEntryCount;
+	file->fCache = (void *)header;
+	file->fCacheSize = size;
+	return 1;
+}
+
+/** An arena block's place in the image. */
+struct RlcParseCacheBlock
+{
+	char const * fData;
+	size_t fUsed;
+	size_t fOffset;
+};
+
+/** A reachable part of the arena's copy, and its place in the compacted image. */
+struct RlcParseCacheRange
+{
+	size_t fBegin;
+	size_t fEnd;
+	size_t fOffset;
+};
+
+/** Converts a syntax tree into an image.
+	The arena also holds objects that are no longer reachable, such as vectors that were moved when they grew, and trees that were discarded when parsing backtracked. Only the objects reachable from the file's roots are written. */
+struct RlcParseCacheWriter
+{
+	/** The arena's blocks, sorted by address. */
+	struct RlcParseCacheBlock * fBlocks;
+	size_t fBlockCount;
+	/** The copy of all blocks. */
+	char * fImage;
+	size_t fImageSize;
+	/** One bit per pointer-sized word of the copy, set for words holding a pointer. */
+	uint64_t * fPointers;
+	/** The reachable objects, as offsets into the copy. */
+	struct RlcParseCacheRange * fRanges;
+	size_t fRangeCount;
+	/** The offsets into the copy of all identifiers. */
+	size_t * fNames;
+	size_t fNameCount;
+	/** The names of the symbol constants the file registers. */
+	struct RlcSrcString * fConstants;
+	size_t fConstantCount;
+	/** Set if the tree points outside its arena, and cannot be cached. */
+	int fFailed;
+};
+
+static int compare_blocks(
+	void const * lhs,
+	void const * rhs)
+{
+	struct RlcParseCacheBlock const * a = lhs, * b = rhs;
+	return a->fData < b->fData ? -1 : a->fData > b->fData;
+}
+
+/** Finds an address' image offset.
+@return
+	Whether the address lies inside the arena. */
+static int find_offset(
+	struct RlcParseCacheWriter * this,
+	void const * address,
+	size_t * offset)
+{
+	char const * p = address;
+	size_t low = 0, high = this->fBlockCount;
+	while(low < high)
+	{
+		size_t const mid = low + (high - low) / 2;
+		struct RlcParseCacheBlock const * block = &this->fBlocks[mid];
+		if(p < block->fData)
+			high = mid;
+		else if(p >= block->fData + block->fUsed)
+			low = mid + 1;
+		else
+		{
+			*offset = block->fOffset + (p - block->fData);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/** Marks an object as reachable, so that it is written.
+@param[in] object:
+	The object's address inside the arena.
+@param[in] size:
+	The object's size. */
+static void keep(
+	struct RlcParseCacheWriter * this,
+	void const * object,
+	size_t size)
+{
+	size_t begin, last;
+	if(this->fFailed)
+		return;
+	// Objects never span arena blocks, so both ends must be in the same block.
+	if(!find_offset(this, object, &begin)
+	|| (size && (!find_offset(this, (char const *)object + size - 1, &last)
+		|| last != begin + size - 1)))
+	{
+		this->fFailed = 1;
+		return;
+	}
+
+	RLC_VECTOR_PUSH(NULL, this->fRanges, this->fRangeCount) = (struct RlcParseCacheRange){
+		begin, begin + size, 0
+	};
+}
+
+/** Replaces a pointer in the copy with its target's offset, and marks the target as reachable.
+@param[in] slot:
+	The pointer's address inside the arena.
+@param[in] size:
+	The size of the pointer's target. Objects with a deriving type pass 0, and are marked once their type is known.
+@return
+	The pointer, or null if it is null or cannot be cached. */
+static void const * relocate(
+	struct RlcParseCacheWriter * this,
+	void const * slot,
+	size_t size)
+{
+	void const * target = *(void const * const *)slot;
+	if(!target || this->fFailed)
+		return NULL;
+
+	size_t at, to;
+	if(!find_offset(this, slot, &at)
+	|| !find_offset(this, target, &to)
+	|| at % sizeof(void *))
+	{
+		this->fFailed = 1;
+		return NULL;
+	}
+
+	// Shared objects are visited more than once, but must only be relocated once.
+	size_t const word = at / sizeof(void *);
+	uint64_t const bit = (uint64_t)1 << (word % 64);
+	if(!(this->fPointers[word / 64] & bit))
+	{
+		this->fPointers[word / 64] |= bit;
+		uintptr_t const value = to;
+		memcpy(this->fImage + at, &value, sizeof(value));
+		keep(this, target, size);
+	}
+	return this->fFailed ? NULL : target;
+}
+
+/** Records an identifier, so that it is interned again when loading.
+@param[in] name:
+	The name's address inside a reachable object. Strings that are no identifiers are ignored. */
+static void add_name(
+	struct RlcParseCacheWriter * this,
+	struct RlcSrcString const * name)
+{
+	size_t at;
+	if(!name->identifier || this->fFailed)
+		return;
+	if(!find_offset(this, name, &at))
+	{
+		this->fFailed = 1;
+		return;
+	}
+	RLC_VECTOR_PUSH(NULL, this->fNames, this->fNameCount) = at;
+}
+
+/** Records a scope entry's name, see `add_name()`. */
+static void add_entry_name(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedScopeEntry const * entry)
+{
+	add_name(this, &entry->fName);
+}
+
+/** Records a control label's name, see `add_name()`. */
+static void add_label(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedControlLabel const * label)
+{
+	if(label->fExists)
+		add_name(this, &label->fLabel.content);
+}
+
+static void add_constant(
+	struct RlcParseCacheWriter * this,
+	struct RlcSrcString const * name)
+{
+	RLC_VECTOR_PUSH(NULL, this->fConstants, this->fConstantCount) = *name;
+}
+
+static void relocate_expression(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedExpression const * expression);
+static void relocate_statement(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedStatement const * statement);
+static void relocate_type_name(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedTypeName const * type);
+static void relocate_scope_entry(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedScopeEntry const * entry);
+
+static void relocate_expression_pointer(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedExpression * const * slot)
+{
+	if(relocate(this, slot, 0))
+		relocate_expression(this, *slot);
+}
+
+static void relocate_expressions(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedExpression ** const * slot,
+	size_t count)
+{
+	if(relocate(this, slot, count * sizeof(**slot)))
+		for(size_t i = 0; i < count; i++)
+			relocate_expression_pointer(this, &(*slot)[i]);
+}
+
+static void relocate_statement_pointer(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedStatement * const * slot)
+{
+	if(relocate(this, slot, 0))
+		relocate_statement(this, *slot);
+}
+
+static void relocate_symbol_child(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedSymbolChild const * child)
+{
+	add_name(this, &child->fName);
+	if(!relocate(this, &child->fTemplates, child->fTemplateCount * sizeof(*child->fTemplates)))
+		return;
+
+	for(size_t i = 0; i < child->fTemplateCount; i++)
+	{
+		struct RlcParsedSymbolChildTemplate const * template = &child->fTemplates[i];
+		if(template->fIsExpression)
+			relocate_expressions(this, &template->fExpressions, template->fSize);
+		else if(relocate(this, &template->fTypeNames, template->fSize * sizeof(*template->fTypeNames)))
+			for(RlcSrcSize j = 0; j < template->fSize; j++)
+				relocate_type_name(this, &template->fTypeNames[j]);
+	}
+}
+
+static void relocate_symbol(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedSymbol const * symbol)
+{
+	if(relocate(this, &symbol->fChildren, symbol->fChildCount * sizeof(*symbol->fChildren)))
+		for(size_t i = 0; i < symbol->fChildCount; i++)
+			relocate_symbol_child(this, &symbol->fChildren[i]);
+}
+
+static void relocate_type_name(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedTypeName const * type)
+{
+	switch(type->fValue)
+	{
+	case kRlcParsedTypeNameValueName:
+		if(relocate(this, &type->fName, sizeof(*type->fName)))
+			relocate_symbol(this, type->fName);
+		break;
+	case kRlcParsedTypeNameValueSymbolConstant:
+		add_constant(this, &type->fSymbolConstant);
+		break;
+	case kRlcParsedTypeNameValueFunction:
+		if(relocate(this, &type->fFunction, sizeof(*type->fFunction)))
+		{
+			struct RlcParsedFunctionSignature const * signature = type->fFunction;
+			if(relocate(this, &signature->fArguments, signature->fArgumentCount * sizeof(*signature->fArguments)))
+				for(RlcSrcSize i = 0; i < signature->fArgumentCount; i++)
+					relocate_type_name(this, &signature->fArguments[i]);
+			relocate_type_name(this, &signature->fResult);
+		}
+		break;
+	case kRlcParsedTypeNameValueExpression:
+		relocate_expression_pointer(this, &type->fExpression);
+		break;
+	case kRlcParsedTypeNameValueTuple:
+		if(relocate(this, &type->fTuple.fTypes, type->fTuple.fTypeCount * sizeof(*type->fTuple.fTypes)))
+			for(RlcSrcSize i = 0; i < type->fTuple.fTypeCount; i++)
+				relocate_type_name(this, &type->fTuple.fTypes[i]);
+		break;
+	default:;
+	}
+
+	if(relocate(this, &type->fTypeModifiers, type->fTypeModifierCount * sizeof(*type->fTypeModifiers)))
+		for(size_t i = 0; i < type->fTypeModifierCount; i++)
+			if(type->fTypeModifiers[i].fIsArray)
+				relocate_expression_pointer(this, &type->fTypeModifiers[i].fArraySize);
+}
+
+static void relocate_template_decl(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedTemplateDecl const * templates)
+{
+	if(relocate(this, &templates->fChildren, templates->fChildCount * sizeof(*templates->fChildren)))
+		for(size_t i = 0; i < templates->fChildCount; i++)
+		{
+			add_name(this, &templates->fChildren[i].fName);
+			if(templates->fChildren[i].fType == kRlcParsedTemplateDeclTypeValue)
+				relocate_type_name(this, &templates->fChildren[i].fValueType);
+		}
+}
+
+static void relocate_variable(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedVariable const * variable)
+{
+	add_entry_name(this, RLC_BASE(variable, RlcParsedScopeEntry));
+	relocate_template_decl(this, &variable->fTemplates);
+	if(variable->fHasType)
+		relocate_type_name(this, &variable->fType);
+	relocate_expressions(this, &variable->fInitArgs, variable->fInitArgCount);
+}
+
+static void relocate_variables(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedVariable * const * slot,
+	size_t count)
+{
+	if(relocate(this, slot, count * sizeof(**slot)))
+		for(size_t i = 0; i < count; i++)
+			relocate_variable(this, &(*slot)[i]);
+}
+
+static void relocate_block(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedBlockStatement const * block)
+{
+	struct RlcParsedStatementList const * list = &block->fList;
+	if(relocate(this, &list->fStatements, list->fStatementCount * sizeof(*list->fStatements)))
+		for(size_t i = 0; i < list->fStatementCount; i++)
+			relocate_statement_pointer(this, &list->fStatements[i]);
+}
+
+static void relocate_function(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedFunction const * function)
+{
+	add_entry_name(this, RLC_BASE(function, RlcParsedScopeEntry));
+	if(function->fHasReturnType == kRlcFunctionReturnTypeType)
+		relocate_type_name(this, &function->fReturnType);
+	relocate_variables(this, &function->fArguments, function->fArgumentCount);
+	relocate_template_decl(this, &function->fTemplates);
+
+	if(function->fHasBody)
+	{
+		if(function->fIsShortHandBody)
+			relocate_expression_pointer(this, &function->fReturnValue);
+		else
+			relocate_block(this, &function->fBodyStatement);
+	}
+}
+
+static void relocate_case(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedCaseStatement const * statement)
+{
+	add_label(this, &statement->fControlLabel);
+	relocate_expressions(this, &statement->fValues.fValues, statement->fValues.fCount);
+	relocate_statement_pointer(this, &statement->fBody);
+}
+
+static void relocate_catch(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedCatchStatement const * statement)
+{
+	if(!statement->fIsVoid)
+		relocate_variable(this, &statement->fException);
+	relocate_statement_pointer(this, &statement->fBody);
+}
+
+static void relocate_statement(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedStatement const * statement)
+{
+#define DERIVED(type) RLC_DERIVE_CAST(statement, RlcParsedStatement, struct type const)
+	switch(RLC_DERIVING_TYPE(statement))
+	{
+	case kRlcParsedAssertStatement:
+		keep(this, DERIVED(RlcParsedAssertStatement), sizeof(struct RlcParsedAssertStatement));
+		relocate_expression_pointer(this, &DERIVED(RlcParsedAssertStatement)->fAssertion);
+		break;
+	case kRlcParsedExpressionStatement:
+		keep(this, DERIVED(RlcParsedExpressionStatement), sizeof(struct RlcParsedExpressionStatement));
+		relocate_expression_pointer(this, &DERIVED(RlcParsedExpressionStatement)->fExpression);
+		break;
+	case kRlcParsedBlockStatement:
+		keep(this, DERIVED(RlcParsedBlockStatement), sizeof(struct RlcParsedBlockStatement));
+		relocate_block(this, DERIVED(RlcParsedBlockStatement));
+		break;
+	case kRlcParsedIfStatement:
+		{
+			struct RlcParsedIfStatement const * s = DERIVED(RlcParsedIfStatement);
+			keep(this, s, sizeof(*s));
+			add_label(this, &s->fIfLabel);
+			if(s->fCondition.fIsVariable)
+				relocate_variable(this, &s->fCondition.fVariable);
+			else
+				relocate_expression_pointer(this, &s->fCondition.fExpression);
+			relocate_statement_pointer(this, &s->fIf);
+			relocate_statement_pointer(this, &s->fElse);
+		} break;
+	case kRlcParsedLoopStatement:
+		{
+			struct RlcParsedLoopStatement const * s = DERIVED(RlcParsedLoopStatement);
+			keep(this, s, sizeof(*s));
+			add_label(this, &s->fLabel);
+			if(s->fIsVariableInitial)
+				relocate_variable(this, &s->fInitial.fVariable);
+			else
+				relocate_expression_pointer(this, &s->fInitial.fExpression);
+			if(s->fIsVariableCondition)
+				relocate_variable(this, &s->fCondition.fVariable);
+			else
+				relocate_expression_pointer(this, &s->fCondition.fExpression);
+			relocate_statement_pointer(this, &s->fBody);
+			relocate_expression_pointer(this, &s->fPostLoop);
+		} break;
+	case kRlcParsedVariableStatement:
+		keep(this, DERIVED(RlcParsedVariableStatement), sizeof(struct RlcParsedVariableStatement));
+		relocate_variable(this, &DERIVED(RlcParsedVariableStatement)->fVariable);
+		break;
+	case kRlcParsedReturnStatement:
+		keep(this, DERIVED(RlcParsedReturnStatement), sizeof(struct RlcParsedReturnStatement));
+		relocate_expression_pointer(this, &DERIVED(RlcParsedReturnStatement)->fExpression);
+		break;
+	case kRlcParsedSwitchStatement:
+		{
+			struct RlcParsedSwitchStatement const * s = DERIVED(RlcParsedSwitchStatement);
+			keep(this, s, sizeof(*s));
+			add_label(this, &s->fLabel);
+			if(s->fIsVariableSwitchValue)
+				relocate_variable(this, &s->fSwitchValue.fVariable);
+			else
+				relocate_expression_pointer(this, &s->fSwitchValue.fExpression);
+			if(relocate(this, &s->fCases, s->fCaseCount * sizeof(*s->fCases)))
+				for(size_t i = 0; i < s->fCaseCount; i++)
+					relocate_case(this, &s->fCases[i]);
+		} break;
+	case kRlcParsedCaseStatement:
+		keep(this, DERIVED(RlcParsedCaseStatement), sizeof(struct RlcParsedCaseStatement));
+		relocate_case(this, DERIVED(RlcParsedCaseStatement));
+		break;
+	case kRlcParsedTryStatement:
+		{
+			struct RlcParsedTryStatement const * s = DERIVED(RlcParsedTryStatement);
+			keep(this, s, sizeof(*s));
+			relocate_statement_pointer(this, &s->fBody);
+			if(relocate(this, &s->fCatches, s->fCatchCount * sizeof(*s->fCatches)))
+				for(RlcSrcSize i = 0; i < s->fCatchCount; i++)
+					relocate_catch(this, &s->fCatches[i]);
+			relocate_statement_pointer(this, &s->fFinally);
+		} break;
+	case kRlcParsedThrowStatement:
+		{
+			struct RlcParsedThrowStatement const * s = DERIVED(RlcParsedThrowStatement);
+			keep(this, s, sizeof(*s));
+			if(s->fType == kRlcThrowTypeValue)
+				relocate_expression_pointer(this, &s->fValue);
+		} break;
+	case kRlcParsedCatchStatement:
+		keep(this, DERIVED(RlcParsedCatchStatement), sizeof(struct RlcParsedCatchStatement));
+		relocate_catch(this, DERIVED(RlcParsedCatchStatement));
+		break;
+	case kRlcParsedBreakStatement:
+		keep(this, DERIVED(RlcParsedBreakStatement), sizeof(struct RlcParsedBreakStatement));
+		add_label(this, &DERIVED(RlcParsedBreakStatement)->fLabel);
+		break;
+	case kRlcParsedContinueStatement:
+		keep(this, DERIVED(RlcParsedContinueStatement), sizeof(struct RlcParsedContinueStatement));
+		add_label(this, &DERIVED(RlcParsedContinueStatement)->fLabel);
+		break;
+	default:
+		this->fFailed = 1;
+	}
+#undef DERIVED
+}
+
+static void relocate_expression(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedExpression const * expression)
+{
+#define DERIVED(type) RLC_DERIVE_CAST(expression, RlcParsedExpression, struct type const)
+	switch(RLC_DERIVING_TYPE(expression))
+	{
+	case kRlcParsedSymbolExpression:
+		keep(this, DERIVED(RlcParsedSymbolExpression), sizeof(struct RlcParsedSymbolExpression));
+		relocate_symbol(this, &DERIVED(RlcParsedSymbolExpression)->fSymbol);
+		break;
+	case kRlcParsedSymbolChildExpression:
+		keep(this, DERIVED(RlcParsedSymbolChildExpression), sizeof(struct RlcParsedSymbolChildExpression));
+		relocate_symbol_child(this, RLC_BASE(DERIVED(RlcParsedSymbolChildExpression), RlcParsedSymbolChild));
+		break;
+	case kRlcParsedStringExpression:
+		{
+			struct RlcParsedStringExpression const * e = DERIVED(RlcParsedStringExpression);
+			keep(this, e, sizeof(*e));
+			relocate(this, &e->fTokens, e->fTokenCount * sizeof(*e->fTokens));
+		} break;
+	case kRlcParsedOperatorExpression:
+		{
+			struct RlcParsedOperatorExpression const * e = DERIVED(RlcParsedOperatorExpression);
+			keep(this, e, sizeof(*e));
+			relocate_expressions(this, &e->fExpressions, e->fExpressionCount);
+		} break;
+	case kRlcParsedCastExpression:
+		{
+			struct RlcParsedCastExpression const * e = DERIVED(RlcParsedCastExpression);
+			keep(this, e, sizeof(*e));
+			relocate_type_name(this, &e->fType);
+			relocate_expressions(this, &e->fValues, e->fValueCount);
+		} break;
+	case kRlcParsedSizeofExpression:
+		{
+			struct RlcParsedSizeofExpression const * e = DERIVED(RlcParsedSizeofExpression);
+			keep(this, e, sizeof(*e));
+			if(e->fIsType)
+				relocate_type_name(this, &e->fType);
+			else
+				relocate_expression_pointer(this, &e->fExpression);
+		} break;
+	case kRlcParsedSymbolConstantExpression:
+		keep(this, DERIVED(RlcParsedSymbolConstantExpression), sizeof(struct RlcParsedSymbolConstantExpression));
+		add_constant(this, &DERIVED(RlcParsedSymbolConstantExpression)->fName);
+		break;
+	case kRlcParsedNumberExpression:
+		keep(this, DERIVED(RlcParsedNumberExpression), sizeof(struct RlcParsedNumberExpression));
+		break;
+	case kRlcParsedCharacterExpression:
+		keep(this, DERIVED(RlcParsedCharacterExpression), sizeof(struct RlcParsedCharacterExpression));
+		break;
+	case kRlcParsedThisExpression:
+		keep(this, DERIVED(RlcParsedThisExpression), sizeof(struct RlcParsedThisExpression));
+		break;
+	case kRlcParsedNullExpression:
+		keep(this, DERIVED(RlcParsedNullExpression), sizeof(struct RlcParsedNullExpression));
+		break;
+	default:
+		this->fFailed = 1;
+	}
+#undef DERIVED
+}
+
+static void relocate_member_list(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedMemberList const * list);
+
+static void relocate_class(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedClass const * class)
+{
+	add_entry_name(this, RLC_BASE(class, RlcParsedScopeEntry));
+	relocate_template_decl(this, &class->fTemplateDecl);
+	if(relocate(this, &class->fInheritances, class->fInheritanceCount * sizeof(*class->fInheritances)))
+		for(RlcSrcSize i = 0; i < class->fInheritanceCount; i++)
+			relocate_symbol(this, &class->fInheritances[i].fBase);
+	relocate_member_list(this, &class->fMembers);
+	relocate_member_list(this, &class->fConstructors);
+	if(class->fHasDestructor && class->fDestructor.fIsDefinition)
+		relocate_block(this, &class->fDestructor.fBody);
+}
+
+static void relocate_rawtype(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedRawtype const * rawtype)
+{
+	add_entry_name(this, RLC_BASE(rawtype, RlcParsedScopeEntry));
+	relocate_expression_pointer(this, &rawtype->fSize);
+	relocate_template_decl(this, &rawtype->fTemplates);
+	relocate_member_list(this, &rawtype->fMembers);
+}
+
+static void relocate_union(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedUnion const * union_)
+{
+	add_entry_name(this, RLC_BASE(union_, RlcParsedScopeEntry));
+	relocate_template_decl(this, &union_->fTemplates);
+	relocate_member_list(this, &union_->fMembers);
+}
+
+static void relocate_enum(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedEnum const * enum_)
+{
+	add_entry_name(this, RLC_BASE(enum_, RlcParsedScopeEntry));
+	if(!relocate(this, &enum_->fConstants, enum_->fConstantCount * sizeof(*enum_->fConstants)))
+		return;
+
+	for(size_t i = 0; i < enum_->fConstantCount; i++)
+	{
+		struct RlcParsedEnumConstant const * constant = &enum_->fConstants[i];
+		add_entry_name(this, RLC_BASE(constant, RlcParsedScopeEntry));
+		add_constant(this, &RLC_BASE(constant, RlcParsedScopeEntry)->fName);
+		if(relocate(this, &constant->fAliasTokens, constant->fAliasCount * sizeof(*constant->fAliasTokens)))
+			for(size_t j = 0; j < constant->fAliasCount; j++)
+				add_constant(this, &constant->fAliasTokens[j]);
+	}
+}
+
+static void relocate_typedef(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedTypedef const * typedef_)
+{
+	add_entry_name(this, RLC_BASE(typedef_, RlcParsedScopeEntry));
+	relocate_template_decl(this, &typedef_->fTemplates);
+	relocate_type_name(this, &typedef_->fType);
+}
+
+static void relocate_member(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedMember const * member)
+{
+#define DERIVED(type) RLC_DERIVE_CAST(member, RlcParsedMember, struct type const)
+	switch(RLC_DERIVING_TYPE(member))
+	{
+	case kRlcParsedMemberFunction:
+		keep(this, DERIVED(RlcParsedMemberFunction), sizeof(struct RlcParsedMemberFunction));
+		relocate_function(this, RLC_BASE(DERIVED(RlcParsedMemberFunction), RlcParsedFunction));
+		break;
+	case kRlcParsedMemberVariable:
+		keep(this, DERIVED(RlcParsedMemberVariable), sizeof(struct RlcParsedMemberVariable));
+		relocate_variable(this, RLC_BASE(DERIVED(RlcParsedMemberVariable), RlcParsedVariable));
+		break;
+	case kRlcParsedMemberRawtype:
+		keep(this, DERIVED(RlcParsedMemberRawtype), sizeof(struct RlcParsedMemberRawtype));
+		relocate_rawtype(this, RLC_BASE(DERIVED(RlcParsedMemberRawtype), RlcParsedRawtype));
+		break;
+	case kRlcParsedMemberUnion:
+		keep(this, DERIVED(RlcParsedMemberUnion), sizeof(struct RlcParsedMemberUnion));
+		relocate_union(this, RLC_BASE(DERIVED(RlcParsedMemberUnion), RlcParsedUnion));
+		break;
+	case kRlcParsedMemberClass:
+		keep(this, DERIVED(RlcParsedMemberClass), sizeof(struct RlcParsedMemberClass));
+		relocate_class(this, RLC_BASE(DERIVED(RlcParsedMemberClass), RlcParsedClass));
+		break;
+	case kRlcParsedMemberEnum:
+		keep(this, DERIVED(RlcParsedMemberEnum), sizeof(struct RlcParsedMemberEnum));
+		relocate_enum(this, RLC_BASE(DERIVED(RlcParsedMemberEnum), RlcParsedEnum));
+		break;
+	case kRlcParsedMemberTypedef:
+		keep(this, DERIVED(RlcParsedMemberTypedef), sizeof(struct RlcParsedMemberTypedef));
+		relocate_typedef(this, RLC_BASE(DERIVED(RlcParsedMemberTypedef), RlcParsedTypedef));
+		break;
+	case kRlcParsedConstructor:
+		{
+			struct RlcParsedConstructor const * m = DERIVED(RlcParsedConstructor);
+			keep(this, m, sizeof(*m));
+			relocate_template_decl(this, &m->fTemplates);
+			relocate_variables(this, &m->fArguments, m->fArgumentCount);
+			if(relocate(this, &m->fInitialisers, m->fInitialiserCount * sizeof(*m->fInitialisers)))
+				for(size_t i = 0; i < m->fInitialiserCount; i++)
+				{
+					struct RlcParsedInitialiser const * init = &m->fInitialisers[i];
+					relocate_symbol(this, &init->fMember);
+					relocate_expressions(this, &init->fArguments, init->fArgumentCount);
+				}
+			if(m->fIsDefinition)
+				relocate_block(this, &m->fBody);
+		} break;
+	case kRlcParsedDestructor:
+		{
+			struct RlcParsedDestructor const * m = DERIVED(RlcParsedDestructor);
+			keep(this, m, sizeof(*m));
+			if(m->fIsDefinition)
+				relocate_block(this, &m->fBody);
+		} break;
+	default:
+		this->fFailed = 1;
+	}
+#undef DERIVED
+}
+
+static void relocate_member_list(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedMemberList const * list)
+{
+	if(relocate(this, &list->fEntries, list->fEntryCount * sizeof(*list->fEntries)))
+		for(size_t i = 0; i < list->fEntryCount; i++)
+			if(relocate(this, &list->fEntries[i], 0))
+				relocate_member(this, list->fEntries[i]);
+}
+
+static void relocate_scope_entry_list(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedScopeEntryList const * list)
+{
+	if(relocate(this, &list->fEntries, list->fEntryCount * sizeof(*list->fEntries)))
+		for(size_t i = 0; i < list->fEntryCount; i++)
+			if(relocate(this, &list->fEntries[i], 0))
+				relocate_scope_entry(this, list->fEntries[i]);
+}
+
+static void relocate_scope_entry(
+	struct RlcParseCacheWriter * this,
+	struct RlcParsedScopeEntry const * entry)
+{
+#define DERIVED(type) RLC_DERIVE_CAST(entry, RlcParsedScopeEntry, struct type const)
+	switch(RLC_DERIVING_TYPE(entry))
+	{
+	case kRlcParsedClass:
+		keep(this, DERIVED(RlcParsedClass), sizeof(struct RlcParsedClass));
+		relocate_class(this, DERIVED(RlcParsedClass));
+		break;
+	case kRlcParsedMask:
+		{
+			struct RlcParsedMask const * e = DERIVED(RlcParsedMask);
+			keep(this, e, sizeof(*e));
+			add_entry_name(this, entry);
+			relocate_template_decl(this, &e->fTemplates);
+			if(relocate(this, &e->fFunctions, e->fFunctionCount * sizeof(*e->fFunctions)))
+				for(RlcSrcSize i = 0; i < e->fFunctionCount; i++)
+					relocate_function(this, RLC_BASE(&e->fFunctions[i], RlcParsedFunction));
+		} break;
+	case kRlcParsedRawtype:
+		keep(this, DERIVED(RlcParsedRawtype), sizeof(struct RlcParsedRawtype));
+		relocate_rawtype(this, DERIVED(RlcParsedRawtype));
+		break;
+	case kRlcParsedUnion:
+		keep(this, DERIVED(RlcParsedUnion), sizeof(struct RlcParsedUnion));
+		relocate_union(this, DERIVED(RlcParsedUnion));
+		break;
+	case kRlcParsedNamespace:
+		keep(this, DERIVED(RlcParsedNamespace), sizeof(struct RlcParsedNamespace));
+		add_entry_name(this, entry);
+		relocate_scope_entry_list(this, &DERIVED(RlcParsedNamespace)->fEntryList);
+		break;
+	case kRlcParsedFunction:
+		keep(this, DERIVED(RlcParsedFunction), sizeof(struct RlcParsedFunction));
+		relocate_function(this, DERIVED(RlcParsedFunction));
+		break;
+	case kRlcParsedVariable:
+		keep(this, DERIVED(RlcParsedVariable), sizeof(struct RlcParsedVariable));
+		relocate_variable(this, DERIVED(RlcParsedVariable));
+		break;
+	case kRlcParsedEnum:
+		keep(this, DERIVED(RlcParsedEnum), sizeof(struct RlcParsedEnum));
+		relocate_enum(this, DERIVED(RlcParsedEnum));
+		break;
+	case kRlcParsedTypedef:
+		keep(this, DERIVED(RlcParsedTypedef), sizeof(struct RlcParsedTypedef));
+		relocate_typedef(this, DERIVED(RlcParsedTypedef));
+		break;
+	case kRlcParsedExternalSymbol:
+		{
+			struct RlcParsedExternalSymbol const * e = DERIVED(RlcParsedExternalSymbol);
+			keep(this, e, sizeof(*e));
+			add_entry_name(this, entry);
+			if(e->fIsFunction)
+				relocate_function(this, &e->fFunction);
+			else
+				relocate_type_name(this, &e->fType);
+		} break;
+	case kRlcParsedTest:
+		keep(this, DERIVED(RlcParsedTest), sizeof(struct RlcParsedTest));
+		add_entry_name(this, entry);
+		relocate_block(this, &DERIVED(RlcParsedTest)->fBody);
+		break;
+	default:
+		// Enum constants only exist inside enums.
+		this->fFailed = 1;
+	}
+#undef DERIVED
+}
+
+/** Finds the image offset of a root pointer, which lives outside the arena. */
+static uint64_t root_offset(
+	struct RlcParseCacheWriter * this,
+	void const * pointer)
+{
+	size_t offset;
+	if(!pointer)
+		return k_null;
+	if(!find_offset(this, pointer, &offset))
+	{
+		this->fFailed = 1;
+		return k_null;
+	}
+	return offset;
+}
+
+static int compare_ranges(
+	void const * lhs,
+	void const * rhs)
+{
+	struct RlcParseCacheRange const * a = lhs, * b = rhs;
+	return a->fBegin < b->fBegin ? -1 : a->fBegin > b->fBegin;
+}
+
+/** Finds the compacted image offset of an offset into the copy.
+@return
+	Whether the offset lies inside a reachable object. */
+static int compacted_offset(
+	struct RlcParseCacheWriter const * this,
+	size_t offset,
+	size_t * compacted)
+{
+	size_t low = 0, high = this->fRangeCount;
+	while(low < high)
+	{
+		size_t const mid = low + (high - low) / 2;
+		if(this->fRanges[mid].fBegin <= offset)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	if(!low || offset > this->fRanges[low - 1].fEnd)
+		return 0;
+
+	struct RlcParseCacheRange const * range = &this->fRanges[low - 1];
+	*compacted = range->fOffset + (offset - range->fBegin);
+	return 1;
+}
+
+/** Copies the reachable objects into the compacted image, and collects the compacted offsets of all pointers.
+	Every object keeps its offset modulo the arena's alignment, so that its alignment is preserved.
+@param[out] image:
+	The compacted image.
+@param[out] image_size:
+	The compacted image's size.
+@param[out] relocations:
+	The compacted image offsets of all pointers, in address order.
+@param[out] relocation_count:
+	The number of pointers. */
+static void compact(
+	struct RlcParseCacheWriter * this,
+	char ** image,
+	size_t * image_size,
+	uint32_t ** relocations,
+	size_t * relocation_count)
+{
+	size_t const alignment = alignof(max_align_t);
+
+	// Merge overlapping ranges, as embedded and shared objects are marked more than once.
+	if(this->fRangeCount)
+		qsort(this->fRanges, this->fRangeCount, sizeof(struct RlcParseCacheRange), &compare_ranges);
+	size_t count = 0, size = 0;
+	for(size_t i = 0; i < this->fRangeCount; i++)
+	{
+		struct RlcParseCacheRange const range = this->fRanges[i];
+		if(count && range.fBegin <= this->fRanges[count-1].fEnd)
+		{
+			if(range.fEnd > this->fRanges[count-1].fEnd)
+				this->fRanges[count-1].fEnd = range.fEnd;
+		} else
+			this->fRanges[count++] = range;
+	}
+	this->fRangeCount = count;
+
+	for(size_t i = 0; i < count; i++)
+	{
+		struct RlcParseCacheRange * range = &this->fRanges[i];
+		size += (range->fBegin - size) & (alignment - 1);
+		range->fOffset = size;
+		size += range->fEnd - range->fBegin;
+	}
+	size = (size + alignment - 1) & ~(alignment - 1);
+
+	*image_size = size;
+	if(size)
+	{
+		rlc_malloc((void**)image, size);
+		memset(*image, 0, size);
+		for(size_t i = 0; i < count; i++)
+			memcpy(
+				*image + this->fRanges[i].fOffset,
+				this->fImage + this->fRanges[i].fBegin,
+				this->fRanges[i].fEnd - this->fRanges[i].fBegin);
+	}
+
+	size_t const words = this->fImageSize / sizeof(void *);
+	for(size_t word = 0; word < words; word++)
+	{
+		if(!this->fPointers[word / 64])
+		{
+			word |= 63;
+			continue;
+		}
+		if(!(this->fPointers[word / 64] & (uint64_t)1 << (word % 64)))
+			continue;
+
+		uintptr_t target;
+		memcpy(&target, this->fImage + word * sizeof(void *), sizeof(target));
+		size_t at, to;
+		if(!compacted_offset(this, word * sizeof(void *), &at)
+		|| !compacted_offset(this, target, &to))
+		{
+			this->fFailed = 1;
+			return;
+		}
+
+		target = to;
+		memcpy(*image + at, &target, sizeof(target));
+		RLC_VECTOR_PUSH(NULL, *relocations, *relocation_count) = at;
+	}
+}
+
+static int compare_offsets(
+	void const * lhs,
+	void const * rhs)
+{
+	size_t const a = *(size_t const *)lhs, b = *(size_t const *)rhs;
+	return a < b ? -1 : a > b;
+}
+
+/** Collects the compacted image offsets of all identifiers, each once.
+@param[out] names:
+	The compacted image offsets of all identifiers, in address order.
+@param[out] name_count:
+	The number of identifiers. */
+static void compact_names(
+	struct RlcParseCacheWriter * this,
+	uint32_t ** names,
+	size_t * name_count)
+{
+	// Shared objects are visited more than once.
+	if(this->fNameCount)
+		qsort(this->fNames, this->fNameCount, sizeof(size_t), &compare_offsets);
+	for(size_t i = 0; i < this->fNameCount; i++)
+	{
+		size_t at;
+		if(i && this->fNames[i] == this->fNames[i-1])
+			continue;
+		if(!compacted_offset(this, this->fNames[i], &at))
+		{
+			this->fFailed = 1;
+			return;
+		}
+		RLC_VECTOR_PUSH(NULL, *names, *name_count) = at;
+	}
+}
+
+/** Finds the compacted image offset of a root pointer. */
+static uint64_t compacted_root(
+	struct RlcParseCacheWriter * this,
+	uint64_t offset)
+{
+	size_t compacted;
+	if(offset == k_null)
+		return k_null;
+	if(!compacted_offset(this, offset, &compacted))
+	{
+		this->fFailed = 1;
+		return k_null;
+	}
+	return compacted;
+}
+
+/** Writes a whole buffer to a file. */
+static int write_all(
+	int fd,
+	void const * data,
+	size_t size)
+{
+	char const * p = data;
+	while(size)
+	{
+		ssize_t const written = write(fd, p, size);
+		if(written <= 0)
+			return 0;
+		p += written;
+		size -= written;
+	}
+	return 1;
+}
+
+/** Writes a cache entry to a temporary file, and then renames it, so that concurrent compilers never see partial entries. */
+static void write_entry(
+	char const * path,
+	struct RlcParseCacheHeader const * header,
+	char const * image,
+	uint32_t const * relocations,
+	uint32_t const * names,
+	struct RlcParseCacheWriter const * writer)
+{
+	char temporary[4096];
+	snprintf(temporary, sizeof(temporary), "%s/.tmp-XXXXXX", s_directory);
+	int const fd = mkstemp(temporary);
+	if(fd < 0)
+		return;
+
+	static char const k_padding[alignof(max_align_t)] = { 0 };
+	int const written = write_all(fd, header, sizeof(*header))
+		&& write_all(fd, k_padding, k_image_offset - sizeof(*header))
+		&& write_all(fd, image, header->fImageSize)
+		&& write_all(fd, relocations, header->fRelocationCount * sizeof(uint32_t))
+		&& write_all(fd, names, header->fNameCount * sizeof(uint32_t))
+		&& write_all(fd, writer->fConstants, writer->fConstantCount * sizeof(struct RlcSrcString));
+
+	if(close(fd) || !written || rename(temporary, path))
+		unlink(temporary);
+}
+
+void rlc_parse_cache_store(
+	struct RlcParsedFile const * file)
+{
+	RLC_DASSERT(file != NULL);
+
+	if(!s_directory)
+		return;
+
+	struct RlcParseCacheWriter writer = {
+		NULL, 0,
+		NULL, 0,
+		NULL,
+		NULL, 0,
+		NULL, 0,
+		NULL, 0,
+		0
+	};
+
+	void const * data;
+	size_t used;
+	for(struct RlcArenaBlock const * block = NULL;
+		(block = rlc_arena_next_block(&file->fArena, block, &data, &used));)
+	{
+		RLC_VECTOR_PUSH(NULL, writer.fBlocks, writer.fBlockCount) = (struct RlcParseCacheBlock){
+			data, used, writer.fImageSize
+		};
+		writer.fImageSize += used;
+	}
+
+	// Relocations are 32-bit image offsets.
+	if(writer.fImageSize > UINT32_MAX)
+	{
+		rlc_vector_free((void**)&writer.fBlocks);
+		return;
+	}
+
+	if(writer.fImageSize)
+	{
+		rlc_malloc((void**)&writer.fImage, writer.fImageSize);
+		for(size_t i = 0; i < writer.fBlockCount; i++)
+			memcpy(
+				writer.fImage + writer.fBlocks[i].fOffset,
+				writer.fBlocks[i].fData,
+				writer.fBlocks[i].fUsed);
+
+		size_t const words = (writer.fImageSize / sizeof(void *) + 63) / 64;
+		rlc_malloc((void**)&writer.fPointers, words * sizeof(uint64_t));
+		memset(writer.fPointers, 0, words * sizeof(uint64_t));
+		qsort(writer.fBlocks, writer.fBlockCount, sizeof(struct RlcParseCacheBlock), &compare_blocks);
+	}
+
+	struct RlcParseCacheHeader header;
+	memcpy(header.fMagic, k_magic, sizeof(k_magic));
+	header.fVersion = s_version;
+	content_digest(&file->fSource, header.fContentDigest);
+	header.fContentLength = file->fSource.fContentLength;
+	header.fIncludes = root_offset(&writer, file->fIncludes);
+	header.fIncludeCount = file->fIncludeCount;
+	header.fEntries = root_offset(&writer, file->fScopeEntries.fEntries);
+	header.fEntryCount = file->fScopeEntries.fEntryCount;
+
+	if(file->fIncludes)
+		keep(&writer, file->fIncludes, file->fIncludeCount * sizeof(*file->fIncludes));
+	if(file->fScopeEntries.fEntries)
+		keep(&writer, file->fScopeEntries.fEntries,
+			file->fScopeEntries.fEntryCount * sizeof(*file->fScopeEntries.fEntries));
+	for(size_t i = 0; i < file->fScopeEntries.fEntryCount; i++)
+		if(relocate(&writer, &file->fScopeEntries.fEntries[i], 0))
+			relocate_scope_entry(&writer, file->fScopeEntries.fEntries[i]);
+
+	char * image = NULL;
+	size_t image_size = 0;
+	uint32_t * relocations = NULL, * names = NULL;
+	size_t relocation_count = 0, name_count = 0;
+	if(!writer.fFailed)
+	{
+		compact(&writer, &image, &image_size, &relocations, &relocation_count);
+		compact_names(&writer, &names, &name_count);
+		header.fIncludes = compacted_root(&writer, header.fIncludes);
+		header.fEntries = compacted_root(&writer, header.fEntries);
+	}
+
+	if(!writer.fFailed)
+	{
+		header.fImageSize = image_size;
+		header.fRelocationCount = relocation_count;
+		header.fNameCount = name_count;
+		header.fConstantCount = writer.fConstantCount;
+
+		char path[4096];
+		entry_path(path, sizeof(path), header.fContentDigest);
+		write_entry(path, &header, image, relocations, names, &writer);
+	}
+
+	if(image)
+		rlc_free((void**)&image);
+	rlc_vector_free((void**)&relocations);
+	rlc_vector_free((void**)&names);
+	rlc_vector_free((void**)&writer.fNames);
+	if(writer.fImage)
+	{
+		rlc_free((void**)&writer.fImage);
+		rlc_free((void**)&writer.fPointers);
+	}
+	rlc_vector_free((void**)&writer.fRanges);
+	rlc_vector_free((void**)&writer.fConstants);
+	rlc_vector_free((void**)&writer.fBlocks);
+}
+
+static int compare_stats(
+	void const * lhs,
+	void const * rhs)
+{
+	struct RlcParseCacheStat const * a = lhs, * b = rhs;
+	return strcmp(a->fName, b->fName);
+}
+
+void rlc_parse_cache_print_stats(
+	FILE * out)
+{
+	RLC_DASSERT(out != NULL);
+
+	pthread_mutex_lock(&s_lock);
+	if(s_stat_count)
+		qsort(s_stats, s_stat_count, sizeof(struct RlcParseCacheStat), &compare_stats);
+
+	size_t hits = 0;
+	for(size_t i = 0; i < s_stat_count; i++)
+	{
+		fprintf(out, "parse cache %s: %s\n",
+			s_stats[i].fHit ? "hit" : "miss",
+			s_stats[i].fName);
+		hits += s_stats[i].fHit;
+	}
+	fprintf(out, "parse cache: %zu hits, %zu misses.\n", hits, s_stat_count - hits);
+	pthread_mutex_unlock(&s_lock);
+}
+
+void rlc_parse_cache_free(void)
+{
+	pthread_mutex_lock(&s_lock);
+	for(size_t i = 0; i < s_stat_count; i++)
+		rlc_free((void**)&s_stats[i].fName);
+	rlc_vector_free((void**)&s_stats);
+	s_stat_count = 0;
+	pthread_mutex_unlock(&s_lock);
+
+	if(s_directory)
+		rlc_free((void**)&s_directory);
+}
@@ -0,0 +1,59 @@
+/** @file parsecache.h
+	Contains the on-disk cache of parsed files.
+	A cache entry holds a file's syntax tree as a compacted copy of the objects reachable from its roots, in which every pointer is replaced by its offset into the copy, a table of all pointer locations, and a table of all identifiers. Loading an entry maps it into memory, adds the mapping's address to each pointer, and interns each identifier, as identifier IDs differ between compiler runs. Entries are keyed by the SHA-256 digest of the file's contents and the compiler version, and store the digest to verify it, so changed files and rebuilt compilers never see stale entries. Source strings are indices into the file, so the source file is still read, but not tokenised or parsed. */
+#ifndef __rlc_parser_parsecache_h_defined
+#define __rlc_parser_parsecache_h_defined
+
+#include "../macros.h"
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct RlcParsedFile;
+
+/** Enables the parse cache.
+	Must be called before any file is parsed. Creates the cache directory if it does not exist.
+@param[in] directory:
+	The directory to store cache entries in.
+	@dassert @nonnull */
+void rlc_parse_cache_enable(
+	char const * directory);
+
+/** Loads a file's syntax tree from the parse cache.
+	Records a hit or miss for the file's statistics.
+@memberof RlcParsedFile
+@param[in,out] file:
+	The parsed file, whose source is already read, and whose syntax tree is still empty.
+	@dassert @nonnull
+@return
+	Whether the syntax tree was loaded. If the cache is disabled, fails. */
+_Nodiscard int rlc_parse_cache_load(
+	struct RlcParsedFile * file);
+
+/** Stores a file's syntax tree in the parse cache.
+	Does nothing if the cache is disabled. Files whose syntax tree cannot be stored are parsed again next time.
+@memberof RlcParsedFile
+@param[in] file:
+	The parsed file, which must not have any errors.
+	@dassert @nonnull */
+void rlc_parse_cache_store(
+	struct RlcParsedFile const * file);
+
+/** Prints which files were loaded from the parse cache, sorted by file name.
+@param[in] out:
+	The stream to print to.
+	@dassert @nonnull */
+void rlc_parse_cache_print_stats(
+	FILE * out);
+
+/** Disables the parse cache and releases its statistics. */
+void rlc_parse_cache_free(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,42 +1,39 @@
 #include "parser.h"
 
-#include "../malloc.h"
 #include "../assert.h"
+#include "../diagnostics.h"
 
-#include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
-#include <unistd.h>
+#include <stdint.h>
 
 void rlc_parser_create(
 	struct RlcParser * this,
-	struct RlcSrcFile const * file)
+	struct RlcSrcFile const * file,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(file != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_tokeniser_create(
-		&this->fTokeniser,
+	rlc_token_buffer_create(
+		&this->fTokens,
 		file);
 
 	this->fToken = 0;
 	this->fTracer = NULL;
+	this->fArena = arena;
+	this->fRecovery = NULL;
+	this->fErrorToken = SIZE_MAX;
 
-	if(rlc_tokeniser_read(&this->fTokeniser, &this->fLookahead[0]))
-	{
-		this->fEnd = !rlc_tokeniser_read(&this->fTokeniser, &this->fLookahead[1]);
-		this->fLookaheadSize = 2;
-	} else
-	{
-		this->fEnd = 1;
-		this->fLookaheadSize = 1;
-	}
+	this->fLookaheadSize = rlc_token_buffer_has(&this->fTokens, 0)
+		+ rlc_token_buffer_has(&this->fTokens, 1);
 }
 
 struct RlcSrcFile const * rlc_parser_file(
-	struct RlcParser * this)
+	struct RlcParser const * this)
 {
-	return this->fTokeniser.fSource;
+	return this->fTokens.fTokeniser.fSource;
 }
 
 void rlc_parser_destroy(
@@ -44,26 +41,20 @@ void rlc_parser_destroy(
 {
 	RLC_DASSERT(this != NULL);
 
+	RLC_DASSERT(this->fRecovery == NULL);
+
 	if(!rlc_parser_eof(this))
 	{
-		struct RlcSrcPosition pos;
-		rlc_src_file_position(
-			this->fTokeniser.fSource,
-			&pos,
-			rlc_parser_index(this));
-
-		fprintf(stderr, "%s:%u:%u: error: unexpected '%s'.\n",
-			this->fTokeniser.fSource->fName,
-			pos.line,
-			pos.column,
-			rlc_src_string_cstr(
-				&rlc_parser_current(this)->content,
-				this->fTokeniser.fSource));
-
-		fflush(stderr);
-		fflush(stdout);
-		exit(EXIT_FAILURE);
+		struct RlcToken const current = rlc_parser_current(this);
+		rlc_diagnostics_error(
+			rlc_parser_file(this),
+			current.content.start,
+			"unexpected '%.*s'.",
+			(int) current.content.length,
+			&rlc_parser_file(this)->fContents[current.content.start]);
 	}
+
+	rlc_token_buffer_destroy(&this->fTokens);
 }
 
 void rlc_parser_trace(
@@ -107,7 +98,7 @@ RlcSrcIndex rlc_parser_index(
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(!rlc_parser_eof(this));
 
-	return rlc_parser_current(this)->content.start;
+	return rlc_parser_current(this).content.start;
 }
 
 int rlc_parser_is_current(
@@ -118,7 +109,7 @@ int rlc_parser_is_current(
 	if(rlc_parser_eof(this))
 		return 0;
 	else
-		return rlc_parser_current(this)->type == type;
+		return rlc_token_buffer_type(&this->fTokens, this->fToken) == type;
 }
 
 int rlc_parser_is_ahead(
@@ -129,50 +120,165 @@ int rlc_parser_is_ahead(
 	if(rlc_parser_ahead_eof(this))
 		return 0;
 	else
-		return rlc_parser_ahead(this)->type == type;
+		return rlc_token_buffer_type(&this->fTokens, this->fToken + 1) == type;
 }
 
-_Noreturn void rlc_parser_fail(
-	struct RlcParser * parser,
-	char const * reason)
+int rlc_parser_is_lookahead(
+	struct RlcParser * this,
+	size_t n,
+	enum RlcTokenType type)
+{
+	RLC_DASSERT(this != NULL);
+	if(!rlc_token_buffer_has(&this->fTokens, this->fToken + n))
+		return 0;
+	else
+		return rlc_token_buffer_type(&this->fTokens, this->fToken + n) == type;
+}
+
+/** Skips the rest of a failed entry.
+	Skips up to and including the next `;` or block at the entry's brace depth. Stops before a `}` that closes a block enclosing the entry.
+@param[in] start:
+	The index of the token that started the entry. */
+static void synchronise(
+	struct RlcParser * this,
+	size_t start)
 {
-	fflush(stdout);
-	fflush(stderr);
-	struct RlcSrcPosition pos;
-	if(rlc_parser_eof(parser))
+	// Blocks that the entry opened before the error still have to be closed.
+	size_t depth = 0;
+	for(size_t i = start; i < this->fToken; i++)
+		switch(rlc_token_buffer_type(&this->fTokens, i))
+		{
+		case kRlcTokBraceOpen: ++depth; break;
+		case kRlcTokBraceClose: if(depth) --depth; break;
+		default:;
+		}
+
+	while(!rlc_parser_eof(this))
 	{
-		rlc_src_file_position(
-			parser->fTokeniser.fSource,
-			&pos,
-			parser->fTokeniser.fSource->fContentLength);
-
-		fprintf(stderr, "%s:%u:%u: error: unexpected end of file in %s: %s.\n",
-			parser->fTokeniser.fSource->fName,
-			pos.line,
-			pos.column,
-			rlc_parser_context(parser),
-			reason);
+		enum RlcTokenType const type = rlc_token_buffer_type(
+			&this->fTokens,
+			this->fToken);
+		if(type == kRlcTokBraceClose && !depth)
+			break;
+
+		rlc_parser_skip(this);
+		if(type == kRlcTokBraceOpen)
+			++depth;
+		else if(type == kRlcTokBraceClose && !--depth)
+		{
+			if(rlc_parser_is_current(this, kRlcTokSemicolon))
+				rlc_parser_skip(this);
+			break;
+		} else if(type == kRlcTokSemicolon && !depth)
+			break;
+	}
+
+	// Always make progress, so that the same entry does not fail again.
+	if(this->fToken == start && !rlc_parser_eof(this))
+		rlc_parser_skip(this);
+}
+
+/** Resumes parsing at the innermost recovery point. */
+static _Noreturn void recover(
+	struct RlcParser * this)
+{
+	struct RlcParserRecovery * recovery = this->fRecovery;
+	if(!recovery)
+		rlc_diagnostics_fail();
+
+	// Nothing follows the end of the file, so all entries are abandoned.
+	if(rlc_parser_eof(this))
+		while(recovery->fPrevious)
+			recovery = recovery->fPrevious;
+	else
+		synchronise(this, recovery->fToken);
+
+	this->fRecovery = recovery;
+	this->fTracer = recovery->fTracer;
+	longjmp(recovery->fJump, 1);
+}
+
+/** Whether an error at the current token should be reported.
+	Errors at the end of a file that the tokeniser could not finish are caused by the tokeniser's error, which is reported already. */
+static int should_report(
+	struct RlcParser * this)
+{
+	if(this->fToken == this->fErrorToken)
+		return 0;
+	this->fErrorToken = this->fToken;
+
+	return !rlc_parser_eof(this) || !this->fTokens.fTokeniser.fError;
+}
+
+/** Reports an error at the current token, without a period. */
+static void report(
+	struct RlcParser * this,
+	char const * message)
+{
+	struct RlcSrcFile const * file = rlc_parser_file(this);
+	if(rlc_parser_eof(this))
+	{
+		rlc_diagnostics_error(
+			file,
+			file->fContentLength,
+			"unexpected end of file in %s: %s.",
+			rlc_parser_context(this),
+			message);
 	} else
 	{
-		rlc_src_file_position(
-			parser->fTokeniser.fSource,
-			&pos,
-			rlc_parser_index(parser));
-
-		fprintf(stderr, "%s:%u:%u: error: unexpected '%s' in %s: %s.\n",
-			parser->fTokeniser.fSource->fName,
-			pos.line,
-			pos.column,
-			rlc_src_string_cstr(
-				&rlc_parser_current(parser)->content,
-				parser->fTokeniser.fSource),
-			rlc_parser_context(parser),
-			reason);
+		struct RlcToken const current = rlc_parser_current(this);
+		rlc_diagnostics_error(
+			file,
+			current.content.start,
+			"unexpected '%.*s' in %s: %s.",
+			(int) current.content.length,
+			&file->fContents[current.content.start],
+			rlc_parser_context(this),
+			message);
 	}
+}
 
-	fflush(stderr);
-	fflush(stdout);
-	exit(EXIT_FAILURE);
+void rlc_parser_recovery_push(
+	struct RlcParser * this,
+	struct RlcParserRecovery * recovery)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(recovery != NULL);
+
+	recovery->fPrevious = this->fRecovery;
+	recovery->fTracer = this->fTracer;
+	recovery->fToken = this->fToken;
+	this->fRecovery = recovery;
+}
+
+void rlc_parser_recovery_mark(
+	struct RlcParser const * this,
+	struct RlcParserRecovery * recovery)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(recovery == this->fRecovery);
+
+	recovery->fToken = this->fToken;
+}
+
+void rlc_parser_recovery_pop(
+	struct RlcParser * this,
+	struct RlcParserRecovery * recovery)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(recovery == this->fRecovery);
+
+	this->fRecovery = recovery->fPrevious;
+}
+
+_Noreturn void rlc_parser_fail(
+	struct RlcParser * parser,
+	char const * reason)
+{
+	if(should_report(parser))
+		report(parser, reason);
+
+	recover(parser);
 }
 
 int rlc_parser_consume(
@@ -189,7 +295,7 @@ int rlc_parser_consume(
 	if(ret)
 	{
 		if(token)
-			*token = *rlc_parser_current(this);
+			*token = rlc_parser_current(this);
 		rlc_parser_skip(this);
 	}
 
@@ -204,76 +310,44 @@ enum RlcTokenType rlc_parser_expect(
 {
 	RLC_DASSERT(count >= 1);
 
-	struct RlcSrcPosition pos;
-	if(rlc_parser_eof(this))
-	{
-		fflush(stdout);
-		usleep(125 * 1000);
-		rlc_src_file_position(
-			this->fTokeniser.fSource,
-			&pos,
-			this->fTokeniser.fSource->fContentLength);
-
-		fprintf(stderr, "%s:%u:%u: error: unexpected end of file",
-			this->fTokeniser.fSource->fName,
-			pos.line,
-			pos.column);
-		goto print_expected;
-	}
-
 	va_list args;
 	va_start(args, types);
 
-	size_t const count_ = count;
 	enum RlcTokenType type = types;
-
-	while(count--)
+	for(size_t i = 0; i < count; i++)
 	{
+		if(i)
+			type = va_arg(args, enum RlcTokenType);
 		if(rlc_parser_consume(this, token, type))
+		{
+			va_end(args);
 			return type;
-		if(count)
-			type = va_arg(args, enum RlcTokenType);
+		}
 	}
+	va_end(args);
 
-	fflush(stdout);
-	usleep(125 * 1000);
-
-	rlc_src_file_position(
-		this->fTokeniser.fSource,
-		&pos,
-		rlc_parser_index(this));
-
-	fprintf(stderr, "%s:%u:%u: error: unexpected '%s'",
-		this->fTokeniser.fSource->fName,
-		pos.line,
-		pos.column,
-		rlc_src_string_cstr(
-			&rlc_parser_current(this)->content,
-			this->fTokeniser.fSource));
-
-print_expected:
-	fprintf(stderr, " in %s: expected %s",
-		rlc_parser_context(this),
-		rlc_token_type_name(types));
-
-	type = types;
-	va_start(args, types);
-	for(size_t i = 1; i < count_; i++)
+	if(should_report(this))
 	{
-		type = va_arg(args, enum RlcTokenType);
-		fprintf(
-			stderr,
-			(i == count_-1)
-				? ", or %s"
-				: ", %s",
-			rlc_token_type_name(type));
+		char expected[256];
+		int length = snprintf(expected, sizeof(expected),
+			"expected %s",
+			rlc_token_type_name(types));
+
+		va_start(args, types);
+		for(size_t i = 1; i < count && length < (int)sizeof(expected); i++)
+			length += snprintf(
+				expected + length,
+				sizeof(expected) - length,
+				(i == count-1)
+					? ", or %s"
+					: ", %s",
+				rlc_token_type_name(va_arg(args, enum RlcTokenType)));
+		va_end(args);
+
+		report(this, expected);
 	}
 
-	fputs(".\n", stderr);
-	fflush(stdout);
-	fflush(stderr);
-
-	exit(EXIT_FAILURE);
+	recover(this);
 }
 
 void rlc_parser_skip(
@@ -282,15 +356,15 @@ void rlc_parser_skip(
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(!rlc_parser_eof(this));
 
-	if(this->fEnd)
+	if(this->fLookaheadSize == 2)
+		this->fLookaheadSize = 1 + rlc_token_buffer_has(
+			&this->fTokens,
+			++this->fToken + 1);
+	else
 	{
-		this->fLookaheadSize--;
-	} else {
-		this->fEnd = !rlc_tokeniser_read(
-			&this->fTokeniser,
-			&this->fLookahead[this->fToken]);
+		++this->fToken;
+		this->fLookaheadSize = 0;
 	}
-	this->fToken ^= 1;
 }
 
 _Nodiscard int rlc_parser_equal_tokens(
@@ -303,7 +377,7 @@ _Nodiscard int rlc_parser_equal_tokens(
 	RLC_DASSERT(rhs != NULL);
 
 	return 0 == rlc_src_string_cmp(
-		parser->fTokeniser.fSource,
+		rlc_parser_file(parser),
 		&lhs->content,
 		&rhs->content);
 }
\ No newline at end of file
@@ -4,8 +4,10 @@
 #define __rlc_parser_parser_h_defined
 
 #include <stddef.h>
+#include <setjmp.h>
 
-#include "../tokeniser/tokeniser.h"
+#include "../tokeniser/tokenbuffer.h"
+#include "../arena.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -20,21 +22,37 @@ struct RlcParserTracer
 	char const * fContext;
 };
 
+/** A point at which the parser resumes after a syntax error.
+	Recovery points are set around the parsing of statements and scope entries. After an error, the parser skips the rest of the failed entry, and jumps back to the innermost recovery point, which continues with the next entry. */
+struct RlcParserRecovery
+{
+	/** The enclosing recovery point. */
+	struct RlcParserRecovery * fPrevious;
+	/** The parser's context when the recovery point was set. */
+	struct RlcParserTracer * fTracer;
+	/** The index of the token that started the current entry. */
+	size_t fToken;
+	/** The jump target, set by `setjmp()` before each entry. */
+	jmp_buf fJump;
+};
+
 /** The parser state. */
 struct RlcParser
 {
-	/** The token stream. */
-	struct RlcTokeniser fTokeniser;
-	/** The LL(2) token buffer. */
-	struct RlcToken fLookahead[2];
-	/** The amount of tokens in the buffer. */
+	/** The pre-tokenised file. */
+	struct RlcTokenBuffer fTokens;
+	/** The current token's index in the buffer. */
+	size_t fToken;
+	/** How many of the current and next token exist. */
 	uint8_t fLookaheadSize;
-	/** The current index in the buffer.*/
-	uint8_t fToken;
-	/** Whether the end of the token stream has been reached. */
-	uint8_t fEnd;
 	/** The parser's tracer. */
 	struct RlcParserTracer * fTracer;
+	/** The arena that parsed data is allocated from. */
+	struct RlcArena * fArena;
+	/** The innermost recovery point, if any. Without one, errors terminate the program. */
+	struct RlcParserRecovery * fRecovery;
+	/** The index of the token at which the last error was reported. Suppresses repeated errors at the same token. */
+	size_t fErrorToken;
 };
 
 /** Creates a parser for a file.
@@ -44,13 +62,17 @@ struct RlcParser
 	@dassert @nonnull
 @param[in] file:
 	The file to parse.
+	@dassert @nonnull
+@param[in] arena:
+	The arena that parsed data is allocated from.
 	@dassert @nonnull */
 void rlc_parser_create(
 	struct RlcParser * this,
-	struct RlcSrcFile const * file);
+	struct RlcSrcFile const * file,
+	struct RlcArena * arena);
 
 struct RlcSrcFile const * rlc_parser_file(
-	struct RlcParser * this);
+	struct RlcParser const * this);
 
 /** Destroys parser data.
 @memberof RlcParser
@@ -88,17 +110,17 @@ _Nodiscard static inline int rlc_parser_eof(
 _Nodiscard static inline int rlc_parser_ahead_eof(
 	struct RlcParser const * this);
 
-/** Returns the address of the current token, if not at the end of the token stream.
+/** Returns the current token, if not at the end of the token stream.
 @memberof RlcParser
 @param[in] this:
 	The parser data.
 	@dassert @nonnull */
-_Nodiscard static inline struct RlcToken const * rlc_parser_current(
+_Nodiscard static inline struct RlcToken rlc_parser_current(
 	struct RlcParser const * this);
 
 /** Retrieves the parser's next token.
 @memberof RlcParser */
-_Nodiscard static inline struct RlcToken const * rlc_parser_ahead(
+_Nodiscard static inline struct RlcToken rlc_parser_ahead(
 	struct RlcParser const * this);
 
 /** Retrieves the parser's current source index.
@@ -123,7 +145,62 @@ _Nodiscard int rlc_parser_is_ahead(
 	struct RlcParser const * this,
 	enum RlcTokenType type);
 
-/** Terminates with an error message.
+/** Checks whether the token `n` tokens after the current token is the requested type.
+	Unlike `rlc_parser_is_current()` and `rlc_parser_is_ahead()`, this can look arbitrarily far ahead.
+@memberof RlcParser
+@param[in] this:
+	The parser data.
+	@dassert @nonnull
+@param[in] n:
+	How many tokens to look ahead.
+@param[in] type:
+	The token type to match.
+@return
+	Nonzero if matched. */
+_Nodiscard int rlc_parser_is_lookahead(
+	struct RlcParser * this,
+	size_t n,
+	enum RlcTokenType type);
+
+/** Enters a recovery point.
+	Before parsing each entry, call `rlc_parser_recovery_mark()`, followed by `setjmp(recovery->fJump)`, which returns nonzero after an error in the entry was recovered from.
+@memberof RlcParser
+@param[in,out] this:
+	The parser data.
+	@dassert @nonnull
+@param[out] recovery:
+	The recovery point to enter. Must stay alive until it is left.
+	@dassert @nonnull */
+void rlc_parser_recovery_push(
+	struct RlcParser * this,
+	struct RlcParserRecovery * recovery);
+
+/** Marks the start of an entry.
+@memberof RlcParser
+@param[in] this:
+	The parser data.
+	@dassert @nonnull
+@param[in,out] recovery:
+	The parser's innermost recovery point.
+	@dassert @nonnull */
+void rlc_parser_recovery_mark(
+	struct RlcParser const * this,
+	struct RlcParserRecovery * recovery);
+
+/** Leaves a recovery point.
+@memberof RlcParser
+@param[in,out] this:
+	The parser data.
+	@dassert @nonnull
+@param[in] recovery:
+	The parser's innermost recovery point.
+	@dassert @nonnull */
+void rlc_parser_recovery_pop(
+	struct RlcParser * this,
+	struct RlcParserRecovery * recovery);
+
+/** Reports a syntax error and recovers from it.
+	Jumps to the innermost recovery point, or terminates the program if there is none.
 @memberof RlcParser */
 _Noreturn void rlc_parser_fail(
 	struct RlcParser * parser,
@@ -146,7 +223,7 @@ _Nodiscard int rlc_parser_consume(
 	enum RlcTokenType type);
 
 /** Tries to match a token of any of the given types, and on success, consumes it.
-	On failure, displays an error message and aborts the program.
+	On failure, reports an error and recovers from it, like `rlc_parser_fail()`.
 @memberof RlcParser
 @param[in,out] this:
 	The parser data.
@@ -14,20 +14,20 @@ int rlc_parser_ahead_eof(
 	return this->fLookaheadSize != 2;
 }
 
-struct RlcToken const * rlc_parser_current(
+struct RlcToken rlc_parser_current(
 	struct RlcParser const * this)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(!rlc_parser_eof(this));
 
-	return &this->fLookahead[this->fToken];
+	return rlc_token_buffer_get(&this->fTokens, this->fToken);
 }
 
-struct RlcToken const * rlc_parser_ahead(
+struct RlcToken rlc_parser_ahead(
 	struct RlcParser const * this)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(this->fLookaheadSize == 2);
 
-	return &this->fLookahead[this->fToken ^ 1];
+	return rlc_token_buffer_get(&this->fTokens, this->fToken + 1);
 }
\ No newline at end of file
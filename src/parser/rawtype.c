@@ -1,7 +1,6 @@
 #include "rawtype.h"
 
 #include "../assert.h"
-#include "../malloc.h"
 
 void rlc_parsed_rawtype_create(
 	struct RlcParsedRawtype * this,
@@ -20,26 +19,6 @@ void rlc_parsed_rawtype_create(
 	this->fTemplates = *templates;
 }
 
-void rlc_parsed_rawtype_destroy(
-	struct RlcParsedRawtype * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fSize)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fSize);
-		rlc_free((void**)&this->fSize);
-	}
-
-	rlc_parsed_member_list_destroy(&this->fMembers);
-
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-
-	rlc_parsed_template_decl_destroy(
-		&this->fTemplates);
-}
-
 int rlc_parsed_rawtype_parse(
 	struct RlcParsedRawtype * out,
 	struct RlcParser * parser,
@@ -107,7 +86,8 @@ int rlc_parsed_rawtype_parse(
 
 		rlc_parsed_member_list_add(
 			&out->fMembers,
-			member);
+			member,
+			parser->fArena);
 	}
 
 	rlc_parser_untrace(parser, &tracer);
@@ -163,18 +143,6 @@ void rlc_parsed_member_rawtype_create(
 		member);
 }
 
-void rlc_parsed_member_rawtype_destroy(
-	struct RlcParsedMemberRawtype * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_rawtype_destroy(
-		RLC_BASE_CAST(this, RlcParsedRawtype));
-
-	rlc_parsed_member_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedMember));
-}
-
 int rlc_parsed_member_rawtype_parse(
 	struct RlcParsedMemberRawtype * out,
 	struct RlcParser * parser,
@@ -40,14 +40,6 @@ void rlc_parsed_rawtype_create(
 	struct RlcSrcString const * name,
 	struct RlcParsedTemplateDecl const * templates);
 
-/** Destroys a parsed rawtype.
-@memberof RlcParsedRawtype
-@param[in,out] this:
-	The rawtype to destroy.
-	@dassert @nonnull */
-void rlc_parsed_rawtype_destroy(
-	struct RlcParsedRawtype * this);
-
 /** Parses a rawtype.
 @memberof RlcParsedRawtype
 @param[out] out:
@@ -81,9 +73,6 @@ void rlc_parsed_member_rawtype_create(
 	struct RlcParsedMemberRawtype * this,
 	struct RlcParsedMemberCommon const * member);
 
-void rlc_parsed_member_rawtype_destroy(
-	struct RlcParsedMemberRawtype * this);
-
 _Nodiscard int rlc_parsed_member_rawtype_parse(
 	struct RlcParsedMemberRawtype * out,
 	struct RlcParser * parser,
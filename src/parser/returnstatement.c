@@ -1,6 +1,5 @@
 #include "returnstatement.h"
 #include "../assert.h"
-#include "../malloc.h"
 #include "../tokeniser/tokens.h"
 
 void rlc_parsed_return_statement_create(
@@ -14,22 +13,6 @@ void rlc_parsed_return_statement_create(
 	this->fExpression = NULL;
 }
 
-void rlc_parsed_return_statement_destroy(
-	struct RlcParsedReturnStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(RLC_DERIVING_TYPE(RLC_BASE_CAST(this,RlcParsedStatement)) == kRlcParsedReturnStatement);
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-
-	if(this->fExpression)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fExpression);
-		rlc_free((void**)&this->fExpression);
-	}
-}
-
 static _Thread_local int forbidden = 0;
 
 int rlc_parsed_return_statement_parse(
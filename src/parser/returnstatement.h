@@ -19,9 +19,6 @@ struct RlcParsedReturnStatement
 void rlc_parsed_return_statement_create(
 	struct RlcParsedReturnStatement * this);
 
-void rlc_parsed_return_statement_destroy(
-	struct RlcParsedReturnStatement * this);
-
 int rlc_parsed_return_statement_parse(
 	struct RlcParsedReturnStatement * out,
 	struct RlcParser * parser);
@@ -15,66 +15,9 @@
 #include "../macros.h"
 #include "../assert.h"
 
-#include "../malloc.h"
+#include "../vector.h"
 
-#include <string.h>
-
-void rlc_parsed_scope_entry_destroy_base(
-	struct RlcParsedScopeEntry * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	;
-}
-
-
-void rlc_parsed_scope_entry_destroy_virtual(
-	struct RlcParsedScopeEntry * this)
-{
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(RLC_IN_ENUM(RLC_DERIVING_TYPE(this), RlcParsedScopeEntryType));
-
-	typedef void (*destructor_t)(
-		void * this);
-	static destructor_t const k_vtable[] = {
-		(destructor_t)&rlc_parsed_class_destroy,
-		(destructor_t)&rlc_parsed_mask_destroy,
-		(destructor_t)&rlc_parsed_rawtype_destroy,
-		(destructor_t)&rlc_parsed_union_destroy,
-		(destructor_t)&rlc_parsed_namespace_destroy,
-		(destructor_t)&rlc_parsed_function_destroy,
-		(destructor_t)&rlc_parsed_variable_destroy,
-		(destructor_t)&rlc_parsed_enum_destroy,
-		(destructor_t)&rlc_parsed_enum_constant_destroy,
-		(destructor_t)&rlc_parsed_typedef_destroy,
-		(destructor_t)&rlc_parsed_external_symbol_destroy,
-		(destructor_t)&rlc_parsed_test_destroy
-	};
-
-	static_assert(RLC_COVERS_ENUM(k_vtable, RlcParsedScopeEntryType), "ill-sized vtable.");
-
-	static intptr_t const k_offsets[] = {
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedClass),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedMask),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedRawtype),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedUnion),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedNamespace),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedFunction),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedVariable),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedEnum),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedEnumConstant),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedTypedef),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedExternalSymbol),
-		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct RlcParsedTest)
-	};
-
-	static_assert(RLC_COVERS_ENUM(k_offsets, RlcParsedScopeEntryType), "ill-sized offset table.");
-
-	uint8_t * p = (uint8_t*)this + k_offsets[RLC_DERIVING_TYPE(this)];
-	k_vtable[RLC_DERIVING_TYPE(this)](p);
-
-	rlc_free((void**)&p);
-}
+#include <stdint.h>
 
 void rlc_parsed_scope_entry_create(
 	struct RlcParsedScopeEntry * this,
@@ -129,36 +72,52 @@ static int dummy_rlc_parsed_function_parse(
 }
 
 
+/** The FIRST sets of the scope entries, indexed by token type. Scope entries starting with an identifier are looked up in `k_after_identifier` instead. */
+static int const k_first[RLC_COUNT(RlcTokenType)] = {
+	[kRlcTokLess] = RLC_FLAG(kRlcParsedFunction),
+	[kRlcTokThis] = RLC_FLAG(kRlcParsedFunction),
+	[kRlcTokMask] = RLC_FLAG(kRlcParsedMask),
+	[kRlcTokUnion] = RLC_FLAG(kRlcParsedUnion),
+	[kRlcTokParentheseOpen] = RLC_FLAG(kRlcParsedRawtype),
+	[kRlcTokType] = RLC_FLAG(kRlcParsedTypedef),
+	[kRlcTokDoubleColon] = RLC_FLAG(kRlcParsedNamespace),
+	[kRlcTokEnum] = RLC_FLAG(kRlcParsedEnum),
+	[kRlcTokExtern] = RLC_FLAG(kRlcParsedExternalSymbol),
+	[kRlcTokTest] = RLC_FLAG(kRlcParsedTest)
+};
+
+/** The scope entries starting with an identifier, indexed by the type of the token after the identifier. */
+static int const k_after_identifier[RLC_COUNT(RlcTokenType)] = {
+	[kRlcTokColon] = RLC_FLAG(kRlcParsedVariable),
+	[kRlcTokColonEqual] = RLC_FLAG(kRlcParsedVariable),
+	[kRlcTokDoubleColonEqual] = RLC_FLAG(kRlcParsedVariable),
+	[kRlcTokHash] = RLC_FLAG(kRlcParsedVariable),
+	[kRlcTokDollar] = RLC_FLAG(kRlcParsedVariable),
+	[kRlcTokParentheseOpen] = RLC_FLAG(kRlcParsedFunction),
+	[kRlcTokBraceOpen] = RLC_FLAG(kRlcParsedClass),
+	[kRlcTokMinusGreater] = RLC_FLAG(kRlcParsedClass),
+	[kRlcTokVirtual] = RLC_FLAG(kRlcParsedClass)
+};
+
 struct RlcParsedScopeEntry * rlc_parsed_scope_entry_parse(
 	struct RlcParser * parser)
 {
 	RLC_DASSERT(parser != NULL);
 
-	union Pack {
-		struct RlcParsedVariable fVariable;
-		struct RlcParsedFunction fFunction;
-		struct RlcParsedClass fClass;
-		struct RlcParsedUnion fUnion;
-		struct RlcParsedRawtype fRawtype;
-		struct RlcParsedTypedef fTypedef;
-		struct RlcParsedNamespace fNamespace;
-		struct RlcParsedEnum fEnum;
-		struct RlcParsedExternalSymbol fExternalSymbol;
-		struct RlcParsedTest fTest;
-	} pack;
-
 	typedef int (*parse_fn_t)(
-		union Pack *,
+		void *,
 		struct RlcParser *,
 		struct RlcParsedTemplateDecl const * templates);
 
 
 #define ENTRY(Type, parse) { \
+		k ## Type, \
 		(parse_fn_t)parse, \
 		sizeof(struct Type), \
 		RLC_DERIVE_OFFSET(RlcParsedScopeEntry, struct Type) }
 
 	static struct {
+		enum RlcParsedScopeEntryType fType;
 		parse_fn_t fParseFn;
 		size_t fTypeSize;
 		size_t fOffset;
@@ -185,23 +144,43 @@ struct RlcParsedScopeEntry * rlc_parsed_scope_entry_parse(
 		&templates,
 		parser);
 
-	for(size_t i = 0; i < _countof(k_parse_lookup); i++)
+	if(rlc_parser_eof(parser))
+		return NULL;
+
+	// Only try the scope entries that can start with the current and next token.
+	enum RlcTokenType const first = rlc_parser_current(parser).type;
+	int candidates = k_first[first];
+	if(!rlc_parser_ahead_eof(parser))
 	{
-		if(k_parse_lookup[i].fParseFn
-		&& k_parse_lookup[i].fParseFn(
-			&pack,
-			parser,
-			&templates))
-		{
-			void * temp = NULL;
-			rlc_malloc(&temp, k_parse_lookup[i].fTypeSize);
+		enum RlcTokenType const second = rlc_parser_ahead(parser).type;
+		if(first == kRlcTokIdentifier)
+			candidates = k_after_identifier[second];
+		// Operators are named by the token before `this`.
+		if(second == kRlcTokThis)
+			candidates |= RLC_FLAG(kRlcParsedFunction);
+	}
 
-			memcpy(temp, &pack, k_parse_lookup[i].fTypeSize);
+	// Parse directly into the arena. Parsers that fail consume no tokens, so the memory is reused by the next candidate.
+	void * node = NULL;
+	size_t node_size = 0;
 
-			struct RlcParsedScopeEntry * ret;
-			ret = (void*) ((uint8_t*)temp + k_parse_lookup[i].fOffset);
-			return ret;
+	for(size_t i = 0; candidates; i++)
+	{
+		RLC_DASSERT(i < _countof(k_parse_lookup));
+		if(!(RLC_FLAG(k_parse_lookup[i].fType) & candidates))
+			continue;
+		candidates &= ~RLC_FLAG(k_parse_lookup[i].fType);
+
+		RLC_DASSERT(k_parse_lookup[i].fParseFn != NULL);
+		if(node_size < k_parse_lookup[i].fTypeSize)
+		{
+			node = NULL;
+			node_size = k_parse_lookup[i].fTypeSize;
+			rlc_arena_malloc(parser->fArena, &node, node_size);
 		}
+
+		if(k_parse_lookup[i].fParseFn(node, parser, &templates))
+			return (void*) ((uint8_t*)node + k_parse_lookup[i].fOffset);
 	}
 
 	return NULL;
@@ -268,28 +247,14 @@ void rlc_parsed_scope_entry_list_create(
 
 void rlc_parsed_scope_entry_list_add(
 	struct RlcParsedScopeEntryList * this,
-	struct RlcParsedScopeEntry * entry)
+	struct RlcParsedScopeEntry * entry,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(entry != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fEntries,
-		sizeof(struct RlcParsedScopeEntry *) * ++this->fEntryCount);
-
-	this->fEntries[this->fEntryCount -1] = entry;
-}
-
-void rlc_parsed_scope_entry_list_destroy(
-	struct RlcParsedScopeEntryList * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	for(size_t i = 0; i < this->fEntryCount; i++)
-		rlc_parsed_scope_entry_destroy_virtual(this->fEntries[i]);
-	this->fEntryCount = 0;
-	if(this->fEntries)
-		rlc_free((void**)&this->fEntries);
+	RLC_VECTOR_PUSH(arena, this->fEntries, this->fEntryCount) = entry;
 }
 
 void rlc_parsed_scope_entry_list_print(
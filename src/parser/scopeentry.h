@@ -55,23 +55,6 @@ struct RlcParsedScopeEntry
 	struct RlcSrcString fName;
 };
 
-/** Destroys a parsed scope entry.
-	This function should only be called by deriving types in their destructor function.
-@memberof RlcParsedScopeEntry
-@param[in,out] this:
-	The parsed scope entry to destroy.
-	@dassert @nonnull */
-void rlc_parsed_scope_entry_destroy_base(
-	struct RlcParsedScopeEntry * this);
-
-/** Looks up the derived type and destroys it.
-@memberof RlcParsedScopeEntry
-@param[in,out] this:
-	The parsed scope entry to destroy.
-	@dassert @nonnull */
-void rlc_parsed_scope_entry_destroy_virtual(
-	struct RlcParsedScopeEntry * this);
-
 /** Creates an empty scope entry.
 @param[in,out] this:
 	The parsed scope entry to create.
@@ -126,18 +109,14 @@ void rlc_parsed_scope_entry_list_create(
 	The list to add an entry to.
 	@dassert @nonnull
 @param[in] entry:
-	The entry to add. @pass_pointer_ownership */
+	The entry to add. @pass_pointer_ownership
+@param[in,out] arena:
+	The arena to allocate from.
+	@dassert @nonnull */
 void rlc_parsed_scope_entry_list_add(
 	struct RlcParsedScopeEntryList * list,
-	struct RlcParsedScopeEntry * entry);
-
-/** Destroys a scope entry list.
-@memberof RlcParsedScopeEntryList
-@param[in,out] this:
-	The scope entry list to destroy.
-	@dassert @nonnull */
-void rlc_parsed_scope_entry_list_destroy(
-	struct RlcParsedScopeEntryList * this);
+	struct RlcParsedScopeEntry * entry,
+	struct RlcArena * arena);
 
 void rlc_parsed_scope_entry_list_print(
 	struct RlcParsedScopeEntryList const * this,
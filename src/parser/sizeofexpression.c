@@ -1,6 +1,5 @@
 #include "sizeofexpression.h"
 #include "../assert.h"
-#include "../malloc.h"
 
 void rlc_parsed_sizeof_expression_create(
 	struct RlcParsedSizeofExpression * this,
@@ -12,25 +11,8 @@ void rlc_parsed_sizeof_expression_create(
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedSizeofExpression,
-		start,
-		end);
-}
-
-void rlc_parsed_sizeof_expression_destroy(
-	struct RlcParsedSizeofExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedExpression));
-
-	if(this->fIsType)
-		rlc_parsed_type_name_destroy(&this->fType);
-	else if(this->fExpression)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fExpression);
-		rlc_free((void**)&this->fExpression);
-	}
+		start.content.start,
+		rlc_src_string_end(&end.content));
 }
 
 int rlc_parsed_sizeof_expression_parse(
@@ -37,14 +37,6 @@ void rlc_parsed_sizeof_expression_create(
 	struct RlcToken start,
 	struct RlcToken end);
 
-/** Destroys a sizeof expression.
-@memberof RlcParsedSizeofExpression
-@param[in,out] this:
-	The sizeof expression to destroy.
-	@dassert @nonull */
-void rlc_parsed_sizeof_expression_destroy(
-	struct RlcParsedSizeofExpression * this);
-
 /** Parses a sizeof expression.
 @memberof RlcParsedSizeofExpression
 @param[out] out:
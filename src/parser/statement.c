@@ -14,11 +14,10 @@
 #include "throwstatement.h"
 
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 
 #include <stdint.h>
-#include <string.h>
 
 void rlc_parsed_statement_create(
 	struct RlcParsedStatement * this,
@@ -28,68 +27,29 @@ void rlc_parsed_statement_create(
 	RLC_DERIVING_TYPE(this) = type;
 }
 
-void rlc_parsed_statement_destroy_base(
-	struct RlcParsedStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-	;
-}
-
-void rlc_parsed_statement_destroy_virtual(
-	struct RlcParsedStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	typedef void (*thiscall_t) (
-		void * this);
-
-#define ENTRY(type, fn) { \
-		(thiscall_t)&fn, \
-		RLC_DERIVE_OFFSET(RlcParsedStatement, struct RlcParsed##type) \
-	}
-	static struct Destructor {
-		thiscall_t fAddress;
-		ptrdiff_t fOffset;
-	} const k_vtable[] = {
-		ENTRY(AssertStatement, rlc_parsed_assert_statement_destroy),
-		ENTRY(ExpressionStatement, rlc_parsed_expression_statement_destroy),
-		ENTRY(BlockStatement, rlc_parsed_block_statement_destroy),
-		ENTRY(IfStatement, rlc_parsed_if_statement_destroy),
-		ENTRY(LoopStatement, rlc_parsed_loop_statement_destroy),
-		ENTRY(VariableStatement, rlc_parsed_variable_statement_destroy),
-		ENTRY(ReturnStatement, rlc_parsed_return_statement_destroy),
-		ENTRY(SwitchStatement, rlc_parsed_switch_statement_destroy),
-		ENTRY(CaseStatement, rlc_parsed_case_statement_destroy),
-		ENTRY(BreakStatement, rlc_parsed_break_statement_destroy),
-		ENTRY(ContinueStatement, rlc_parsed_continue_statement_destroy),
-		ENTRY(TryStatement, rlc_parsed_try_statement_destroy),
-		ENTRY(ThrowStatement, rlc_parsed_throw_statement_destroy),
-		ENTRY(CatchStatement, rlc_parsed_catch_statement_destroy)
-	};
-#undef ENTRY
-
-	static_assert(RLC_COVERS_ENUM(k_vtable, RlcParsedStatementType), "ill-sized vtable.");
-
-	RLC_DASSERT(RLC_IN_ENUM(RLC_DERIVING_TYPE(this), RlcParsedStatementType));
-
-	k_vtable[RLC_DERIVING_TYPE(this)].fAddress(
-		(void*)((uintptr_t)this + k_vtable[RLC_DERIVING_TYPE(this)].fOffset));
-}
-
-union RlcStatementStorage
-{
-	struct RlcParsedAssertStatement fRlcParsedAssertStatement;
-	struct RlcParsedExpressionStatement fRlcParsedExpressionStatement;
-	struct RlcParsedBlockStatement fRlcParsedBlockStatement;
-	struct RlcParsedIfStatement fRlcParsedIfStatement;
-	struct RlcParsedLoopStatement fRlcParsedLoopStatement;
-	struct RlcParsedVariableStatement fRlcParsedVariableStatement;
-	struct RlcParsedReturnStatement fRlcParsedReturnStatement;
-	struct RlcParsedSwitchStatement fRlcParsedSwitchStatement;
-	struct RlcParsedCaseStatement fRlcParsedCaseStatement;
-	struct RlcParsedBreakStatement fRlcParsedBreakStatement;
-	struct RlcParsedTryStatement fRlcParsedTryStatement;
-	struct RlcParsedTryStatement fRlcParsedThrowStatement;
+/** The FIRST sets of the statements, indexed by token type. Expression statements are looked up via `rlc_parsed_expression_first()`. */
+static int const k_first[RLC_COUNT(RlcTokenType)] = {
+	[kRlcTokAssert] = RLC_FLAG(kRlcParsedAssertStatement),
+	[kRlcTokBraceOpen] = RLC_FLAG(kRlcParsedBlockStatement),
+	[kRlcTokReturn] = RLC_FLAG(kRlcParsedReturnStatement),
+	[kRlcTokIf] = RLC_FLAG(kRlcParsedIfStatement),
+	[kRlcTokDo] = RLC_FLAG(kRlcParsedLoopStatement),
+	[kRlcTokFor] = RLC_FLAG(kRlcParsedLoopStatement),
+	[kRlcTokWhile] = RLC_FLAG(kRlcParsedLoopStatement),
+	[kRlcTokIdentifier] = RLC_FLAG(kRlcParsedVariableStatement),
+	// A failed variable statement leaves `static` consumed, and the statements after it see the following token.
+	[kRlcTokStatic] = RLC_FLAG(kRlcParsedVariableStatement)
+		| RLC_FLAG(kRlcParsedSwitchStatement)
+		| RLC_FLAG(kRlcParsedBreakStatement)
+		| RLC_FLAG(kRlcParsedContinueStatement)
+		| RLC_FLAG(kRlcParsedTryStatement)
+		| RLC_FLAG(kRlcParsedThrowStatement)
+		| RLC_FLAG(kRlcParsedExpressionStatement),
+	[kRlcTokSwitch] = RLC_FLAG(kRlcParsedSwitchStatement),
+	[kRlcTokBreak] = RLC_FLAG(kRlcParsedBreakStatement),
+	[kRlcTokContinue] = RLC_FLAG(kRlcParsedContinueStatement),
+	[kRlcTokTry] = RLC_FLAG(kRlcParsedTryStatement),
+	[kRlcTokThrow] = RLC_FLAG(kRlcParsedThrowStatement)
 };
 
 struct RlcParsedStatement * rlc_parsed_statement_parse(
@@ -98,10 +58,8 @@ struct RlcParsedStatement * rlc_parsed_statement_parse(
 {
 	RLC_DASSERT(parser != NULL);
 
-	union RlcStatementStorage storage;
-
 	typedef int (*parse_fn_t)(
-		union RlcStatementStorage *,
+		void *,
 		struct RlcParser *);
 
 
@@ -141,27 +99,37 @@ struct RlcParsedStatement * rlc_parsed_statement_parse(
 
 	static_assert(RLC_COVERS_ENUM(k_parse_lookup, RlcParsedStatementType), "ill-sized parse table.");
 
-	struct RlcParsedStatement * ret;
+	if(rlc_parser_eof(parser))
+		return NULL;
 
-	for(size_t i = 0; i < _countof(k_parse_lookup); i++)
-	{
-		if(RLC_FLAG(k_parse_lookup[i].fType) & flags)
-		{
-			if(k_parse_lookup[i].fParseFn
-			&& k_parse_lookup[i].fParseFn(
-				&storage,
-				parser))
-			{
-				void * temp = NULL;
-				rlc_malloc(&temp, k_parse_lookup[i].fTypeSize);
+	// Only try the statements that can start with the current token.
+	enum RlcTokenType const first = rlc_parser_current(parser).type;
+	int candidates = k_first[first];
+	if(rlc_parsed_expression_first(first))
+		candidates |= RLC_FLAG(kRlcParsedExpressionStatement);
+	candidates &= flags;
 
-				memcpy(temp, &storage, k_parse_lookup[i].fTypeSize);
+	// Parse directly into the arena. Parsers that fail consume no tokens, so the memory is reused by the next candidate.
+	void * node = NULL;
+	size_t node_size = 0;
 
-				ret = (void*) ((uint8_t*)temp + k_parse_lookup[i].fOffset);
+	for(size_t i = 0; candidates; i++)
+	{
+		RLC_DASSERT(i < _countof(k_parse_lookup));
+		if(!(RLC_FLAG(k_parse_lookup[i].fType) & candidates))
+			continue;
+		candidates &= ~RLC_FLAG(k_parse_lookup[i].fType);
 
-				return ret;
-			}
+		RLC_DASSERT(k_parse_lookup[i].fParseFn != NULL);
+		if(node_size < k_parse_lookup[i].fTypeSize)
+		{
+			node = NULL;
+			node_size = k_parse_lookup[i].fTypeSize;
+			rlc_arena_malloc(parser->fArena, &node, node_size);
 		}
+
+		if(k_parse_lookup[i].fParseFn(node, parser))
+			return (void*) ((uint8_t*)node + k_parse_lookup[i].fOffset);
 	}
 
 	return NULL;
@@ -176,37 +144,16 @@ void rlc_parsed_statement_list_create(
 	this->fStatementCount = 0;
 }
 
-void rlc_parsed_statement_list_destroy(
-	struct RlcParsedStatementList * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fStatements)
-	{
-		for(size_t i = 0; i < this->fStatementCount; i++)
-		{
-			rlc_parsed_statement_destroy_virtual(this->fStatements[i]);
-			rlc_free((void**)&this->fStatements[i]);
-		}
-
-		rlc_free((void**) &this->fStatements);
-
-		this->fStatementCount = 0;
-	}
-}
-
 void rlc_parsed_statement_list_add(
 	struct RlcParsedStatementList * this,
-	struct RlcParsedStatement * stmt)
+	struct RlcParsedStatement * stmt,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(stmt != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fStatements,
-		sizeof(struct RlcParsedStatement *) * ++this->fStatementCount);
-
-	this->fStatements[this->fStatementCount-1] = stmt;
+	RLC_VECTOR_PUSH(arena, this->fStatements, this->fStatementCount) = stmt;
 }
 
 void rlc_parsed_statement_print(
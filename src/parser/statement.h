@@ -48,17 +48,6 @@ void rlc_parsed_statement_create(
 	struct RlcParsedStatement * this,
 	enum RlcParsedStatementType type);
 
-void rlc_parsed_statement_destroy_base(
-	struct RlcParsedStatement * this);
-
-/** Destroys a parsed statement.
-@virtual @memberof RlcParsedStatement
-@param[in,out] this:
-	The statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_statement_destroy_virtual(
-	struct RlcParsedStatement * this);
-
 /** Parses a statement.
 @memberof RlcParsedStatement
 @param[in,out] parser:
@@ -88,14 +77,6 @@ struct RlcParsedStatementList
 	@dassert @nonnull */
 void rlc_parsed_statement_list_create(
 	struct RlcParsedStatementList * this);
-/** Destroys a statement list.
-@memberof RlcParsedStatementList
-@param[in,out] this:
-	The statement list to destroy.
-	@dassert @nonnull */
-void rlc_parsed_statement_list_destroy(
-	struct RlcParsedStatementList * this);
-
 /** Adds a statement to a statement list.
 @memberof RlcParsedStatementList
 @param[in,out] this:
@@ -104,10 +85,14 @@ void rlc_parsed_statement_list_destroy(
 @param[in] stmt:
 	The statement to add to the list.
 	@pass_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_statement_list_add(
 	struct RlcParsedStatementList * this,
-	struct RlcParsedStatement * stmt);
+	struct RlcParsedStatement * stmt,
+	struct RlcArena * arena);
 
 void rlc_parsed_statement_print(
 	struct RlcParsedStatement * this,
@@ -1,58 +1,43 @@
 #include "stringexpression.h"
 
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 static void rlc_parsed_string_expression_add(
 	struct RlcParsedStringExpression * this,
-	struct RlcToken const * token)
+	struct RlcToken const * token,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(token != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fTokens,
-		sizeof(struct RlcToken) * ++this->fTokenCount);
-	this->fTokens[this->fTokenCount-1] = *token;
+	RLC_VECTOR_PUSH(arena, this->fTokens, this->fTokenCount) = *token;
 
 	struct RlcParsedExpression * base = RLC_BASE_CAST(this, RlcParsedExpression);
-	if(base->fEnd.content.start < token->content.start)
-		base->fEnd = *token;
+	if(base->fEnd < rlc_src_string_end(&token->content))
+		base->fEnd = rlc_src_string_end(&token->content);
 }
 
 void rlc_parsed_string_expression_create(
 	struct RlcParsedStringExpression * this,
-	struct RlcToken const * first)
+	struct RlcToken const * first,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(first != NULL);
+	RLC_DASSERT(arena != NULL);
 
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedStringExpression,
-		*first,
-		*first);
+		first->content.start,
+		rlc_src_string_end(&first->content));
 
 	this->fTokens = NULL;
 	this->fTokenCount = 0;
 
-	rlc_parsed_string_expression_add(this, first);
-}
-
-void rlc_parsed_string_expression_destroy(
-	struct RlcParsedStringExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(RLC_DERIVING_TYPE(RLC_BASE_CAST(this,RlcParsedExpression)) == kRlcParsedStringExpression);
-
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedExpression));
-
-	if(this->fTokens)
-	{
-		rlc_free((void**)&this->fTokens);
-		this->fTokenCount = 0;
-	}
+	rlc_parsed_string_expression_add(this, first, arena);
 }
 
 static int consume_string_literal(
@@ -91,10 +76,11 @@ int rlc_parsed_string_expression_parse(
 
 	rlc_parsed_string_expression_create(
 		out,
-		&string);
+		&string,
+		parser->fArena);
 
 	while(consume_string_literal(parser, &string))
-		rlc_parsed_string_expression_add(out, &string);
+		rlc_parsed_string_expression_add(out, &string, parser->fArena);
 
 	return 1;
 }
@@ -33,19 +33,14 @@ struct RlcParsedStringExpression
 	@dassert @nonnull
 @param[in] first:
 	The expression's first token.
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_string_expression_create(
 	struct RlcParsedStringExpression * this,
-	struct RlcToken const * first);
-
-/** Destroys a strin expression.
-@memberof RlcParsedStringExpression
-
-@param[in,out] this:
-	The string expression to destroy.
-	@dassert @nonnull */
-void rlc_parsed_string_expression_destroy(
-	struct RlcParsedStringExpression * this);
+	struct RlcToken const * first,
+	struct RlcArena * arena);
 
 /** Parses a string expression.
 @memberof RlcParsedStringExpression
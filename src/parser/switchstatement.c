@@ -1,7 +1,7 @@
 #include "switchstatement.h"
 
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 void rlc_parsed_switch_statement_create(
 	struct RlcParsedSwitchStatement * this)
@@ -17,32 +17,6 @@ void rlc_parsed_switch_statement_create(
 	this->fCaseCount = 0;
 }
 
-void rlc_parsed_switch_statement_destroy(
-	struct RlcParsedSwitchStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fIsVariableSwitchValue)
-	{
-		rlc_parsed_variable_destroy(&this->fSwitchValue.fVariable);
-	} else if(this->fSwitchValue.fExpression)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fSwitchValue.fExpression);
-		rlc_free((void**)&this->fSwitchValue.fExpression);
-	}
-
-	if(this->fCases)
-	{
-		for(size_t i = 0; i < this->fCaseCount; i++)
-			rlc_parsed_case_statement_destroy(&this->fCases[i]);
-		rlc_free((void**)&this->fCases);
-	}
-	this->fCaseCount = 0;
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 int rlc_parsed_switch_statement_parse(
 	struct RlcParsedSwitchStatement * out,
 	struct RlcParser * parser)
@@ -116,7 +90,8 @@ int rlc_parsed_switch_statement_parse(
 
 		rlc_parsed_switch_statement_add_case(
 			out,
-			&case_stmt);
+			&case_stmt,
+			parser->fArena);
 	} while(case_stmt.fIsFallthrough
 		|| !rlc_parser_consume(parser, NULL, kRlcTokBraceClose));
 
@@ -128,15 +103,14 @@ int rlc_parsed_switch_statement_parse(
 
 void rlc_parsed_switch_statement_add_case(
 	struct RlcParsedSwitchStatement * this,
-	struct RlcParsedCaseStatement * statement)
+	struct RlcParsedCaseStatement * statement,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(statement != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fCases,
-		sizeof(struct RlcParsedCaseStatement) * ++this->fCaseCount);
-	this->fCases[this->fCaseCount-1] = *statement;
+	RLC_VECTOR_PUSH(arena, this->fCases, this->fCaseCount) = *statement;
 }
 
 void rlc_parsed_switch_statement_print(
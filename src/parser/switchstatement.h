@@ -44,14 +44,6 @@ struct RlcParsedSwitchStatement
 void rlc_parsed_switch_statement_create(
 	struct RlcParsedSwitchStatement * this);
 
-/** Destroys a switch statement.
-@memberof RlcParsedSwitchStatement
-
-@param[in,out] this:
-	The switch statement to destroy. */
-void rlc_parsed_switch_statement_destroy(
-	struct RlcParsedSwitchStatement * this);
-
 /** Parses a switch statement.
 @memberof RlcParsedSwitchStatement
 @param[out] out:
@@ -71,10 +63,14 @@ int rlc_parsed_switch_statement_parse(
 @param[in,out] this:
 	The switch statement to add a case to.
 @param[in] case_stmt:
-	The case to add. */
+	The case to add.
+@param[in,out] arena:
+	The arena to allocate from.
+	@dassert @nonnull */
 void rlc_parsed_switch_statement_add_case(
 	struct RlcParsedSwitchStatement * this,
-	struct RlcParsedCaseStatement * case_stmt);
+	struct RlcParsedCaseStatement * case_stmt,
+	struct RlcArena * arena);
 
 void rlc_parsed_switch_statement_print(
 	struct RlcParsedSwitchStatement const * this,
@@ -1,7 +1,7 @@
 #include "symbol.h"
 #include "typename.h"
 
-#include "../malloc.h"
+#include "../vector.h"
 #include "../assert.h"
 #include "../printer.h"
 
@@ -44,16 +44,13 @@ static int rlc_parsed_symbol_child_template_parse(
 			kRlcTokHash)))
 		{
 			do {
-				rlc_realloc(
-					(void**)&template.fExpressions,
-					sizeof(struct RlcParsedExpression *) * ++template.fSize);
-				if(!(template.fExpressions[template.fSize-1]
-					= rlc_parsed_expression_parse(
-						parser,
-						RLC_ALL_FLAGS(RlcParsedExpressionType))))
-				{
+				struct RlcParsedExpression * expression = rlc_parsed_expression_parse(
+					parser,
+					RLC_ALL_FLAGS(RlcParsedExpressionType));
+				if(!expression)
 					rlc_parser_fail(parser, "expected expression");
-				}
+
+				RLC_VECTOR_PUSH(parser->fArena, template.fExpressions, template.fSize) = expression;
 			} while(rlc_parser_consume(
 				parser,
 				NULL,
@@ -61,12 +58,8 @@ static int rlc_parsed_symbol_child_template_parse(
 		} else
 		{
 			do {
-				rlc_realloc(
-					(void**)&template.fTypeNames,
-					sizeof(struct RlcParsedTypeName) * ++template.fSize);
-
 				if(!rlc_parsed_type_name_parse(
-					&template.fTypeNames[template.fSize-1],
+					&RLC_VECTOR_PUSH(parser->fArena, template.fTypeNames, template.fSize),
 					parser,
 					0))
 				{
@@ -79,7 +72,8 @@ static int rlc_parsed_symbol_child_template_parse(
 		}
 		rlc_parsed_symbol_child_add_template(
 			out,
-			&template);
+			&template,
+			parser->fArena);
 	} while(rlc_parser_consume(
 		parser,
 		NULL,
@@ -133,47 +127,14 @@ int rlc_parsed_symbol_child_parse(
 
 void rlc_parsed_symbol_child_add_template(
 	struct RlcParsedSymbolChild * this,
-	struct RlcParsedSymbolChildTemplate * template_argument)
+	struct RlcParsedSymbolChildTemplate * template_argument,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(template_argument != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fTemplates,
-		sizeof(struct RlcParsedSymbolChildTemplate) * ++ this->fTemplateCount);
-
-	this->fTemplates[this->fTemplateCount-1] = *template_argument;
-}
-
-void rlc_parsed_symbol_child_destroy(
-	struct RlcParsedSymbolChild * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fTemplates)
-	{
-		for(size_t i = 0; i < this->fTemplateCount; i++)
-		{
-			for(RlcSrcIndex j = 0; j < this->fTemplates[i].fSize; j++)
-			{
-				if(this->fTemplates[i].fIsExpression)
-				{
-					rlc_parsed_expression_destroy_virtual(
-						this->fTemplates[i].fExpressions[j]);
-					rlc_free((void**)&this->fTemplates[i].fExpressions[j]);
-				}
-				else
-				{
-					rlc_parsed_type_name_destroy(
-						&this->fTemplates[i].fTypeNames[j]);
-				}
-			}
-			if(this->fTemplates[i].fTypeNames)
-				rlc_free((void**)&this->fTemplates[i].fTypeNames);
-		}
-		rlc_free((void**)&this->fTemplates);
-	}
-	this->fTemplateCount = 0;
+	RLC_VECTOR_PUSH(arena, this->fTemplates, this->fTemplateCount) = *template_argument;
 }
 
 void rlc_parsed_symbol_child_print(
@@ -232,35 +193,16 @@ void rlc_parsed_symbol_child_print(
 	}
 }
 
-void rlc_parsed_symbol_destroy(
-	struct RlcParsedSymbol * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fChildren)
-	{
-		for(size_t i = 0; i < this->fChildCount; i++)
-			rlc_parsed_symbol_child_destroy(&this->fChildren[i]);
-		rlc_free((void**)&this->fChildren);
-	}
-
-	this->fChildCount = 0;
-	this->fIsRoot = 0;
-}
-
-
 void rlc_parsed_symbol_add_child(
 	struct RlcParsedSymbol * this,
-	struct RlcParsedSymbolChild * child)
+	struct RlcParsedSymbolChild * child,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(child != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fChildren,
-		sizeof (struct RlcParsedSymbolChild) * ++ this->fChildCount);
-
-	this->fChildren[this->fChildCount-1] = *child;
+	RLC_VECTOR_PUSH(arena, this->fChildren, this->fChildCount) = *child;
 #ifdef RLC_DEBUG
 	// invalidate the old data.
 	rlc_parsed_symbol_child_create(child);
@@ -304,7 +246,8 @@ int rlc_parsed_symbol_parse(
 			parsed_any = 1;
 			rlc_parsed_symbol_add_child(
 				out,
-				&child);
+				&child,
+				parser->fArena);
 		} else if(parsed_any || out->fIsRoot)
 		{
 			rlc_parser_fail(parser, "expected symbol");
@@ -52,14 +52,6 @@ struct RlcParsedSymbolChild
 	@dassert @nonnull */
 void rlc_parsed_symbol_child_create(
 	struct RlcParsedSymbolChild * this);
-/** Destroys a symbol child.
-@memberof RlcParsedSymbolChild
-@param[in,out] this:
-	The symbol child to destroy.
-	@dassert @nonnull */
-void rlc_parsed_symbol_child_destroy(
-	struct RlcParsedSymbolChild * this);
-
 /** Adds a template argument to a symbol child.
 @memberof RlcParsedSymbolChild
 
@@ -69,10 +61,14 @@ void rlc_parsed_symbol_child_destroy(
 	@dassert @nonnull
 @param[in] template_argument:
 	The template argument.
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_symbol_child_add_template(
 	struct RlcParsedSymbolChild * this,
-	struct RlcParsedSymbolChildTemplate * template_argument);
+	struct RlcParsedSymbolChildTemplate * template_argument,
+	struct RlcArena * arena);
 
 int rlc_parsed_symbol_child_parse(
 	struct RlcParsedSymbolChild * out,
@@ -96,15 +92,6 @@ struct RlcParsedSymbol
 	/** Whether the symbol was prefixed with `::` to access the root namespace. */
 	int fIsRoot;
 };
-/** Destroys a symbol.
-	Releases memory allocated by the given symbol, but not the symbol itself.
-@memberof RlcParsedSymbol
-
-@param[in] this:
-	The symbol to destroy. */
-void rlc_parsed_symbol_destroy(
-	struct RlcParsedSymbol * this);
-
 /** Adds a child to a symbol.
 @memberof RlcParsedSymbol
 
@@ -114,10 +101,14 @@ void rlc_parsed_symbol_destroy(
 @param[in,out] child:
 	The symbol child to add.
 	@pass_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_symbol_add_child(
 	struct RlcParsedSymbol * this,
-	struct RlcParsedSymbolChild * child);
+	struct RlcParsedSymbolChild * child,
+	struct RlcArena * arena);
 
 /** Creates a symbol.
 @param[out] this:
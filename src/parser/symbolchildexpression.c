@@ -8,28 +8,11 @@ void rlc_parsed_symbol_child_expression_create(
 {
 	RLC_DASSERT(this != NULL);
 
-	struct RlcToken last = {
-		RLC_BASE_CAST(this, RlcParsedSymbolChild)->fName,
-		kRlcTokIdentifier
-	};
-
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedSymbolChildExpression,
-		first,
-		last);
-}
-
-void rlc_parsed_symbol_child_expression_destroy(
-	struct RlcParsedSymbolChildExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedExpression));
-
-	rlc_parsed_symbol_child_destroy(
-		RLC_BASE_CAST(this, RlcParsedSymbolChild));
+		first.content.start,
+		rlc_src_string_end(&RLC_BASE_CAST(this, RlcParsedSymbolChild)->fName));
 }
 
 int rlc_parsed_symbol_child_expression_parse(
@@ -39,10 +22,10 @@ int rlc_parsed_symbol_child_expression_parse(
 	RLC_DASSERT(out != NULL);
 	RLC_DASSERT(parser != NULL);
 
-	if(!rlc_parser_current(parser))
+	if(rlc_parser_eof(parser))
 		return 0;
 
-	struct RlcToken first = *rlc_parser_current(parser);
+	struct RlcToken first = rlc_parser_current(parser);
 	if(!rlc_parsed_symbol_child_parse(
 		RLC_BASE_CAST(out, RlcParsedSymbolChild),
 		parser,
@@ -32,13 +32,6 @@ struct RlcParsedSymbolChildExpression
 void rlc_parsed_symbol_child_expression_create(
 	struct RlcParsedSymbolChildExpression * this,
 	struct RlcToken first);
-/** Destroys a symbol child expression.
-@memberof RlcParsedSymbolChildExpression
-@param[in,out] this:
-	The symbol child expression to destroy.
-	@dassert @nonnull */
-void rlc_parsed_symbol_child_expression_destroy(
-	struct RlcParsedSymbolChildExpression * this);
 /** Parses a symbol child expression.
 @memberof RlcParsedSymbolChildExpression
 @param[out] out:
@@ -2,68 +2,172 @@
 
 #include "../assert.h"
 #include "../malloc.h"
+#include "../src/nametable.h"
 
 #include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdatomic.h>
 
-static RlcSrcSize symbolCount = 0;
-static char const ** symbols = NULL;
-
-void rlc_parsed_symbol_constant_register(
-	struct RlcSrcFile const * file,
-	struct RlcSrcString const * name)
+/** An open-addressing hash set of symbol constants' names, which point into the source text of parsed files that outlive the registry.
+	Tables never grow: once a table is half full, new names go to the next, twice as large table. See `nametable.h` for how slots are claimed. */
+struct RlcSymbolConstantTable
 {
-	RlcSrcIndex left = 0, right = symbolCount;
-
-	char const * str = rlc_src_string_cstr(name, file);
+	/** The next table, once this one is full. */
+	_Atomic(struct RlcSymbolConstantTable *) fNext;
+	/** The number of claimed slots. */
+	atomic_size_t fCount;
+	/** The slot count. Always a power of two. */
+	size_t fCapacity;
+	/** The slots. */
+	struct RlcNameSlot fSlots[];
+};
+
+enum { kInitialSymbolCapacity = 1024 };
+
+/** The first table. Registration is lock-free, as files are parsed in parallel. */
+static _Atomic(struct RlcSymbolConstantTable *) s_symbols = NULL;
+
+/** Returns the table following a table, or creates it. */
+static struct RlcSymbolConstantTable * next_table(
+	_Atomic(struct RlcSymbolConstantTable *) * next,
+	size_t capacity)
+{
+	struct RlcSymbolConstantTable * table = atomic_load_explicit(next, memory_order_acquire);
+	if(table)
+		return table;
+
+	size_t const size = sizeof(struct RlcSymbolConstantTable)
+		+ capacity * sizeof(struct RlcNameSlot);
+	rlc_malloc((void**)&table, size);
+	memset(table, 0, size);
+	table->fCapacity = capacity;
+
+	struct RlcSymbolConstantTable * expected = NULL;
+	if(atomic_compare_exchange_strong_explicit(
+		next, &expected, table,
+		memory_order_acq_rel, memory_order_acquire))
+		return table;
+
+	// Another thread added a table first.
+	rlc_free((void**)&table);
+	return expected;
+}
 
-	RlcSrcIndex i = 0;
-	while(left < right)
+/** Looks a name up in a table, and inserts it if the table has room.
+@return
+	Whether the name is in the table afterwards. */
+static int find_or_insert(
+	struct RlcSymbolConstantTable * this,
+	uint64_t key,
+	char const * name,
+	RlcSrcSize length)
+{
+	size_t i;
+	switch(rlc_name_table_probe(
+		this->fSlots, sizeof(struct RlcNameSlot), this->fCapacity, &this->fCount,
+		key, name, length, &i))
 	{
-		i = (left+right)>>1;
-		signed sign = strcmp(str, symbols[i]);
-		if(sign < 0)
-			right = i;
-		else if(sign > 0)
-			left = i+1;
-		else
-		{
-			rlc_free((void**)&str);
-			return;
-		}
+	case kRlcNameClaimed:
+		rlc_name_slot_publish(&this->fSlots[i], name);
+		// fallthrough
+	case kRlcNameFound:
+		return 1;
+	default:
+		return 0;
 	}
+}
 
-	rlc_realloc(
-		(void**)&symbols,
-		++symbolCount * sizeof(char*));
+void rlc_parsed_symbol_constant_register(
+	struct RlcSrcFile const * file,
+	struct RlcSrcString const * name)
+{
+	RLC_DASSERT(file != NULL);
+	RLC_DASSERT(name != NULL);
+	RLC_DASSERT(name->length);
 
-	for(RlcSrcIndex k = symbolCount; k-->left+1;)
-		symbols[k] = symbols[k-1];
+	char const * str = file->fContents + name->start;
+	uint64_t const key = rlc_name_key(str, name->length);
 
-	symbols[left] = str;
+	size_t capacity = kInitialSymbolCapacity;
+	struct RlcSymbolConstantTable * table = next_table(&s_symbols, capacity);
+	while(!find_or_insert(table, key, str, name->length))
+		table = next_table(&table->fNext, capacity *= 2);
 }
 
 void rlc_parsed_symbol_constant_free()
 {
-	if(symbolCount)
+	struct RlcSymbolConstantTable * table = atomic_exchange(&s_symbols, NULL);
+	while(table)
 	{
-		do {
-			rlc_free((void**)&symbols[--symbolCount]);
-		} while(symbolCount);
-
-		rlc_free((void**)&symbols);
+		struct RlcSymbolConstantTable * next = atomic_load(&table->fNext);
+		rlc_free((void**)&table);
+		table = next;
 	}
 }
 
+/** A symbol constant's name, as collected for printing. */
+struct RlcSymbolConstantName
+{
+	/** The name's first character. */
+	char const * fName;
+	/** The name's length. */
+	RlcSrcSize fLength;
+};
+
+/** Orders symbol constant names like `strcmp()`. */
+static int compare_names(
+	void const * a,
+	void const * b)
+{
+	struct RlcSymbolConstantName const * x = a, * y = b;
+	int const order = memcmp(
+		x->fName,
+		y->fName,
+		x->fLength < y->fLength ? x->fLength : y->fLength);
+	if(order)
+		return order;
+	return (x->fLength > y->fLength) - (x->fLength < y->fLength);
+}
+
 void rlc_parsed_symbol_constant_print(FILE * out)
 {
 	fputs("namespace __rl::constant {\n", out);
 
-	for(RlcSrcIndex i = 0; i < symbolCount; i++)
+	size_t count = 0;
+	for(struct RlcSymbolConstantTable * t = s_symbols; t; t = t->fNext)
+		count += t->fCount;
+
+	if(count)
 	{
-		char const * name = symbols[i];
-		fprintf(out,
-			"struct _t_%s : public __rl::SymbolBase<_t_%s> {} const _v_%s{};\n",
-			name, name, name);
+		// Sort the names, so that the output does not depend on hashing or registration order.
+		struct RlcSymbolConstantName * sorted = NULL;
+		rlc_malloc((void**)&sorted, count * sizeof(struct RlcSymbolConstantName));
+		size_t n = 0;
+		for(struct RlcSymbolConstantTable * t = s_symbols; t; t = t->fNext)
+			for(size_t i = 0; i < t->fCapacity; i++)
+			{
+				// The lower half of a key is the name's length, which is 0 for free and sealed slots.
+				RlcSrcSize const length = (RlcSrcSize) t->fSlots[i].fKey;
+				if(length)
+					sorted[n++] = (struct RlcSymbolConstantName){
+						t->fSlots[i].fName,
+						length
+					};
+			}
+		RLC_DASSERT(n == count);
+		qsort(sorted, count, sizeof(struct RlcSymbolConstantName), &compare_names);
+
+		for(size_t i = 0; i < count; i++)
+		{
+			int const len = sorted[i].fLength;
+			char const * name = sorted[i].fName;
+			fprintf(out,
+				"struct _t_%.*s : public __rl::SymbolBase<_t_%.*s> {} const _v_%.*s{};\n",
+				len, name, len, name, len, name);
+		}
+
+		rlc_free((void**)&sorted);
 	}
 
 	fputs("}\n", out);
@@ -81,7 +185,8 @@ void rlc_parsed_symbol_constant_expression_create(
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedSymbolConstantExpression,
-		*op, *name);
+		op->content.start,
+		rlc_src_string_end(&name->content));
 
 	this->fName = name->content;
 }
@@ -108,15 +213,6 @@ int rlc_parsed_symbol_constant_expression_parse(
 	return 1;
 }
 
-void rlc_parsed_symbol_constant_expression_destroy(
-	struct RlcParsedSymbolConstantExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedExpression));
-}
-
 void rlc_parsed_symbol_constant_expression_print(
 	struct RlcParsedSymbolConstantExpression * this,
 	struct RlcSrcFile const * file,
@@ -31,9 +31,6 @@ _Nodiscard int rlc_parsed_symbol_constant_expression_parse(
 	struct RlcParsedSymbolConstantExpression * out,
 	struct RlcParser * parser);
 
-void rlc_parsed_symbol_constant_expression_destroy(
-	struct RlcParsedSymbolConstantExpression * this);
-
 void rlc_parsed_symbol_constant_expression_print(
 	struct RlcParsedSymbolConstantExpression * this,
 	struct RlcSrcFile const * file,
@@ -7,25 +7,11 @@ void rlc_parsed_symbol_expression_create(
 {
 	RLC_DASSERT(this != NULL);
 
-	struct RlcToken last = {
-		this->fSymbol.fChildren[this->fSymbol.fChildCount-1].fName,
-		kRlcTokIdentifier
-	};
-
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedSymbolExpression,
-		first,
-		last);
-}
-
-void rlc_parsed_symbol_expression_destroy(
-	struct RlcParsedSymbolExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(RLC_DERIVING_TYPE(RLC_BASE_CAST(this, RlcParsedExpression)) == kRlcParsedSymbolExpression);
-
-	rlc_parsed_symbol_destroy(&this->fSymbol);
+		first.content.start,
+		rlc_src_string_end(&this->fSymbol.fChildren[this->fSymbol.fChildCount-1].fName));
 }
 
 int rlc_parsed_symbol_expression_parse(
@@ -35,10 +21,10 @@ int rlc_parsed_symbol_expression_parse(
 	RLC_DASSERT(out != NULL);
 	RLC_DASSERT(parser != NULL);
 
-	if(!rlc_parser_current(parser))
+	if(rlc_parser_eof(parser))
 		return 0;
 
-	struct RlcToken start = *rlc_parser_current(parser);
+	struct RlcToken start = rlc_parser_current(parser);
 
 	if(!rlc_parsed_symbol_parse(
 		&out->fSymbol,
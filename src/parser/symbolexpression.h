@@ -30,14 +30,6 @@ void rlc_parsed_symbol_expression_create(
 	struct RlcParsedSymbolExpression * this,
 	struct RlcToken first);
 
-/** Destroys a symbol expression.
-@memberof RlcParsedSymbolExpression
-
-@param[in] this:
-	The symbol exression to destroy. */
-void rlc_parsed_symbol_expression_destroy(
-	struct RlcParsedSymbolExpression * this);
-
 /** Parses a symbol expression.
 @memberof RlcParsedSymbolExpression
 @param[out] out:
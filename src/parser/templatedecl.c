@@ -1,7 +1,7 @@
 #include "templatedecl.h"
 
 #include "../printer.h"
-#include "../malloc.h"
+#include "../vector.h"
 #include "../assert.h"
 #include "../resolver/resolver.h"
 
@@ -20,30 +20,14 @@ void rlc_parsed_template_decl_create(
 
 void rlc_parsed_template_decl_add_child(
 	struct RlcParsedTemplateDecl * this,
-	struct RlcParsedTemplateDeclChild const * child)
+	struct RlcParsedTemplateDeclChild const * child,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(child != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fChildren,
-		sizeof(struct RlcParsedTemplateDeclChild) * ++ this->fChildCount);
-
-	this->fChildren[this->fChildCount-1] = *child;
-}
-
-void rlc_parsed_template_decl_destroy(
-	struct RlcParsedTemplateDecl * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fChildren)
-	{
-		for(size_t i = 0; i < this->fChildCount; i++)
-			rlc_parsed_template_decl_child_destroy(&this->fChildren[i]);
-		rlc_free((void**)&this->fChildren);
-		this->fChildCount = 0;
-	}
+	RLC_VECTOR_PUSH(arena, this->fChildren, this->fChildCount) = *child;
 }
 
 void rlc_parsed_template_decl_parse(
@@ -113,7 +97,8 @@ void rlc_parsed_template_decl_parse(
 
 		rlc_parsed_template_decl_add_child(
 			decl,
-			&child);
+			&child,
+			parser->fArena);
 	} while(kRlcTokSemicolon == rlc_parser_expect(
 		parser,
 		NULL,
@@ -124,19 +109,6 @@ void rlc_parsed_template_decl_parse(
 	rlc_parser_untrace(parser, &tracer);
 }
 
-void rlc_parsed_template_decl_child_destroy(
-	struct RlcParsedTemplateDeclChild * this)
-{
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(RLC_IN_ENUM(this->fType, RlcParsedTemplateDeclType));
-
-	if(this->fType == kRlcParsedTemplateDeclTypeValue)
-	{
-		rlc_parsed_type_name_destroy(&this->fValueType);
-		this->fType = kRlcParsedTemplateDeclTypeNumber;
-	}
-}
-
 void rlc_parsed_template_decl_print(
 	struct RlcParsedTemplateDecl const * this,
 	struct RlcSrcFile const * file,
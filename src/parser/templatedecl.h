@@ -61,18 +61,14 @@ void rlc_parsed_template_decl_create(
 @param[in] this:
 	The template argument declaration to add an argument to.
 @param[in] child:
-	The template argument to add. */
+	The template argument to add.
+@param[in,out] arena:
+	The arena to allocate from.
+	@dassert @nonnull */
 void rlc_parsed_template_decl_add_child(
 	struct RlcParsedTemplateDecl * this,
-	struct RlcParsedTemplateDeclChild const * child);
-
-/** Destroys a template argument declaration.
-@memberof RlcParsedTemplateDecl
-
-@param[in] this:
-	The template argument declaration to destroy. */
-void rlc_parsed_template_decl_destroy(
-	struct RlcParsedTemplateDecl * this);
+	struct RlcParsedTemplateDeclChild const * child,
+	struct RlcArena * arena);
 
 /** Parses a template declaration. */
 void rlc_parsed_template_decl_parse(
@@ -88,14 +84,6 @@ void rlc_parsed_template_decl_parse(
 static inline int rlc_parsed_template_decl_exists(
 	struct RlcParsedTemplateDecl const * this);
 
-/** Destroys a template argument declaration child.
-@memberof RlcParsedTemplateDeclChild
-
-@param[in] this:
-	The template argument declaration child to destroy. */
-void rlc_parsed_template_decl_child_destroy(
-	struct RlcParsedTemplateDeclChild * this);
-
 void rlc_parsed_template_decl_print(
 	struct RlcParsedTemplateDecl const * this,
 	struct RlcSrcFile const * file,
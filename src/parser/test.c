@@ -17,16 +17,6 @@ void rlc_parsed_test_create(
 	rlc_parsed_block_statement_create(&this->fBody);
 }
 
-void rlc_parsed_test_destroy(
-	struct RlcParsedTest * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_block_statement_destroy(&this->fBody);
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-}
-
 _Nodiscard int rlc_parsed_test_parse(
 	struct RlcParsedTest * out,
 	struct RlcParser * parser,
@@ -78,10 +68,12 @@ void rlc_parsed_test_print(
 	if(printer->fIsTest)
 	{
 		FILE * out = printer->fFuncsImpl;
+		rlc_printer_begin_definition(printer, out, kRlcPrinterDefinitionOrdered);
 		fputs("__RL_TEST(", out);
 		rlc_src_string_print(&this->fName, file, out);
 		fputs(")", out);
 
 		rlc_parsed_block_statement_print(&this->fBody, file, out);
+		rlc_printer_end_definition(printer, out);
 	}
 }
\ No newline at end of file
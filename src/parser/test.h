@@ -22,8 +22,6 @@ struct RlcParsedTest
 
 void rlc_parsed_test_create(
 	struct RlcParsedTest * this);
-void rlc_parsed_test_destroy(
-	struct RlcParsedTest * this);
 _Nodiscard int rlc_parsed_test_parse(
 	struct RlcParsedTest * out,
 	struct RlcParser * parser,
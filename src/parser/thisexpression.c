@@ -11,17 +11,8 @@ void rlc_parsed_this_expression_create(
 	rlc_parsed_expression_create(
 		RLC_BASE_CAST(this, RlcParsedExpression),
 		kRlcParsedThisExpression,
-		token,
-		token);
-}
-
-void rlc_parsed_this_expression_destroy(
-	struct RlcParsedThisExpression * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_expression_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedExpression));
+		token.content.start,
+		rlc_src_string_end(&token.content));
 }
 
 int rlc_parsed_this_expression_parse(
@@ -30,14 +30,6 @@ void rlc_parsed_this_expression_create(
 	struct RlcParsedThisExpression * this,
 	struct RlcToken token);
 
-/** Destroys a `this` expression.
-@memberof RlcParsedThisExpression
-@param[in,out] this:
-	The `this` expression to destroy.
-	@dassert @nonnull */
-void rlc_parsed_this_expression_destroy(
-	struct RlcParsedThisExpression * this);
-
 /** Parses a `this` expression.
 @memberof RlcParsedThisExpression
 @param[out] out:
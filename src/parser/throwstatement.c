@@ -1,7 +1,5 @@
 #include "throwstatement.h"
 
-#include "../malloc.h"
-
 void rlc_parsed_throw_statement_create(
 	struct RlcParsedThrowStatement * this)
 {
@@ -14,22 +12,6 @@ void rlc_parsed_throw_statement_create(
 		kRlcParsedThrowStatement);
 }
 
-void rlc_parsed_throw_statement_destroy(
-	struct RlcParsedThrowStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fType == kRlcThrowTypeValue)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fValue);
-		rlc_free((void**)&this->fValue);
-		this->fType = kRlcThrowTypeRethrow;
-	}
-
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 int rlc_parsed_throw_statement_parse(
 	struct RlcParsedThrowStatement * out,
 	struct RlcParser * parser)
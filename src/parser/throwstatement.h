@@ -39,14 +39,6 @@ struct RlcParsedThrowStatement
 void rlc_parsed_throw_statement_create(
 	struct RlcParsedThrowStatement * this);
 
-/** Destroys a parsed throw statement.
-@memberof RlcParsedThrowStatement
-@param[in,out] this:
-	The throw statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_throw_statement_destroy(
-	struct RlcParsedThrowStatement * this);
-
 /** Parses a parsed throw statement.
 @memberof RlcParsedThrowStatement
 @param[out] out:
@@ -1,6 +1,6 @@
 #include "trystatement.h"
 #include "returnstatement.h"
-#include "../malloc.h"
+#include "../vector.h"
 
 void rlc_parsed_try_statement_create(
 	struct RlcParsedTryStatement * this)
@@ -17,33 +17,6 @@ void rlc_parsed_try_statement_create(
 	this->fFinally = NULL;
 }
 
-void rlc_parsed_try_statement_destroy(
-	struct RlcParsedTryStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fBody)
-	{
-		rlc_parsed_statement_destroy_virtual(this->fBody);
-		rlc_free((void**)&this->fBody);
-	}
-
-	if(this->fCatches)
-	{
-		for(RlcSrcIndex i = 0; i < this->fCatchCount; i++)
-			rlc_parsed_catch_statement_destroy(&this->fCatches[i]);
-		rlc_free((void**)&this->fCatches);
-	}
-
-	if(this->fFinally)
-	{
-		rlc_parsed_statement_destroy_virtual(this->fFinally);
-		rlc_free((void**)&this->fFinally);
-	}
-
-	rlc_parsed_statement_destroy_base(RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 int rlc_parsed_try_statement_parse(
 	struct RlcParsedTryStatement * out,
 	struct RlcParser * parser)
@@ -71,10 +44,7 @@ int rlc_parsed_try_statement_parse(
 	struct RlcParsedCatchStatement catch_stmt;
 	while(rlc_parsed_catch_statement_parse(&catch_stmt, parser))
 	{
-		rlc_realloc(
-			(void**)&out->fCatches,
-			sizeof(struct RlcParsedCatchStatement) * ++out->fCatchCount);
-		out->fCatches[out->fCatchCount-1] = catch_stmt;
+		RLC_VECTOR_PUSH(parser->fArena, out->fCatches, out->fCatchCount) = catch_stmt;
 	}
 
 	if(rlc_parser_consume(
@@ -209,16 +179,3 @@ int rlc_parsed_catch_statement_parse(
 	rlc_parser_untrace(parser, &tracer);
 	return 1;
 }
-
-void rlc_parsed_catch_statement_destroy(
-	struct RlcParsedCatchStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(!this->fIsVoid)
-		rlc_parsed_variable_destroy(&this->fException);
-	rlc_parsed_statement_destroy_virtual(this->fBody);
-	rlc_free((void**)&this->fBody);
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
\ No newline at end of file
@@ -33,14 +33,6 @@ struct RlcParsedTryStatement
 	@dassert @nonnull */
 void rlc_parsed_try_statement_create(
 	struct RlcParsedTryStatement * this);
-/** Destroys a parsed try statement.
-@memberof RlcParsedTryStatement
-@param[in,out] this:
-	The try statement to destry.
-	@dassert @nonnull */
-void rlc_parsed_try_statement_destroy(
-	struct RlcParsedTryStatement * this);
-
 /** Parses a try statement.
 @memberof RlcParsedTryStatement
 @param[out] out:
@@ -82,14 +74,6 @@ struct RlcParsedCatchStatement
 _Nodiscard int rlc_parsed_catch_statement_parse(
 	struct RlcParsedCatchStatement * out,
 	struct RlcParser * parser);
-/** Destroys a parsed catch statement.
-@memberof RlcParsedCatchStatement
-@param[in,out] this:
-	The parsed catch statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_catch_statement_destroy(
-	struct RlcParsedCatchStatement * this);
-
 #ifdef __cplusplus
 }
 #endif
@@ -73,22 +73,6 @@ void rlc_parsed_typedef_create(
 		&this->fType);
 }
 
-void rlc_parsed_typedef_destroy(
-	struct RlcParsedTypedef * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_type_name_destroy(
-		&this->fType);
-
-	rlc_parsed_template_decl_destroy(
-		&this->fTemplates);
-
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-}
-
-
 void rlc_parsed_member_typedef_create(
 	struct RlcParsedMemberTypedef * this,
 	struct RlcParsedMemberCommon const * member)
@@ -101,18 +85,6 @@ void rlc_parsed_member_typedef_create(
 		member);
 }
 
-void rlc_parsed_member_typedef_destroy(
-	struct RlcParsedMemberTypedef * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_typedef_destroy(
-		RLC_BASE_CAST(this, RlcParsedTypedef));
-
-	rlc_parsed_member_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedMember));
-}
-
 int rlc_parsed_member_typedef_parse(
 	struct RlcParsedMemberTypedef * out,
 	struct RlcParser * parser,
@@ -31,13 +31,6 @@ void rlc_parsed_typedef_create(
 	struct RlcSrcString const * name,
 	struct RlcParsedTemplateDecl const * templates);
 
-/** Destroys a typedef.
-@memberof RlcParsedTypedef
-@param[out] this:
-	The typedef to destroy. */
-void rlc_parsed_typedef_destroy(
-	struct RlcParsedTypedef * this);
-
 /** Parses a typedef.
 @param[in,out] parser:
 	The parser data.
@@ -72,14 +65,6 @@ void rlc_parsed_member_typedef_create(
 	struct RlcParsedMemberTypedef * this,
 	struct RlcParsedMemberCommon const * member);
 
-/** Destroys a member typedef.
-@memberof RlcParsedMemberTypedef
-@param[in,out] this:
-	The member typedef to destroy.
-	@dassert @nonnull. */
-void rlc_parsed_member_typedef_destroy(
-	struct RlcParsedMemberTypedef * this);
-
 /** Parses a member typedef.
 @memberof RlcParsedMemberTypedef */
 _Nodiscard int rlc_parsed_member_typedef_parse(
@@ -1,7 +1,7 @@
 #include "typename.h"
 #include "expression.h"
 #include "symbolconstantexpression.h"
-#include "../malloc.h"
+#include "../vector.h"
 #include "../assert.h"
 #include "../printer.h"
 
@@ -148,87 +148,16 @@ int rlc_parsed_type_is_ptr(
 	return *isNonNull || lastMod->fTypeIndirection == kRlcTypeIndirectionPointer;
 }
 
-void rlc_type_modifier_destroy(
-	struct RlcTypeModifier * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fArraySize)
-	{
-		rlc_parsed_expression_destroy_virtual(this->fArraySize);
-		rlc_free((void**)&this->fArraySize);
-	}
-}
-
-void rlc_parsed_type_name_destroy(
-	struct RlcParsedTypeName * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fTypeModifiers)
-	{
-		for(RlcSrcIndex i = 0; i < this->fTypeModifierCount; i++)
-			rlc_type_modifier_destroy(&this->fTypeModifiers[i]);
-		rlc_free((void**)&this->fTypeModifiers);
-		this->fTypeModifierCount = 0;
-	}
-
-	switch(this->fValue)
-	{
-	case kRlcParsedTypeNameValueName:
-		{
-			if(this->fName)
-			{
-				rlc_parsed_symbol_destroy(this->fName);
-				rlc_free((void**)&this->fName);
-			}
-		} break;
-	case kRlcParsedTypeNameValueFunction:
-		{
-			if(this->fFunction)
-			{
-				rlc_parsed_function_signature_destroy(this->fFunction);
-				rlc_free((void**)&this->fFunction);
-			}
-		} break;
-	case kRlcParsedTypeNameValueExpression:
-		{
-			if(this->fExpression)
-			{
-				rlc_parsed_expression_destroy_virtual(this->fExpression);
-				rlc_free((void**)&this->fExpression);
-			}
-		} break;
-	case kRlcParsedTypeNameValueTuple:
-		{
-			if(this->fTuple.fTypes)
-			{
-				for(RlcSrcIndex i = 0; i < this->fTuple.fTypeCount; i++)
-					rlc_parsed_type_name_destroy(&this->fTuple.fTypes[i]);
-				rlc_free((void**)&this->fTuple.fTypes);
-				this->fTuple.fTypeCount = 0;
-			}
-		} break;
-	case kRlcParsedTypeNameValueVoid:
-	case kRlcParsedTypeNameValueNull:
-	case kRlcParsedTypeNameValueSymbolConstant: { ; }
-	}
-}
-
-
-
 void rlc_parsed_type_name_add_modifier(
 	struct RlcParsedTypeName * this,
-	struct RlcTypeModifier const * modifier)
+	struct RlcTypeModifier const * modifier,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(modifier != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fTypeModifiers,
-		sizeof(struct RlcTypeModifier) * ++this->fTypeModifierCount);
-
-	this->fTypeModifiers[this->fTypeModifierCount-1] = *modifier;
+	RLC_VECTOR_PUSH(arena, this->fTypeModifiers, this->fTypeModifierCount) = *modifier;
 }
 
 void rlc_parsed_type_name_create(
@@ -305,7 +234,7 @@ static int rlc_parsed_type_name_parse_impl(
 		0))
 	{
 		out->fValue = kRlcParsedTypeNameValueName;
-		rlc_malloc((void**)&out->fName, sizeof(struct RlcParsedSymbol));
+		rlc_arena_malloc(parser->fArena, (void**)&out->fName, sizeof(struct RlcParsedSymbol));
 		*out->fName = parse.fSymbol;
 		out->fNoDecay = rlc_parser_consume(
 			parser,
@@ -316,7 +245,7 @@ static int rlc_parsed_type_name_parse_impl(
 		parser))
 	{
 		out->fValue = kRlcParsedTypeNameValueFunction;
-		rlc_malloc((void**)&out->fFunction, sizeof(struct RlcParsedFunctionSignature));
+		rlc_arena_malloc(parser->fArena, (void**)&out->fFunction, sizeof(struct RlcParsedFunctionSignature));
 		*out->fFunction = parse.fFunction;
 	} else if(rlc_parser_consume(
 		parser,
@@ -338,10 +267,7 @@ static int rlc_parsed_type_name_parse_impl(
 		do {
 			if(!rlc_parsed_type_name_parse(&type, parser, 1))
 				rlc_parser_fail(parser, "expected type name");
-			rlc_realloc(
-				(void**)&out->fTuple.fTypes,
-				++out->fTuple.fTypeCount * sizeof(struct RlcParsedTypeName));
-			out->fTuple.fTypes[out->fTuple.fTypeCount-1] = type;
+			RLC_VECTOR_PUSH(parser->fArena, out->fTuple.fTypes, out->fTuple.fTypeCount) = type;
 		} while(rlc_parser_consume(parser, NULL, kRlcTokComma));
 		rlc_parser_expect(parser, NULL, 1, kRlcTokBraceClose);
 	} else
@@ -359,7 +285,8 @@ static int rlc_parsed_type_name_parse_impl(
 
 		rlc_parsed_type_name_add_modifier(
 			out,
-			&modifier);
+			&modifier,
+			parser->fArena);
 	}
 
 	return 1;
@@ -413,9 +340,7 @@ after_type_name:
 			rlc_parser_fail(parser, "expected symbol");
 
 		// Parse next type (symbol type).
-		struct RlcParsedTypeName * temp = NULL;
-		rlc_malloc((void**)&temp, sizeof(struct RlcParsedTypeName));
-		*temp = *out;
+		struct RlcParsedTypeName previous = *out;
 		if(!rlc_parsed_type_name_parse_impl(out, parser))
 			rlc_parser_fail(parser, "expected type name");
 		RLC_ASSERT(out->fValue == kRlcParsedTypeNameValueName);
@@ -423,14 +348,14 @@ after_type_name:
 		// Insert previous type as last template argument to next type.
 		struct RlcParsedSymbol * symbol = out->fName;
 		struct RlcParsedSymbolChild * child = &symbol->fChildren[symbol->fChildCount-1];
-		rlc_realloc(
-			(void**)&child->fTemplates,
-			++child->fTemplateCount * sizeof(struct RlcParsedSymbolChildTemplate));
-		struct RlcParsedSymbolChildTemplate * tpl =
-			&child->fTemplates[child->fTemplateCount-1];
+		struct RlcParsedSymbolChildTemplate * tpl = &RLC_VECTOR_PUSH(
+			parser->fArena,
+			child->fTemplates,
+			child->fTemplateCount);
 		tpl->fIsExpression = 0;
-		tpl->fSize = 1;
-		tpl->fTypeNames = temp;
+		tpl->fSize = 0;
+		tpl->fTypeNames = NULL;
+		RLC_VECTOR_PUSH(parser->fArena, tpl->fTypeNames, tpl->fSize) = previous;
 
 		goto after_type_name;
 	}
@@ -470,7 +395,7 @@ void rlc_parsed_type_name_print(
 				fputs("typename ::__rl::template unsized_array<", out);
 		}
 		if(this->fTypeModifiers[i].fTypeIndirection == kRlcTypeIndirectionFuture)
-			fputs("::std::future<", out);
+			fputs("::__rl::Future<", out);
 	}
 
 	switch(this->fValue)
@@ -589,33 +514,16 @@ void rlc_parsed_function_signature_create(
 	this->fIsAsync = 0;
 }
 
-void rlc_parsed_function_signature_destroy(
-	struct RlcParsedFunctionSignature * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	if(this->fArguments)
-	{
-		for(size_t i = this->fArgumentCount; i--;)
-			rlc_parsed_type_name_destroy(&this->fArguments[i]);
-		rlc_free((void**)&this->fArguments);
-		this->fArgumentCount = 0;
-	}
-
-	rlc_parsed_type_name_destroy(&this->fResult);
-}
-
 void rlc_parsed_function_signature_add_argument(
 	struct RlcParsedFunctionSignature * this,
-	struct RlcParsedTypeName * argument)
+	struct RlcParsedTypeName * argument,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(argument != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&this->fArguments,
-		sizeof(struct RlcParsedTypeName) * ++this->fArgumentCount);
-	this->fArguments[this->fArgumentCount-1] = *argument;
+	RLC_VECTOR_PUSH(arena, this->fArguments, this->fArgumentCount) = *argument;
 }
 
 
@@ -675,7 +583,8 @@ int rlc_parsed_function_signature_parse(
 			}
 			rlc_parsed_function_signature_add_argument(
 				out,
-				&name);
+				&name,
+				parser->fArena);
 		} while(rlc_parser_consume(
 			parser,
 			NULL,
@@ -729,7 +638,7 @@ void rlc_parsed_function_signature_print(
 
 	fprintf(out, "::__rl::function_t<");
 	if(this->fIsAsync)
-		fputs("::std::future<", out);
+		fputs("::__rl::Task<", out);
 	rlc_parsed_type_name_print(&this->fResult, file, out);
 	if(this->fIsAsync)
 		fputs(">", out);
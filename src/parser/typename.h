@@ -111,9 +111,6 @@ _Nodiscard int rlc_type_modifier_parse(
 	struct RlcParser * parser,
 	int expect_indirection);
 
-void rlc_type_modifier_destroy(
-	struct RlcTypeModifier * this);
-
 /** Controls what value the type name has. */
 enum RlcParsedTypeNameValue
 {
@@ -173,14 +170,6 @@ int rlc_parsed_type_is_ptr(
 	int * isNonNull);
 
 
-/** Destroys a type name.
-	Releases memory allocated by the given type name, but not the type name itself.
-@memberof RlcParsedTypeName
-@param[in] this:
-	The type name to destroy.
-	@dassert @nonnull */
-void rlc_parsed_type_name_destroy(
-	struct RlcParsedTypeName * this);
 /** Adds a type modifier to the type name.
 @memberof RlcParsedTypeName
 @param[in,out] this:
@@ -188,10 +177,14 @@ void rlc_parsed_type_name_destroy(
 	@dassert @nonnull
 @param[in] modifier:
 	The modifier to add to the type name. Must not be a modifier owned by the type name, because this would result in a segmentation fault in case memory had to be moved to expand the type modifier array.
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_type_name_add_modifier(
 	struct RlcParsedTypeName * this,
-	struct RlcTypeModifier const * modifier);
+	struct RlcTypeModifier const * modifier,
+	struct RlcArena * arena);
 
 /** Creates a parsed type name.
 @memberof RlcParsedTypeName
@@ -254,14 +247,6 @@ struct RlcParsedFunctionSignature
 void rlc_parsed_function_signature_create(
 	struct RlcParsedFunctionSignature * this);
 
-/** Destroys a function signature.
-@memberof RlcParsedFunctionSignature
-@param[in,out] this:
-	The function signature to destroy.
-	@dassert @nonnull */
-void rlc_parsed_function_signature_destroy(
-	struct RlcParsedFunctionSignature * this);
-
 /** Adds an argument to a function signature.
 @memberof RlcParsedFunctionSignature
 @param[in,out] this:
@@ -270,10 +255,14 @@ void rlc_parsed_function_signature_destroy(
 @param[in,out] argument:
 	The argument to add.
 	@pass_ownership
+	@dassert @nonnull
+@param[in,out] arena:
+	The arena to allocate from.
 	@dassert @nonnull */
 void rlc_parsed_function_signature_add_argument(
 	struct RlcParsedFunctionSignature * this,
-	struct RlcParsedTypeName * argument);
+	struct RlcParsedTypeName * argument,
+	struct RlcArena * arena);
 
 /** Parses a function signature.
 @memberof RlcParsedFunctionSignature
@@ -1,7 +1,6 @@
 #include "union.h"
 
 #include "../assert.h"
-#include "../malloc.h"
 
 void rlc_parsed_union_create(
 	struct RlcParsedUnion * this,
@@ -21,20 +20,6 @@ void rlc_parsed_union_create(
 	this->fTemplates = *templates;
 }
 
-void rlc_parsed_union_destroy(
-	struct RlcParsedUnion * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_member_list_destroy(
-		&this->fMembers);
-
-	rlc_parsed_template_decl_destroy(&this->fTemplates);
-
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-}
-
 int rlc_parsed_union_parse(
 	struct RlcParsedUnion * out,
 	struct RlcParser * parser,
@@ -73,17 +58,32 @@ int rlc_parsed_union_parse(
 	{
 		struct RlcParsedMemberCommon common;
 		rlc_parsed_member_common_create(&common, kRlcVisibilityPublic);
+		struct RlcParserRecovery recovery;
+		rlc_parser_recovery_push(parser, &recovery);
+
 		struct RlcParsedMember * member = NULL;
-		while((member = rlc_parsed_member_parse(
-			parser,
-			&common,
-			RLC_FLAG(kRlcParsedMemberVariable)
-			| RLC_FLAG(kRlcParsedMemberFunction))))
+		for(;;)
 		{
+			rlc_parser_recovery_mark(parser, &recovery);
+			if(setjmp(recovery.fJump))
+				continue;
+
+			if(!(member = rlc_parsed_member_parse(
+				parser,
+				&common,
+				RLC_FLAG(kRlcParsedMemberVariable)
+				| RLC_FLAG(kRlcParsedMemberFunction))))
+			{
+				if(rlc_parser_eof(parser) || rlc_parser_is_current(parser, kRlcTokBraceClose))
+					break;
+				rlc_parser_fail(parser, "expected member");
+			}
 			rlc_parsed_member_list_add(
 				&out->fMembers,
-				member);
+				member,
+				parser->fArena);
 		}
+		rlc_parser_recovery_pop(parser, &recovery);
 	}
 
 	rlc_parser_expect(
@@ -176,18 +176,6 @@ void rlc_parsed_member_union_create(
 		common);
 }
 
-void rlc_parsed_member_union_destroy(
-	struct RlcParsedMemberUnion * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_member_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedMember));
-
-	rlc_parsed_union_destroy(
-		RLC_BASE_CAST(this, RlcParsedUnion));
-}
-
 int rlc_parsed_member_union_parse(
 	struct RlcParsedMemberUnion * out,
 	struct RlcParser * parser,
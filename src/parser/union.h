@@ -36,13 +36,6 @@ void rlc_parsed_union_create(
 	struct RlcSrcString const * name,
 	struct RlcParsedTemplateDecl const * templates);
 
-/** Destroys a parsed union.
-@memberof RlcParsedUnion
-@param[in] this:
-	The union to destroy.*/
-void rlc_parsed_union_destroy(
-	struct RlcParsedUnion * this);
-
 _Nodiscard int rlc_parsed_union_parse(
 	struct RlcParsedUnion * out,
 	struct RlcParser * parser,
@@ -66,9 +59,6 @@ void rlc_parsed_member_union_create(
 	struct RlcParsedMemberUnion * this,
 	struct RlcParsedMemberCommon const * common);
 
-void rlc_parsed_member_union_destroy(
-	struct RlcParsedMemberUnion * this);
-
 _Nodiscard int rlc_parsed_member_union_parse(
 	struct RlcParsedMemberUnion * out,
 	struct RlcParser * parser,
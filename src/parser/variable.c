@@ -1,6 +1,6 @@
 #include "variable.h"
 
-#include "../malloc.h"
+#include "../vector.h"
 #include "../assert.h"
 
 void rlc_parsed_variable_create(
@@ -26,41 +26,16 @@ void rlc_parsed_variable_create(
 	this->fInitArgCount = 0;
 }
 
-void rlc_parsed_variable_destroy(
-	struct RlcParsedVariable * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_scope_entry_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedScopeEntry));
-
-	rlc_parsed_template_decl_destroy(&this->fTemplates);
-	if(this->fHasType)
-		rlc_parsed_type_name_destroy(&this->fType);
-
-	if(this->fInitArgs)
-	{
-		for(size_t i = this->fInitArgCount; i--;)
-		{
-			rlc_parsed_expression_destroy_virtual(this->fInitArgs[i]);
-			rlc_free((void**)&this->fInitArgs[i]);
-		}
-		rlc_free((void**)&this->fInitArgs);
-	}
-}
-
 static void rlc_parsed_variable_add_arg(
 	struct RlcParsedVariable * out,
-	struct RlcParsedExpression * arg)
+	struct RlcParsedExpression * arg,
+	struct RlcArena * arena)
 {
 	RLC_DASSERT(out != NULL);
 	RLC_DASSERT(arg != NULL);
+	RLC_DASSERT(arena != NULL);
 
-	rlc_realloc(
-		(void**)&out->fInitArgs,
-		sizeof(struct RlcParsedExpression *) * ++out->fInitArgCount);
-
-	out->fInitArgs[out->fInitArgCount - 1] = arg;
+	RLC_VECTOR_PUSH(arena, out->fInitArgs, out->fInitArgCount) = arg;
 }
 
 
@@ -224,7 +199,7 @@ int rlc_parsed_variable_parse(
 			RLC_ALL_FLAGS(RlcParsedExpressionType));
 		if(!init)
 			rlc_parser_fail(parser, "expected expression");
-		rlc_parsed_variable_add_arg(out, init);
+		rlc_parsed_variable_add_arg(out, init, parser->fArena);
 	} else
 	{
 		if(!rlc_parsed_type_name_parse(
@@ -270,7 +245,7 @@ int rlc_parsed_variable_parse(
 						if(!arg)
 							rlc_parser_fail(parser, "expected expression");
 
-						rlc_parsed_variable_add_arg(out, arg);
+						rlc_parsed_variable_add_arg(out, arg, parser->fArena);
 					} while(isParenthese && rlc_parser_consume(
 						parser,
 						NULL,
@@ -307,8 +282,13 @@ void rlc_parsed_variable_print(
 	rlc_parsed_variable_print_argument(this, file, printer->fVars, 0);
 	fputs(";\n", printer->fVars);
 
+	rlc_printer_begin_definition(
+		printer,
+		printer->fVarsImpl,
+		kRlcPrinterDefinitionOrdered);
 	rlc_parsed_variable_print_argument(this, file, printer->fVarsImpl, 1);
 	fputs(";\n", printer->fVarsImpl);
+	rlc_printer_end_definition(printer, printer->fVarsImpl);
 }
 
 static void rlc_parsed_variable_print_argument_1(
@@ -403,18 +383,6 @@ void rlc_parsed_member_variable_create(
 		member);
 }
 
-void rlc_parsed_member_variable_destroy(
-	struct RlcParsedMemberVariable * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_variable_destroy(
-		RLC_BASE_CAST(this, RlcParsedVariable));
-
-	rlc_parsed_member_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedMember));
-}
-
 int rlc_parsed_member_variable_parse(
 	struct RlcParsedMemberVariable * out,
 	struct RlcParser * parser,
@@ -488,6 +456,14 @@ void rlc_parsed_member_variable_print(
 	{
 		out = printer->fVarsImpl;
 
+		// Static members are initialised in declaration order, like global variables.
+		enum RlcPrinterDefinition definition = rlc_printer_definition(printer, NULL);
+		rlc_printer_begin_definition(
+			printer,
+			out,
+			definition == kRlcPrinterDefinitionShared
+				? kRlcPrinterDefinitionShared
+				: kRlcPrinterDefinitionOrdered);
 		rlc_printer_print_ctx_tpl(printer, file, out);
 		rlc_parsed_variable_print_argument_1(
 			RLC_BASE_CAST(this, RlcParsedVariable),
@@ -502,5 +478,6 @@ void rlc_parsed_member_variable_print(
 			out,
 			1);
 		fputs(";\n", out);
+		rlc_printer_end_definition(printer, out);
 	}
 }
\ No newline at end of file
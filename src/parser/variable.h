@@ -52,14 +52,6 @@ void rlc_parsed_variable_create(
 	struct RlcSrcString const * name,
 	struct RlcParsedTemplateDecl const * templates);
 
-/** Destroys a variable.
-@memberof RlcParsedVariable
-@param[in,out] this:
-	The variable to destroy.
-	@dassert @nonnull */
-void rlc_parsed_variable_destroy(
-	struct RlcParsedVariable * this);
-
 /** Parses a variable.
 	Syntax:
 
@@ -122,13 +114,6 @@ void rlc_parsed_member_variable_create(
 	struct RlcParsedMemberVariable * this,
 	struct RlcParsedMemberCommon const * member);
 
-/** Destroys a parsed member variable.
-@memberof RlcParsedMemberVariable
-@param[in] this:
-	The parsed member variable to destroy. */
-void rlc_parsed_member_variable_destroy(
-	struct RlcParsedMemberVariable * this);
-
 /** Parses a member variable, but does not parse the `RlcParsedMember` base instance.
 	To completely parse it, call `rlc_parsed_member_parse_base()` beforehand on a seperate `RlcParsedMember` instance and assign it to `out` afterwards.
 @memberof RlcParsedMemberVariable
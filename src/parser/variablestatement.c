@@ -13,16 +13,6 @@ void rlc_parsed_variable_statement_create(
 		kRlcParsedVariableStatement);
 }
 
-void rlc_parsed_variable_statement_destroy(
-	struct RlcParsedVariableStatement * this)
-{
-	RLC_DASSERT(this != NULL);
-
-	rlc_parsed_variable_destroy(&this->fVariable);
-	rlc_parsed_statement_destroy_base(
-		RLC_BASE_CAST(this, RlcParsedStatement));
-}
-
 int rlc_parsed_variable_statement_parse(
 	struct RlcParsedVariableStatement * out,
 	struct RlcParser * parser)
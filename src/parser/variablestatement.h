@@ -26,14 +26,6 @@ struct RlcParsedVariableStatement
 void rlc_parsed_variable_statement_create(
 	struct RlcParsedVariableStatement * this);
 
-/** Destroys a variable statement.
-@memberof RlcParsedVariableStatement
-@param[out] this:
-	The variable statement to destroy.
-	@dassert @nonnull */
-void rlc_parsed_variable_statement_destroy(
-	struct RlcParsedVariableStatement * this);
-
 /** Parses a variable declaration statement.
 @memberof RlcParsedVariableStatement
 @param[out] out:
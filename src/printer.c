@@ -1,6 +1,9 @@
 #include "printer.h"
 #include "assert.h"
 #include "parser/templatedecl.h"
+#include "vector.h"
+
+#include <stdint.h>
 
 void rlc_printer_add_ctx(
 	struct RlcPrinter * printer,
@@ -76,4 +79,122 @@ void rlc_printer_print_ctx_symbol(
 			fputs(">", out);
 		}
 	}
-}
\ No newline at end of file
+}
+enum RlcPrinterDefinition rlc_printer_definition(
+	struct RlcPrinter const * printer,
+	struct RlcParsedTemplateDecl const * templates)
+{
+	RLC_DASSERT(printer != NULL);
+
+	if(templates && rlc_parsed_template_decl_exists(templates))
+		return kRlcPrinterDefinitionShared;
+	for(struct RlcPrinterCtx * ctx = printer->outerCtx; ctx != NULL; ctx = ctx->next)
+		if(ctx->tpl && rlc_parsed_template_decl_exists(ctx->tpl))
+			return kRlcPrinterDefinitionShared;
+	return kRlcPrinterDefinitionExclusive;
+}
+
+/** Returns the index of an implementation stream in `RlcPrinterUnits::fRanges`. */
+static int stream_index(
+	struct RlcPrinter const * printer,
+	FILE * out)
+{
+	RLC_DASSERT(out == printer->fVarsImpl || out == printer->fFuncsImpl);
+	return out == printer->fFuncsImpl;
+}
+
+void rlc_printer_begin_definition(
+	struct RlcPrinter const * printer,
+	FILE * out,
+	enum RlcPrinterDefinition type)
+{
+	RLC_DASSERT(printer != NULL);
+
+	struct RlcPrinterUnits * units = printer->fUnits;
+	if(!units || units->fDepth++ || type == kRlcPrinterDefinitionShared)
+		return;
+
+	int const stream = stream_index(printer, out);
+	struct RlcPrinterRange * range = &RLC_VECTOR_PUSH(NULL,
+		units->fRanges[stream],
+		units->fRangeCount[stream]);
+	range->fStart = ftell(out);
+	range->fEnd = SIZE_MAX;
+	range->fType = type;
+}
+
+void rlc_printer_end_definition(
+	struct RlcPrinter const * printer,
+	FILE * out)
+{
+	RLC_DASSERT(printer != NULL);
+
+	struct RlcPrinterUnits * units = printer->fUnits;
+	if(!units)
+		return;
+	RLC_DASSERT(units->fDepth);
+	if(--units->fDepth)
+		return;
+
+	int const stream = stream_index(printer, out);
+	size_t const count = units->fRangeCount[stream];
+	if(count && units->fRanges[stream][count-1].fEnd == SIZE_MAX)
+		units->fRanges[stream][count-1].fEnd = ftell(out);
+}
+
+void rlc_printer_units_write(
+	struct RlcPrinterUnits const * units,
+	int funcs,
+	char const * text,
+	size_t length,
+	unsigned unit,
+	unsigned unit_count,
+	FILE * out)
+{
+	RLC_DASSERT(units != NULL);
+	RLC_DASSERT(unit < unit_count);
+	RLC_DASSERT(out != NULL);
+
+	struct RlcPrinterRange const * ranges = units->fRanges[!!funcs];
+	size_t const count = units->fRangeCount[!!funcs];
+
+	size_t total = 0;
+	for(size_t i = 0; i < count; i++)
+		if(ranges[i].fType == kRlcPrinterDefinitionExclusive)
+			total += ranges[i].fEnd - ranges[i].fStart;
+
+	// Exclusive definitions are assigned to units by the position of their first byte within all exclusive code.
+	size_t offset = 0, written = 0;
+	for(size_t i = 0; i < count; i++)
+	{
+		size_t const size = ranges[i].fEnd - ranges[i].fStart;
+		RLC_DASSERT(ranges[i].fStart >= written && ranges[i].fEnd <= length);
+
+		fwrite(text + written, 1, ranges[i].fStart - written, out);
+		written = ranges[i].fEnd;
+
+		int own;
+		if(ranges[i].fType == kRlcPrinterDefinitionOrdered || !total)
+			own = !unit;
+		else
+		{
+			own = (size_t)((offset * (unsigned long long)unit_count) / total) == unit;
+			offset += size;
+		}
+
+		if(own)
+			fwrite(text + ranges[i].fStart, 1, size, out);
+	}
+	fwrite(text + written, 1, length - written, out);
+}
+
+void rlc_printer_units_destroy(
+	struct RlcPrinterUnits * units)
+{
+	RLC_DASSERT(units != NULL);
+
+	rlc_vector_free((void**)&units->fRanges[0]);
+	rlc_vector_free((void**)&units->fRanges[1]);
+	units->fRangeCount[0] = 0;
+	units->fRangeCount[1] = 0;
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <stdio.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,6 +20,37 @@ struct RlcPrinterCtx
 	struct RlcPrinterCtx * next, * prev;
 };
 
+/** How a definition in an implementation stream is distributed over translation units. */
+enum RlcPrinterDefinition
+{
+	/** Compiled into every unit, such as templates and inline functions. */
+	kRlcPrinterDefinitionShared,
+	/** Compiled into exactly one unit. */
+	kRlcPrinterDefinitionExclusive,
+	/** Compiled into the first unit, keeping its order, as it runs during static initialisation. */
+	kRlcPrinterDefinitionOrdered
+};
+
+/** A definition that is not compiled into every translation unit. */
+struct RlcPrinterRange
+{
+	/** The definition's start offset in its stream. */
+	size_t fStart;
+	/** The definition's end offset in its stream. */
+	size_t fEnd;
+	enum RlcPrinterDefinition fType;
+};
+
+/** Records which parts of the implementation streams can be split into several translation units. */
+struct RlcPrinterUnits
+{
+	/** The non-shared definitions in `fVarsImpl` (0) and `fFuncsImpl` (1), in order. */
+	struct RlcPrinterRange * fRanges[2];
+	size_t fRangeCount[2];
+	/** The number of definitions currently being printed. Only the outermost one is recorded. */
+	unsigned fDepth;
+};
+
 struct RlcPrinter
 {
 	/** The number of the current compilation unit. */
@@ -34,6 +66,9 @@ struct RlcPrinter
 
 	struct RlcPrinterCtx * outerCtx;
 	struct RlcPrinterCtx * innerCtx;
+
+	/** If not null, records definitions so that the code can be split into several translation units. */
+	struct RlcPrinterUnits * fUnits;
 };
 
 void rlc_printer_add_ctx(
@@ -54,6 +89,67 @@ void rlc_printer_print_ctx_symbol(
 	struct RlcSrcFile const * file,
 	FILE * out);
 
+/** Decides how a definition is distributed over translation units.
+	Definitions of templates, including members of class templates, must be visible in every unit that instantiates them.
+@param[in] printer:
+	The printer, whose context is checked for templates.
+	@dassert @nonnull
+@param[in] templates:
+	The definition's own template declaration, or null. */
+enum RlcPrinterDefinition rlc_printer_definition(
+	struct RlcPrinter const * printer,
+	struct RlcParsedTemplateDecl const * templates);
+
+/** Marks the start of a definition in `fVarsImpl` or `fFuncsImpl`.
+	Every call must be followed by a call to `rlc_printer_end_definition()`.
+@param[in] printer:
+	The printer.
+	@dassert @nonnull
+@param[in] out:
+	The implementation stream the definition is printed to.
+@param[in] type:
+	How the definition is distributed over translation units. */
+void rlc_printer_begin_definition(
+	struct RlcPrinter const * printer,
+	FILE * out,
+	enum RlcPrinterDefinition type);
+
+/** Marks the end of a definition, see `rlc_printer_begin_definition()`. */
+void rlc_printer_end_definition(
+	struct RlcPrinter const * printer,
+	FILE * out);
+
+/** Writes one translation unit's part of an implementation stream.
+	Exclusive definitions are distributed over the units in contiguous, evenly sized runs. Ordered definitions go to the first unit.
+@param[in] units:
+	The recorded definitions.
+	@dassert @nonnull
+@param[in] funcs:
+	Whether the stream is `fFuncsImpl`, otherwise it is `fVarsImpl`.
+@param[in] text:
+	The stream's contents.
+@param[in] length:
+	The length of `text`.
+@param[in] unit:
+	The translation unit to write.
+@param[in] unit_count:
+	The number of translation units.
+@param[in] out:
+	The file to write to.
+	@dassert @nonnull */
+void rlc_printer_units_write(
+	struct RlcPrinterUnits const * units,
+	int funcs,
+	char const * text,
+	size_t length,
+	unsigned unit,
+	unsigned unit_count,
+	FILE * out);
+
+/** Releases the recorded definitions. */
+void rlc_printer_units_destroy(
+	struct RlcPrinterUnits * units);
+
 #ifdef __cplusplus
 }
 #endif
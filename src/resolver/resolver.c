@@ -1,10 +1,9 @@
 #include "resolver.h"
 #include "../assert.h"
+#include "../diagnostics.h"
 
 #include <stdio.h>
-#include <stdlib.h>
 #include <stdarg.h>
-#include <unistd.h>
 
 static _Noreturn void va_fail(
 	struct RlcSrcString const * string,
@@ -16,25 +15,11 @@ static _Noreturn void va_fail(
 	RLC_DASSERT(file != NULL);
 	RLC_DASSERT(msg != NULL);
 
-	fflush(stdout);
-	usleep(125 * 1000);
-
-
-	struct RlcSrcPosition pos;
-	rlc_src_file_position(
-		file,
-		&pos,
-		string->start);
-
-	fprintf(stderr, "%s:%u:%u: error: ",
-		file->fName,
-		pos.line,
-		pos.column);
-	vfprintf(stderr, msg, ap);
-	fprintf(stderr, ".\n");
-	fflush(stderr);
-
-	exit(EXIT_FAILURE);
+	// The resolver cannot continue after an error, so report it together with all errors collected so far.
+	char message[1024];
+	vsnprintf(message, sizeof(message), msg, ap);
+	rlc_diagnostics_error(file, string->start, "%s.", message);
+	rlc_diagnostics_fail();
 }
 
 _Noreturn void rlc_resolver_fail(
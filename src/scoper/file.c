@@ -1,19 +1,25 @@
 #include "file.h"
 #include "fileregistry.h"
 #include "../malloc.h"
+#include "../vector.h"
 #include "../printer.h"
 
+#include <stdint.h>
+#include <string.h>
+
 void rlc_scoped_file_create(
 	struct RlcScopedFile * this,
 	char const * path,
-	struct RlcParsedFile * parsed)
+	struct RlcParsedFile * parsed,
+	size_t index)
 {
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(path != NULL);
 
 	this->path = path;
 	this->parsed = parsed;
-	this->lastPrinted = 0;
+	this->index = index;
+	this->ordered = 0;
 	rlc_scoped_include_list_create(&this->includes);
 	rlc_scoped_include_list_create(&this->includedBy);
 }
@@ -46,24 +52,61 @@ void rlc_scoped_file_populate_includes(
 		rlc_scoped_include_statement_destroy(&inc_stmt);
 		RLC_DASSERT(inc_file);
 
-		// Ignore direct cycles.
+		// Ignore direct cycles. Indirect includes are not stored, but reached through the included files.
 		if(inc_file != this)
 		{
 			rlc_scoped_include_list_add(&this->includes, inc_file, 0);
 			rlc_scoped_include_list_add(&inc_file->includedBy, this, 0);
 		}
+	}
+
+	RLC_VECTOR_SHRINK(NULL, this->includes.fPaths, this->includes.fPathCount);
+}
 
-		for(RlcSrcIndex i = 0; i < inc_file->includes.fPathCount; i++)
+int rlc_scoped_file_reaches(
+	struct RlcScopedFile const * this,
+	struct RlcScopedFile const * other,
+	struct RlcScopedFileRegistry const * registry)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(other != NULL);
+	RLC_DASSERT(registry != NULL);
+
+	size_t const words = (registry->fFileCount + 63) / 64;
+	uint64_t * visited = NULL;
+	rlc_malloc((void**)&visited, words * sizeof(uint64_t));
+	memset(visited, 0, words * sizeof(uint64_t));
+
+	struct RlcScopedFile const ** stack = NULL;
+	size_t stack_size = 0;
+	RLC_VECTOR_PUSH(NULL, stack, stack_size) = this;
+	visited[this->index / 64] |= UINT64_C(1) << (this->index % 64);
+
+	int found = 0;
+	while(stack_size && !found)
+	{
+		struct RlcScopedFile const * file = stack[--stack_size];
+		for(RlcSrcIndex i = 0; i < file->includes.fPathCount; i++)
 		{
-			struct RlcScopedFile * transitive_inc = inc_file->includes.fPaths[i].fFile;
-			// Ignore indirect cycles.
-			if(transitive_inc != this)
+			struct RlcScopedFile const * inc = file->includes.fPaths[i].fFile;
+			if(inc == other)
 			{
-				rlc_scoped_include_list_add(&this->includes, transitive_inc, 0);
-				rlc_scoped_include_list_add(&transitive_inc->includedBy, this, 0);
+				found = 1;
+				break;
+			}
+
+			uint64_t const bit = UINT64_C(1) << (inc->index % 64);
+			if(!(visited[inc->index / 64] & bit))
+			{
+				visited[inc->index / 64] |= bit;
+				RLC_VECTOR_PUSH(NULL, stack, stack_size) = inc;
 			}
 		}
 	}
+
+	rlc_vector_free((void**)&stack);
+	rlc_free((void**)&visited);
+	return found;
 }
 
 void rlc_scoped_file_print(
@@ -75,25 +118,19 @@ void rlc_scoped_file_print(
 	RLC_DASSERT(registry != NULL);
 	RLC_DASSERT(printer != NULL);
 
-	if(this->lastPrinted)// > printer->fCompilationUnit)
-		return;
-
-
-	this->lastPrinted = printer->fCompilationUnit + 1;
-
-	for(RlcSrcIndex i = 0; i < this->includes.fPathCount; i++)
-		rlc_scoped_file_print(
-			this->includes.fPaths[i].fFile,
-			registry,
+	for(size_t i = rlc_scoped_file_registry_order(registry, this);
+		i < registry->fOrderCount;
+		i++)
+	{
+		struct RlcScopedFile * file = registry->fOrder[i];
+		fprintf(printer->fTypes, "////// %s:Types\n", file->path);
+		fprintf(printer->fVars, "////// %s:Vars\n", file->path);
+		fprintf(printer->fFuncs, "////// %s:Funcs\n", file->path);
+		fprintf(printer->fTypesImpl, "////// %s:TypesImpl\n", file->path);
+		fprintf(printer->fVarsImpl, "////// %s:VarsImpl\n", file->path);
+		fprintf(printer->fFuncsImpl, "////// %s:FuncsImpl\n", file->path);
+		rlc_parsed_file_print(
+			file->parsed,
 			printer);
-
-	fprintf(printer->fTypes, "////// %s:Types\n", this->path);
-	fprintf(printer->fVars, "////// %s:Vars\n", this->path);
-	fprintf(printer->fFuncs, "////// %s:Funcs\n", this->path);
-	fprintf(printer->fTypesImpl, "////// %s:TypesImpl\n", this->path);
-	fprintf(printer->fVarsImpl, "////// %s:VarsImpl\n", this->path);
-	fprintf(printer->fFuncsImpl, "////// %s:FuncsImpl\n", this->path);
-	rlc_parsed_file_print(
-		this->parsed,
-		printer);
+	}
 }
\ No newline at end of file
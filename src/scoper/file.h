@@ -17,19 +17,22 @@ struct RlcScopedFile
 	char const * path;
 
 	struct RlcParsedFile * parsed;
+	/** The file's index in its registry. */
+	size_t index;
 
-	/** The source file's includes. */
+	/** The files directly included by the source file, in order of appearance. */
 	struct RlcScopedIncludeList includes;
-	/** Files including this file. */
+	/** Files directly including this file. */
 	struct RlcScopedIncludeList includedBy;
-	/** The last compilation unit this file has been printed in. */
-	unsigned lastPrinted;
+	/** Whether the file is in its registry's topological order. */
+	int ordered;
 };
 
 void rlc_scoped_file_create(
 	struct RlcScopedFile * this,
 	char const * path,
-	struct RlcParsedFile * parsed);
+	struct RlcParsedFile * parsed,
+	size_t index);
 
 void rlc_scoped_file_destroy(
 	struct RlcScopedFile * this);
@@ -39,6 +42,28 @@ void rlc_scoped_file_populate_includes(
 	struct RlcScopedFileRegistry * registry,
 	struct RlcParsedFile const * parsed);
 
+/** Checks whether a file includes another file, directly or indirectly.
+	Walks the direct includes on demand, marking visited files in a bitset.
+@memberof RlcScopedFile
+@param[in] this:
+	The including file.
+	@dassert @nonnull
+@param[in] other:
+	The possibly included file.
+	@dassert @nonnull
+@param[in] registry:
+	The registry both files belong to.
+	@dassert @nonnull
+@return
+	Whether `other` is reachable from `this` via include statements. */
+_Nodiscard int rlc_scoped_file_reaches(
+	struct RlcScopedFile const * this,
+	struct RlcScopedFile const * other,
+	struct RlcScopedFileRegistry const * registry);
+
+/** Prints a file and all files it includes that were not printed yet.
+	Walks the registry's topological order, so included files are printed before their includers.
+@memberof RlcScopedFile */
 void rlc_scoped_file_print(
 	struct RlcScopedFile * this,
 	struct RlcScopedFileRegistry * registry,
@@ -2,9 +2,12 @@
 #include "../fs.h"
 #include "../assert.h"
 #include "../malloc.h"
+#include "../vector.h"
+#include "../threadpool.h"
 
 #include <string.h>
 #include <stdlib.h>
+#include <pthread.h>
 
 static void read_include_dirs(
 	struct RlcScopedFileRegistry * this)
@@ -23,17 +26,16 @@ static void read_include_dirs(
 			start = dirs+1;
 			continue;
 		}
-		rlc_realloc(
-			(void**)&this->fIncludeDirs,
-			sizeof(char const *) * ++this->fIncludeDirCount);
 		char * dir = NULL;
 		rlc_malloc((void**)&dir, len + 1);
 		memcpy(dir, start, len);
 		dir[len] = '\0';
-		this->fIncludeDirs[this->fIncludeDirCount-1] = dir;
+		RLC_VECTOR_PUSH(NULL, this->fIncludeDirs, this->fIncludeDirCount) = dir;
 
 		start = dirs + 1;
 	} while(dirs);
+
+	RLC_VECTOR_SHRINK(NULL, this->fIncludeDirs, this->fIncludeDirCount);
 }
 
 void rlc_scoped_file_registry_create(
@@ -43,6 +45,9 @@ void rlc_scoped_file_registry_create(
 
 	this->fFiles = NULL;
 	this->fFileCount = 0;
+	rlc_hash_map_create(&this->fIndex, kRlcHashMapKeyString);
+	this->fOrder = NULL;
+	this->fOrderCount = 0;
 	this->fIncludeDirs = NULL;
 	this->fIncludeDirCount = 0;
 	read_include_dirs(this);
@@ -55,18 +60,19 @@ void rlc_scoped_file_registry_destroy(
 	for(RlcSrcIndex i = 0; i < this->fIncludeDirCount; i++)
 		rlc_free((void**)&this->fIncludeDirs[i]);
 
-	if(this->fIncludeDirs)
-		rlc_free((void**)&this->fIncludeDirs);
+	rlc_vector_free((void**)&this->fIncludeDirs);
 	this->fIncludeDirCount = 0;
 
+	rlc_hash_map_destroy(&this->fIndex);
+	rlc_vector_free((void**)&this->fOrder);
+	this->fOrderCount = 0;
 	for(RlcSrcIndex i = 0; i < this->fFileCount; i++)
 	{
 		rlc_scoped_file_destroy(this->fFiles[i]);
 		rlc_free((void**)&this->fFiles[i]);
 	}
 
-	if(this->fFiles)
-		rlc_free((void**)&this->fFiles);
+	rlc_vector_free((void**)&this->fFiles);
 	this->fFileCount = 0;
 
 	rlc_parsed_file_registry_destroy(&this->fParseRegistry);
@@ -78,13 +84,11 @@ struct RlcScopedFile * rlc_scoped_file_registry_get(
 	struct RlcScopedFileRegistry * this,
 	char const * file)
 {
-	for(size_t i = 0; i < this->fFileCount; i++)
+	void ** known = rlc_hash_map_find(&this->fIndex, file);
+	if(known)
 	{
-		if(!strcmp(this->fFiles[i]->path, file))
-		{
-			rlc_free((void**)&file);
-			return this->fFiles[i];
-		}
+		rlc_free((void**)&file);
+		return *known;
 	}
 
 	struct RlcParsedFile * parsed = rlc_parsed_file_registry_get(
@@ -92,21 +96,188 @@ struct RlcScopedFile * rlc_scoped_file_registry_get(
 		file);
 
 	if(!parsed)
+	{
+		rlc_free((void**)&file);
 		return NULL;
+	}
 
-	rlc_realloc(
-		(void**)&this->fFiles,
-		sizeof(struct RlcScopedFile *) * ++this->fFileCount);
 	struct RlcScopedFile * scoped = NULL;
 	rlc_malloc((void**)&scoped, sizeof(struct RlcScopedFile));
-	this->fFiles[this->fFileCount-1] = scoped;
+	RLC_VECTOR_PUSH(NULL, this->fFiles, this->fFileCount) = scoped;
 
-	rlc_scoped_file_create(scoped, file, parsed);
+	rlc_scoped_file_create(scoped, file, parsed, this->fFileCount-1);
+	rlc_hash_map_insert(&this->fIndex, scoped->path, scoped);
 	rlc_scoped_file_populate_includes(scoped, this, parsed);
 
 	return scoped;
 }
 
+/** The state shared by the tasks of a parallel parse. */
+struct RlcScopedParseBatch
+{
+	/** The registry to parse into. */
+	struct RlcScopedFileRegistry * fRegistry;
+	/** Protects the discovered paths. */
+	pthread_mutex_t fLock;
+	/** The paths of all discovered files. Owned by the batch. */
+	char const ** fPaths;
+	/** The number of discovered files. */
+	size_t fPathCount;
+	/** Indexes `fPaths`. */
+	struct RlcHashMap fIndex;
+};
+
+/** A file to parse. */
+struct RlcScopedParseJob
+{
+	/** The parse the file belongs to. */
+	struct RlcScopedParseBatch * fBatch;
+	/** The file's path. */
+	char const * fPath;
+};
+
+static void parse_task(
+	struct RlcThreadPool * pool,
+	void * context);
+
+/** Submits a file to parse, unless it was already discovered.
+	Takes ownership of the path. */
+static void discover(
+	struct RlcThreadPool * pool,
+	struct RlcScopedParseBatch * batch,
+	char const * path)
+{
+	pthread_mutex_lock(&batch->fLock);
+	int const added = rlc_hash_map_insert(&batch->fIndex, path, NULL);
+	if(added)
+		RLC_VECTOR_PUSH(NULL, batch->fPaths, batch->fPathCount) = path;
+	pthread_mutex_unlock(&batch->fLock);
+
+	if(!added)
+	{
+		rlc_free((void**)&path);
+		return;
+	}
+
+	struct RlcScopedParseJob * job = NULL;
+	rlc_malloc((void**)&job, sizeof(struct RlcScopedParseJob));
+	job->fBatch = batch;
+	job->fPath = path;
+	rlc_thread_pool_submit(pool, &parse_task, job);
+}
+
+/** Parses a file, then discovers its includes. */
+static void parse_task(
+	struct RlcThreadPool * pool,
+	void * context)
+{
+	struct RlcScopedParseJob * job = context;
+	struct RlcScopedParseBatch * batch = job->fBatch;
+	struct RlcParsedFile * parsed = rlc_parsed_file_registry_get(
+		&batch->fRegistry->fParseRegistry,
+		job->fPath);
+	rlc_free((void**)&job);
+
+	if(!parsed)
+		return;
+
+	struct RlcScopedIncludeStatement inc_stmt;
+	for(size_t i = 0; i < parsed->fIncludeCount; i++)
+	{
+		char const * path = rlc_scope_include_statement(
+			&inc_stmt,
+			&parsed->fIncludes[i],
+			&parsed->fSource,
+			batch->fRegistry);
+		rlc_scoped_include_statement_destroy(&inc_stmt);
+		discover(pool, batch, path);
+	}
+}
+
+void rlc_scoped_file_registry_parse(
+	struct RlcScopedFileRegistry * this,
+	char const * const * files,
+	size_t file_count,
+	size_t threads)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(files != NULL);
+	RLC_DASSERT(threads > 0);
+
+	struct RlcScopedParseBatch batch;
+	batch.fRegistry = this;
+	pthread_mutex_init(&batch.fLock, NULL);
+	batch.fPaths = NULL;
+	batch.fPathCount = 0;
+	rlc_hash_map_create(&batch.fIndex, kRlcHashMapKeyString);
+
+	struct RlcThreadPool pool;
+	rlc_thread_pool_create(&pool, threads);
+
+	for(size_t i = 0; i < file_count; i++)
+	{
+		if(!files[i])
+			continue;
+
+		size_t const len = strlen(files[i]);
+		char * path = NULL;
+		rlc_malloc((void**)&path, len + 1);
+		memcpy(path, files[i], len + 1);
+		discover(&pool, &batch, path);
+	}
+
+	rlc_thread_pool_destroy(&pool);
+
+	rlc_hash_map_destroy(&batch.fIndex);
+	for(size_t i = 0; i < batch.fPathCount; i++)
+		rlc_free((void**)&batch.fPaths[i]);
+	rlc_vector_free((void**)&batch.fPaths);
+	pthread_mutex_destroy(&batch.fLock);
+}
+
+size_t rlc_scoped_file_registry_order(
+	struct RlcScopedFileRegistry * this,
+	struct RlcScopedFile * file)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(file != NULL);
+
+	size_t const start = this->fOrderCount;
+	if(file->ordered)
+		return start;
+
+	// Iterative depth-first search, emitting files in post-order.
+	struct Frame {
+		struct RlcScopedFile * fFile;
+		RlcSrcIndex fNextInclude;
+	} * stack = NULL;
+	size_t stack_size = 0;
+
+	file->ordered = 1;
+	RLC_VECTOR_PUSH(NULL, stack, stack_size) = (struct Frame){ file, 0 };
+	while(stack_size)
+	{
+		struct Frame * top = &stack[stack_size-1];
+		if(top->fNextInclude < top->fFile->includes.fPathCount)
+		{
+			struct RlcScopedFile * inc =
+				top->fFile->includes.fPaths[top->fNextInclude++].fFile;
+			if(!inc->ordered)
+			{
+				inc->ordered = 1;
+				RLC_VECTOR_PUSH(NULL, stack, stack_size) = (struct Frame){ inc, 0 };
+			}
+		} else
+		{
+			RLC_VECTOR_PUSH(NULL, this->fOrder, this->fOrderCount) = top->fFile;
+			--stack_size;
+		}
+	}
+
+	rlc_vector_free((void**)&stack);
+	return start;
+}
+
 char const * rlc_scoped_file_registry_resolve_global(
 	struct RlcScopedFileRegistry const * this,
 	char const * path,
@@ -4,6 +4,7 @@
 #include <stddef.h>
 
 #include "../parser/fileregistry.h"
+#include "../hashmap.h"
 #include "file.h"
 
 #ifdef __cplusplus
@@ -14,6 +15,12 @@ struct RlcScopedFileRegistry
 {
 	struct RlcScopedFile * * fFiles;
 	size_t fFileCount;
+	/** Maps canonical paths to scoped files. */
+	struct RlcHashMap fIndex;
+	/** The files reached from the files printed so far, in topological order: included files precede their includers. */
+	struct RlcScopedFile * * fOrder;
+	/** The number of files in the topological order. */
+	size_t fOrderCount;
 
 	/** Include directories. */
 	char const ** fIncludeDirs;
@@ -30,11 +37,47 @@ void rlc_scoped_file_registry_destroy(
 	struct RlcScopedFileRegistry * this);
 
 /** Queries a file from the registry.
-	If the file was not registered, tries to parse and scope it. */
+	If the file was not registered, tries to parse and scope it.
+	Takes ownership of the file name. */
 struct RlcScopedFile * rlc_scoped_file_registry_get(
 	struct RlcScopedFileRegistry * this,
 	char const * file);
 
+/** Parses files and all files they include, on multiple threads.
+	Every discovered include is handed to a work-stealing thread pool, so that independent files are read, tokenised and parsed concurrently. Only fills the parsed file registry: the files are scoped afterwards, in the usual order, by `rlc_scoped_file_registry_get()`.
+@memberof RlcScopedFileRegistry
+@param[in,out] this:
+	The registry.
+	@dassert @nonnull
+@param[in] files:
+	The absolute paths of the files to parse. Null entries are ignored.
+	@dassert @nonnull
+@param[in] file_count:
+	The number of files to parse.
+@param[in] threads:
+	The number of worker threads to parse on.
+	@dassert `threads` > 0. */
+void rlc_scoped_file_registry_parse(
+	struct RlcScopedFileRegistry * this,
+	char const * const * files,
+	size_t file_count,
+	size_t threads);
+
+/** Appends the files reachable from a file that were not ordered yet to the registry's topological order.
+	Files are ordered depth-first, in the order of their include statements, and each file is ordered only once. Include cycles are broken at the first file reached twice.
+@memberof RlcScopedFileRegistry
+@param[in,out] this:
+	The registry.
+	@dassert @nonnull
+@param[in] file:
+	The file whose includes to order.
+	@dassert @nonnull
+@return
+	The position of the first newly ordered file in `fOrder`. */
+size_t rlc_scoped_file_registry_order(
+	struct RlcScopedFileRegistry * this,
+	struct RlcScopedFile * file);
+
 char const * rlc_scoped_file_registry_resolve_global(
 	struct RlcScopedFileRegistry const * this,
 	char const * path,
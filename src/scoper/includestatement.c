@@ -2,9 +2,10 @@
 #include "../resolver/resolver.h"
 #include "fileregistry.h"
 #include "../assert.h"
-#include "../malloc.h"
+#include "../vector.h"
 #include "../fs.h"
 #include <string.h>
+#include <stdint.h>
 
 void rlc_scoped_include_statement_destroy(
 	struct RlcScopedIncludeStatement * this)
@@ -21,6 +22,7 @@ void rlc_scoped_include_list_create(
 
 	this->fPaths = NULL;
 	this->fPathCount = 0;
+	rlc_hash_map_create(&this->fIndex, kRlcHashMapKeyPointer);
 }
 
 void rlc_scoped_include_list_destroy(
@@ -28,9 +30,26 @@ void rlc_scoped_include_list_destroy(
 {
 	RLC_DASSERT(this != NULL);
 
-	if(this->fPaths)
-		rlc_free((void**)&this->fPaths);
+	rlc_vector_free((void**)&this->fPaths);
 	this->fPathCount = 0;
+	rlc_hash_map_destroy(&this->fIndex);
+}
+
+/** Finds a file in an include list. */
+static struct RlcScopedInclude * find(
+	struct RlcScopedIncludeList * this,
+	struct RlcScopedFile const * file)
+{
+	if(this->fPathCount < kRlcScopedIncludeListIndexThreshold)
+	{
+		for(RlcSrcIndex i = 0; i < this->fPathCount; i++)
+			if(file == this->fPaths[i].fFile)
+				return &this->fPaths[i];
+		return NULL;
+	}
+
+	void ** index = rlc_hash_map_find(&this->fIndex, file);
+	return index ? &this->fPaths[(uintptr_t)*index] : NULL;
 }
 
 struct RlcScopedInclude * rlc_scoped_include_list_add(
@@ -41,23 +60,28 @@ struct RlcScopedInclude * rlc_scoped_include_list_add(
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(file != NULL);
 
-	for(RlcSrcIndex i = 0; i < this->fPathCount; i++)
-		if(file == this->fPaths[i].fFile)
-		{
-			// If it is already connected, do not set to unconnected again.
-			this->fPaths[i].fConnected |= connected;
-			return &this->fPaths[i];
-		}
+	struct RlcScopedInclude * include = find(this, file);
+	if(include)
+	{
+		// If it is already connected, do not set to unconnected again.
+		include->fConnected |= connected;
+		return include;
+	}
 
 	// Add the path.
-	rlc_realloc(
-		(void**)&this->fPaths,
-		sizeof(struct RlcScopedInclude) * ++this->fPathCount);
+	include = &RLC_VECTOR_PUSH(NULL, this->fPaths, this->fPathCount);
+	include->fConnected = connected;
+	include->fFile = file;
 
-	this->fPaths[this->fPathCount-1].fConnected = connected;
-	this->fPaths[this->fPathCount-1].fFile = file;
+	// Index the list once it is large enough.
+	if(this->fPathCount == kRlcScopedIncludeListIndexThreshold)
+	{
+		for(RlcSrcIndex i = 0; i < this->fPathCount; i++)
+			rlc_hash_map_insert(&this->fIndex, this->fPaths[i].fFile, (void *)(uintptr_t)i);
+	} else if(this->fPathCount > kRlcScopedIncludeListIndexThreshold)
+		rlc_hash_map_insert(&this->fIndex, file, (void *)(uintptr_t)(this->fPathCount-1));
 
-	return &this->fPaths[this->fPathCount-1];
+	return include;
 }
 
 char const * rlc_scope_include_statement(
@@ -4,6 +4,7 @@
 #define __rlc_scoper_includestatement_h_defined
 
 #include "../macros.h"
+#include "../hashmap.h"
 #include "../parser/includestatement.h"
 #include "string.h"
 
@@ -32,10 +33,15 @@ struct RlcScopedInclude
 	int fConnected;
 };
 
+/** Include lists of at least this size are indexed by file. */
+#define kRlcScopedIncludeListIndexThreshold 16
+
 struct RlcScopedIncludeList
 {
 	struct RlcScopedInclude * fPaths;
 	RlcSrcSize fPathCount;
+	/** Maps files to their index in `fPaths`, once the list reached `kRlcScopedIncludeListIndexThreshold` entries. */
+	struct RlcHashMap fIndex;
 };
 
 /** Creates an include path list.
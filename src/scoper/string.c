@@ -47,6 +47,11 @@ static void parse_string_codepoints(
 	*codepoints = NULL;
 	*codepoints_len = 0;
 
+	// Every code point consumes at least one byte, and the delimiters leave room for the terminator.
+	rlc_malloc(
+		(void**)codepoints,
+		sizeof(rlc_utf32_t) * strlen(string_contents));
+
 	char const * it = string_contents+1;
 	while(*it != delim)
 	{
@@ -103,14 +108,9 @@ static void parse_string_codepoints(
 			}
 		}
 
-		rlc_realloc(
-			(void**)codepoints,
-			sizeof(rlc_utf32_t) * ++*codepoints_len);
-		codepoints[0][*codepoints_len-1] = u32;
+		codepoints[0][(*codepoints_len)++] = u32;
 	}
 
-	rlc_realloc((void**)codepoints,
-		sizeof(rlc_utf32_t) * (*codepoints_len+1));
 	codepoints[0][*codepoints_len] = '\0';
 }
 
@@ -0,0 +1,69 @@
+/** @file sha256.h
+	Contains the SHA-256 hash, for keys that must not collide even for crafted inputs, such as the names of cached compiler results. */
+#ifndef __rlc_sha256_h_defined
+#define __rlc_sha256_h_defined
+
+#include "macros.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The size of a SHA-256 digest, in bytes. */
+#define kRlcSha256Size ((size_t)32)
+
+/** The state of an incremental SHA-256 computation.
+	Can be copied to compute the digests of several inputs with a common prefix. */
+struct RlcSha256
+{
+	/** The intermediate hash value. */
+	uint32_t fState[8];
+	/** The number of bytes hashed so far. */
+	uint64_t fLength;
+	/** The bytes of the current, incomplete block. */
+	uint8_t fBlock[64];
+};
+
+/** Starts a SHA-256 computation.
+@memberof RlcSha256
+@param[out] this:
+	The hash to start.
+	@dassert @nonnull */
+void rlc_sha256_create(
+	struct RlcSha256 * this);
+
+/** Hashes data.
+@memberof RlcSha256
+@param[in,out] this:
+	The hash.
+	@dassert @nonnull
+@param[in] data:
+	The data.
+@param[in] size:
+	The data's size. */
+void rlc_sha256_add(
+	struct RlcSha256 * this,
+	void const * data,
+	size_t size);
+
+/** Computes the digest of all hashed data.
+	Leaves the hash unchanged, so that more data can be added.
+@memberof RlcSha256
+@param[in] this:
+	The hash.
+	@dassert @nonnull
+@param[out] digest:
+	The digest.
+	@dassert @nonnull */
+void rlc_sha256_digest(
+	struct RlcSha256 const * this,
+	uint8_t digest[kRlcSha256Size]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,70 +2,183 @@
 #include "../assert.h"
 #include "../malloc.h"
 #include "../unicode.h"
+#include "../tokeniser/scan.h"
 
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-int rlc_src_file_read(
+/** Maps a regular file into memory, followed by at least one zero byte.
+@return
+	Whether the file could be mapped. */
+static _Nodiscard int map_file(
 	struct RlcSrcFile * this,
-	char const * file)
+	int fd,
+	size_t size)
 {
-	RLC_DASSERT(this != NULL);
-	RLC_DASSERT(file != NULL);
+	size_t const page = sysconf(_SC_PAGESIZE);
+	// Reserve an extra zeroed page if the file ends on a page boundary.
+	size_t const mapping = (size / page + 1) * page;
 
-	FILE * f = fopen(file, "r");
-	if(!f)
+	void * base = mmap(NULL, mapping, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(base == MAP_FAILED)
 		return 0;
+	if(mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+	{
+		munmap(base, mapping);
+		return 0;
+	}
 
-	fseek(f, 0, SEEK_END);
-	size_t size = ftell(f);
-	fseek(f, 0, SEEK_SET);
+	this->fContentData = base;
+	this->fContentLength = size;
+	this->fMappingSize = mapping;
+	return 1;
+}
+
+/** Reads a file into a zero-terminated buffer, for small files and files that cannot be mapped.
+@param[in] size_hint:
+	The expected file size.
+@return
+	Whether the file could be read. */
+static _Nodiscard int read_file(
+	struct RlcSrcFile * this,
+	int fd,
+	size_t size_hint)
+{
+	size_t capacity = size_hint + 1 < 4096 ? 4096 : size_hint + 1;
+	size_t size = 0;
+	this->fContentData = NULL;
+	rlc_malloc((void**)&this->fContentData, capacity);
 
-	size_t const k_file_limit = ((size_t)1u << (8*sizeof(RlcSrcIndex)));
-	if(size >= k_file_limit)
+	for(;;)
 	{
-		fprintf(stderr, "%s:1:1: error: file exceeds limit of %zu KiB.\n",
-			file, k_file_limit / 1024);
-		fflush(stderr);
-		exit(EXIT_FAILURE);
+		// The terminator's byte is read into as well, so that files of the expected size reach their end without growing the buffer.
+		if(size == capacity)
+			rlc_realloc((void**)&this->fContentData, capacity *= 2);
+
+		ssize_t const count = read(fd, this->fContentData + size, capacity - size);
+		if(count > 0)
+			size += count;
+		else if(!count)
+			break;
+		else if(errno != EINTR)
+		{
+			rlc_free((void**)&this->fContentData);
+			return 0;
+		}
 	}
 
+	if(size == capacity)
+		rlc_realloc((void**)&this->fContentData, capacity + 1);
+	this->fContentData[size] = '\0';
 	this->fContentLength = size;
-	this->fContentData = NULL;
-	rlc_malloc((void**)&this->fContentData, size+1);
+	this->fMappingSize = 0;
+	return 1;
+}
 
-	size_t const read = fread(
-		this->fContentData,
-		1,
-		size,
-		f);
-	fclose(f);
+/** Detects the UTF-8 BOM and validates the UTF-8 encoding in a single pass.
+	Like `rlc_utf8_is_valid_string()`, validation ends at the first `\0` byte.
+@param[out] bom:
+	The length of the BOM, or 0.
+@return
+	The first invalid byte, or null if the contents are valid. */
+static char const * validate_utf8(
+	char const * data,
+	size_t size,
+	size_t * bom)
+{
+	char const * const end = data + size;
+	*bom = (size >= 3 && !memcmp(data, "\xEF\xBB\xBF", 3)) ? 3 : 0;
 
-	if(read != size)
+	for(char const * p = data + *bom;;)
 	{
-		rlc_free((void**)&this->fContentData);
-		return 0;
+		if((p = rlc_scan_ascii(p, end)) == end || !*p)
+			return NULL;
+
+		rlc_utf8_t const lead = *p;
+		unsigned const length = rlc_is_utf8_valid(lead)
+			? rlc_character_length(lead)
+			: 0;
+		if(!length || (size_t)(end - p) < length)
+			return p;
+		for(unsigned i = 1; i < length; i++)
+			if(((rlc_utf8_t)p[i] & 0xc0) != 0x80)
+				return p;
+		p += length;
 	}
+}
+
+/** Files of at least this size are mapped, smaller ones are read, which is cheaper for them. */
+static uint64_t const k_map_threshold = 256 * 1024;
+/** The size limit for source files, imposed by `RlcSrcIndex`. */
+static uint64_t const k_file_limit = (uint64_t)1u << (8*sizeof(RlcSrcIndex));
+
+static _Noreturn void fail_too_large(
+	char const * file)
+{
+	fprintf(stderr, "%s:1:1: error: file exceeds limit of %" PRIu64 " MiB.\n",
+		file, k_file_limit / (1024 * 1024));
+	fflush(stderr);
+	exit(EXIT_FAILURE);
+}
+
+int rlc_src_file_read(
+	struct RlcSrcFile * this,
+	char const * file)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(file != NULL);
 
-	this->fContentData[this->fContentLength] = '\0';
+	int const fd = open(file, O_RDONLY | O_CLOEXEC);
+	if(fd < 0)
+		return 0;
 
-	// Detect and skip UTF-8 BOM.
-	if(!strncmp(this->fContentData, "\xEF\xBB\xBF", 3))
+	struct stat info;
+	if(fstat(fd, &info))
 	{
-		this->fContents = this->fContentData + 3;
-		this->fContentLength -= 3;
+		close(fd);
+		return 0;
 	}
-	else
-		this->fContents = this->fContentData;
 
-	if(!rlc_utf8_is_valid_string((rlc_utf8_t const *)this->fContents))
+	if(S_ISREG(info.st_mode) && (uint64_t)info.st_size >= k_file_limit)
+		fail_too_large(file);
+
+	int const loaded = (S_ISREG(info.st_mode)
+			&& (uint64_t)info.st_size >= k_map_threshold
+			&& map_file(this, fd, info.st_size))
+		|| read_file(this, fd, S_ISREG(info.st_mode) ? info.st_size : 0);
+	close(fd);
+	if(!loaded)
+		return 0;
+
+	if((uint64_t)this->fContentLength >= k_file_limit)
+		fail_too_large(file);
+
+	size_t bom;
+	char const * invalid = validate_utf8(
+		this->fContentData,
+		this->fContentLength,
+		&bom);
+	if(invalid)
 	{
+		rlc_utf8_t bytes[4] = { 0, 0, 0, 0 };
+		for(size_t i = 0; i < 4 && invalid + i < this->fContentData + this->fContentLength; i++)
+			bytes[i] = invalid[i];
+		printf("invalid UTF-8 sequence '%.2x%.2x%.2x%.2x\n", bytes[0], bytes[1], bytes[2], bytes[3]);
 		fprintf(stderr, "%s:1:1: error: file is not UTF-8 encoded.\n", file);
 		fflush(stderr);
 		exit(EXIT_FAILURE);
 	}
 
+	this->fContents = this->fContentData + bom;
+	this->fContentLength -= bom;
+	atomic_init(&this->fLines, NULL);
+
 	size_t name_len = strlen(file);
 	this->fName = NULL;
 	rlc_malloc((void**)&this->fName, name_len + 1);
@@ -80,11 +193,72 @@ void rlc_src_file_destroy(
 	RLC_DASSERT(this != NULL);
 
 	rlc_free((void**)&this->fName);
-	rlc_free((void**)&this->fContentData);
+	if(this->fMappingSize)
+	{
+		munmap(this->fContentData, this->fMappingSize);
+		this->fContentData = NULL;
+		this->fMappingSize = 0;
+	} else
+		rlc_free((void**)&this->fContentData);
+
+	struct RlcSrcLineTable * lines = atomic_exchange_explicit(
+		&this->fLines,
+		NULL,
+		memory_order_acquire);
+	if(lines)
+		rlc_free((void**)&lines);
 	this->fContents = NULL;
 	this->fContentLength = 0;
 }
 
+/** Retrieves a file's line table, building it if necessary. */
+static struct RlcSrcLineTable const * line_table(
+	struct RlcSrcFile const * this)
+{
+	struct RlcSrcLineTable * lines = atomic_load_explicit(
+		&this->fLines,
+		memory_order_acquire);
+	if(lines)
+		return lines;
+
+	char const * const end = this->fContents + this->fContentLength;
+	size_t const count = 1 + rlc_scan_line_starts(this->fContents, end, NULL);
+	rlc_malloc(
+		(void**)&lines,
+		sizeof(struct RlcSrcLineTable) + count * sizeof(RlcSrcIndex));
+	lines->fCount = count;
+	lines->fStarts[0] = 0;
+	rlc_scan_line_starts(this->fContents, end, &lines->fStarts[1]);
+
+	// Another thread may have built the table in the meantime.
+	struct RlcSrcLineTable * expected = NULL;
+	if(atomic_compare_exchange_strong_explicit(
+		&((struct RlcSrcFile *)this)->fLines, &expected, lines,
+		memory_order_acq_rel, memory_order_acquire))
+		return lines;
+
+	rlc_free((void**)&lines);
+	return expected;
+}
+
+/** Finds the (0-based) line containing a source index. */
+static size_t find_line(
+	struct RlcSrcLineTable const * lines,
+	RlcSrcIndex index)
+{
+	// Find the last line starting at or before `index`.
+	size_t left = 0, right = lines->fCount;
+	while(right - left > 1)
+	{
+		size_t const mid = left + (right - left) / 2;
+		if(lines->fStarts[mid] <= index)
+			left = mid;
+		else
+			right = mid;
+	}
+	return left;
+}
+
 struct RlcSrcString rlc_src_file_line(
 	struct RlcSrcFile const * this,
 	RlcSrcIndex index)
@@ -92,18 +266,15 @@ struct RlcSrcString rlc_src_file_line(
 	RLC_DASSERT(this != NULL);
 	RLC_DASSERT(index < this->fContentLength);
 
-	// Find the start of the line.
-	while(index && this->fContents[index-1] != '\n')
-		--index;
+	struct RlcSrcLineTable const * lines = line_table(this);
+	size_t const line = find_line(lines, index);
 
-	// Find the end of the line.
-	RlcSrcIndex end;
-	for(end = index; ; end++)
-		if(this->fContents[end] == '\0' && this->fContents[end] == '\n')
-			break;
+	RlcSrcIndex const start = lines->fStarts[line];
+	RlcSrcIndex const end = line + 1 < lines->fCount
+		? lines->fStarts[line + 1] - 1
+		: this->fContentLength;
 
-	RlcSrcIndex const length = end - index;
-	struct RlcSrcString ret = { index, length };
+	struct RlcSrcString ret = { start, end - start, kRlcIdentifierNone };
 	return ret;
 }
 
@@ -116,21 +287,12 @@ void rlc_src_file_position(
 	RLC_DASSERT(out != NULL);
 	RLC_DASSERT(index <= this->fContentLength);
 
-	out->line = 1;
-	size_t line_start = 0;
-	char const * frame = this->fContents;
-	size_t frame_length = index;
-
-	char const * found;
-	while((found = memchr(frame, '\n', frame_length)))
-	{
-		++out->line;
-
-		size_t skip = found - frame;
-		line_start = found+1 - this->fContents;
-		frame = found + 1;
-		frame_length = frame_length - (skip + 1);
-	}
+	struct RlcSrcLineTable const * lines = line_table(this);
+	size_t const line = find_line(lines, index);
+	out->line = line + 1;
 
-	out->column = index - line_start + 1;
-}
\ No newline at end of file
+	// Count characters, i.e., all bytes except UTF-8 continuation bytes.
+	out->column = 1;
+	for(RlcSrcIndex i = lines->fStarts[line]; i < index; i++)
+		out->column += ((rlc_utf8_t)this->fContents[i] & 0xc0) != 0x80;
+}
@@ -4,6 +4,7 @@
 
 #include <stddef.h>
 #include <stdio.h>
+#include <stdatomic.h>
 
 #include "string.h"
 #include "../macros.h"
@@ -12,6 +13,15 @@
 extern "C" {
 #endif
 
+/** The starts of a source file's lines. */
+struct RlcSrcLineTable
+{
+	/** The number of lines. */
+	size_t fCount;
+	/** The source index of each line's first character, in ascending order. */
+	RlcSrcIndex fStarts[];
+};
+
 /** A RL source file. */
 struct RlcSrcFile
 {
@@ -19,9 +29,14 @@ struct RlcSrcFile
 	char * fContents; // Used for parsing, does not contain BOM.
 	char * fContentData; // Used for freeing, may contain BOM.
 	size_t fContentLength;
+	/** If nonzero, `fContentData` is a read-only memory mapping of this size, otherwise it is allocated. */
+	size_t fMappingSize;
+	/** The file's line table, built by the first position lookup. */
+	_Atomic(struct RlcSrcLineTable *) fLines;
 };
 
 /** Reads a source file.
+	Regular files are memory-mapped, other files (such as pipes) are read into memory. Skips the UTF-8 BOM, if present, and validates the UTF-8 encoding.
 @memberof RlcSrcFile
 @param[out] this:
 	The source file to read into. Holds no valid value if the operation fails.
@@ -43,6 +58,7 @@ void rlc_src_file_destroy(
 	struct RlcSrcFile * this);
 
 /** Retrieves a line of code of a source file.
+	Can be called from multiple threads at once.
 @param[in] this:
 	The file whose line to read.
 	@dassert @nonnull
@@ -50,7 +66,7 @@ void rlc_src_file_destroy(
 	A source index that is within the line.
 	@dassert must be within the file.
 @return
-	The line containing `index`. */
+	The line containing `index`, without its line break. */
 struct RlcSrcString rlc_src_file_line(
 	struct RlcSrcFile const * this,
 	RlcSrcIndex index);
@@ -63,6 +79,7 @@ struct RlcSrcPosition
 };
 
 /** Calculates the line and column of a character in a source file.
+	Columns count UTF-8 characters, not bytes. The first call builds the file's line table, after which lookups take logarithmic time. Can be called from multiple threads at once.
 @memberof RlcSrcFile
 @param[in] this:
 	The source file.
@@ -0,0 +1,280 @@
+#include "identifier.h"
+#include "nametable.h"
+#include "../assert.h"
+#include "../malloc.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+/** An interned identifier. */
+struct RlcIdentifierSlot
+{
+	/** The identifier's name. Published after `fFlags`. */
+	struct RlcNameSlot fName;
+	/** The identifier's flags. */
+	int fFlags;
+};
+
+/** An open-addressing hash table of identifiers.
+	Tables never move, so IDs stay valid: once a table is half full, new identifiers go to the next, twice as large table. See `nametable.h` for how slots are claimed. */
+struct RlcIdentifierTable
+{
+	/** The number of claimed slots. */
+	atomic_size_t fCount;
+	/** The slots. */
+	struct RlcIdentifierSlot fSlots[];
+};
+
+enum
+{
+	/** The capacity of the first table. */
+	kInitialCapacity = 1024,
+	/** The maximum number of tables. */
+	kMaxTables = 20
+};
+
+/** The tables. Table `i` holds `kInitialCapacity << i` slots, and the IDs following the previous tables' IDs. */
+static _Atomic(struct RlcIdentifierTable *) s_tables[kMaxTables];
+
+/** Identifiers that are reserved in C++. */
+static struct {
+	char const * fName;
+	int fFlags;
+} const k_reserved[] = {
+#define KEYWORD kRlcIdentifierKeyword | kRlcIdentifierPrefix
+	{ "char", KEYWORD }, { "int", KEYWORD }, { "short", KEYWORD },
+	{ "double", KEYWORD }, { "long", KEYWORD }, { "float", KEYWORD },
+	{ "unsigned", KEYWORD }, { "bool", KEYWORD },
+	{ "auto", KEYWORD },
+	{ "class", KEYWORD },
+	{ "concept", KEYWORD },
+	{ "enum", KEYWORD },
+	{ "extern", KEYWORD },
+	{ "inline", KEYWORD },
+	{ "static", KEYWORD },
+	{ "operator", KEYWORD },
+	{ "final", kRlcIdentifierPrefix },
+	{ "override", kRlcIdentifierPrefix },
+	{ "virtual", KEYWORD },
+	{ "public", KEYWORD },
+	{ "private", KEYWORD },
+	{ "protected", KEYWORD },
+	{ "sizeof", KEYWORD },
+	{ "const", KEYWORD },
+	{ "delete", KEYWORD },
+	{ "new", KEYWORD },
+	{ "struct", KEYWORD },
+	{ "template", KEYWORD },
+	{ "typedef", KEYWORD },
+	{ "typename", KEYWORD },
+	{ "namespace", KEYWORD },
+	{ "using", KEYWORD },
+	{ "volatile", KEYWORD },
+	{ "std", kRlcIdentifierPrefix }, // avoid having c++ std stuff appear in rl std.
+	{ "nullptr", KEYWORD },
+	{ "nullptr_t", kRlcIdentifierPrefix },
+	{ "main", kRlcIdentifierPrefix },
+	{ "true", KEYWORD },
+	{ "false", KEYWORD },
+	{ "if", KEYWORD },
+	{ "else", KEYWORD },
+	{ "while", KEYWORD },
+	{ "do", KEYWORD },
+	{ "for", KEYWORD },
+	{ "throw", KEYWORD },
+	{ "catch", KEYWORD },
+	{ "switch", KEYWORD },
+	{ "break", KEYWORD },
+	{ "continue", KEYWORD },
+	{ "case", KEYWORD },
+	{ "default", KEYWORD },
+	{ "return", KEYWORD },
+	{ "this", KEYWORD },
+	{ "try", KEYWORD },
+	{ "union", KEYWORD },
+	{ "void", KEYWORD },
+	{ "and", KEYWORD },
+	{ "bitand", KEYWORD },
+	{ "bitor", KEYWORD },
+	{ "compl", KEYWORD },
+	{ "not", KEYWORD },
+	{ "or", KEYWORD },
+	{ "xor", KEYWORD },
+	{ "NULL", kRlcIdentifierPrefix }
+#undef KEYWORD
+};
+
+static size_t capacity(
+	unsigned table)
+{
+	return (size_t)kInitialCapacity << table;
+}
+
+/** The ID of a table's first slot. */
+static RlcIdentifier base_id(
+	unsigned table)
+{
+	return 1 + kInitialCapacity * ((1u << table) - 1);
+}
+
+static int insert(
+	struct RlcIdentifierTable * this,
+	unsigned table,
+	uint64_t key,
+	char const * name,
+	RlcSrcSize length,
+	int flags,
+	RlcIdentifier * id);
+
+/** Returns a table, creating it if necessary. */
+static struct RlcIdentifierTable * get_table(
+	unsigned table)
+{
+	RLC_ASSERT(table < kMaxTables && "too many identifiers.");
+
+	struct RlcIdentifierTable * this = atomic_load_explicit(
+		&s_tables[table],
+		memory_order_acquire);
+	if(this)
+		return this;
+
+	size_t const size = sizeof(struct RlcIdentifierTable)
+		+ capacity(table) * sizeof(struct RlcIdentifierSlot);
+	rlc_malloc((void**)&this, size);
+	memset(this, 0, size);
+
+	// The reserved identifiers are added before the table is shared.
+	if(!table)
+		for(size_t i = 0; i < _countof(k_reserved); i++)
+		{
+			RlcIdentifier id;
+			RlcSrcSize const length = strlen(k_reserved[i].fName);
+			insert(
+				this, 0,
+				rlc_name_key(k_reserved[i].fName, length),
+				k_reserved[i].fName,
+				length,
+				k_reserved[i].fFlags,
+				&id);
+		}
+
+	struct RlcIdentifierTable * expected = NULL;
+	if(atomic_compare_exchange_strong_explicit(
+		&s_tables[table], &expected, this,
+		memory_order_acq_rel, memory_order_acquire))
+		return this;
+
+	// Another thread added the table first.
+	rlc_free((void**)&this);
+	return expected;
+}
+
+/** Looks an identifier up in a table, and inserts it if the table has room.
+@param[in] flags:
+	The identifier's flags, if it is inserted.
+@param[out] id:
+	The identifier's ID, if it is in the table.
+@return
+	Whether the identifier is in the table. */
+static int insert(
+	struct RlcIdentifierTable * this,
+	unsigned table,
+	uint64_t key,
+	char const * name,
+	RlcSrcSize length,
+	int flags,
+	RlcIdentifier * id)
+{
+	size_t i;
+	switch(rlc_name_table_probe(
+		this->fSlots, sizeof(struct RlcIdentifierSlot), capacity(table), &this->fCount,
+		key, name, length, &i))
+	{
+	case kRlcNameClaimed:
+		this->fSlots[i].fFlags = flags;
+		rlc_name_slot_publish(&this->fSlots[i].fName, name);
+		// fallthrough
+	case kRlcNameFound:
+		*id = base_id(table) + i;
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+RlcIdentifier rlc_identifier_intern(
+	char const * name,
+	RlcSrcSize length)
+{
+	RLC_DASSERT(name != NULL);
+	RLC_DASSERT(length > 0);
+
+	uint64_t const key = rlc_name_key(name, length);
+	RlcIdentifier id;
+	for(unsigned table = 0;; table++)
+		if(insert(get_table(table), table, key, name, length, 0, &id))
+			return id;
+}
+
+RlcIdentifier rlc_identifier_find(
+	char const * name,
+	RlcSrcSize length)
+{
+	RLC_DASSERT(name != NULL);
+
+	if(!length)
+		return kRlcIdentifierNone;
+
+	uint64_t const key = rlc_name_key(name, length);
+	for(unsigned table = 0; table < kMaxTables; table++)
+	{
+		// The first table holds the reserved identifiers, even if nothing was tokenised.
+		struct RlcIdentifierTable * this = table
+			? atomic_load_explicit(&s_tables[table], memory_order_acquire)
+			: get_table(0);
+		if(!this)
+			break;
+
+		size_t i;
+		switch(rlc_name_table_probe(
+			this->fSlots, sizeof(struct RlcIdentifierSlot), capacity(table), NULL,
+			key, name, length, &i))
+		{
+		case kRlcNameFound:
+			return base_id(table) + i;
+		case kRlcNameAbsent:
+			return kRlcIdentifierNone;
+		default:
+			break;
+		}
+	}
+
+	return kRlcIdentifierNone;
+}
+
+int rlc_identifier_flags(
+	RlcIdentifier this)
+{
+	if(this == kRlcIdentifierNone)
+		return 0;
+
+	unsigned table = 0;
+	while(this >= base_id(table + 1))
+		++table;
+
+	struct RlcIdentifierTable * t = atomic_load_explicit(
+		&s_tables[table],
+		memory_order_acquire);
+	RLC_DASSERT(t != NULL);
+	return t->fSlots[this - base_id(table)].fFlags;
+}
+
+void rlc_identifier_free(void)
+{
+	for(unsigned table = 0; table < kMaxTables; table++)
+	{
+		struct RlcIdentifierTable * this = atomic_exchange(&s_tables[table], NULL);
+		if(this)
+			rlc_free((void**)&this);
+	}
+}
@@ -0,0 +1,66 @@
+/** @file identifier.h
+	Contains the global identifier interner.
+	Every identifier token is interned while tokenising, and its ID is stored in its source string, so that identifiers are compared by ID, and properties of their spelling are computed only once. Identifiers can be interned from multiple threads at once. */
+#ifndef __rlc_src_identifier_h_defined
+#define __rlc_src_identifier_h_defined
+#pragma once
+
+#include "string.h"
+#include "../macros.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Properties of an identifier's spelling. */
+enum RlcIdentifierFlag
+{
+	/** The identifier is a C++ keyword. */
+	kRlcIdentifierKeyword = 1,
+	/** The identifier is reserved in the generated C++, and needs the `__rlc_` prefix. */
+	kRlcIdentifierPrefix = 2
+};
+
+/** Interns an identifier.
+@param[in] name:
+	The identifier's characters. Must remain valid until `rlc_identifier_free()` is called, as the interner does not copy them.
+	@dassert @nonnull
+@param[in] length:
+	The identifier's length.
+	@dassert `length` > 0.
+@return
+	The identifier's ID. */
+_Nodiscard RlcIdentifier rlc_identifier_intern(
+	char const * name,
+	RlcSrcSize length);
+
+/** Looks up an identifier without interning it.
+@param[in] name:
+	The identifier's characters.
+	@dassert @nonnull
+@param[in] length:
+	The identifier's length.
+@return
+	The identifier's ID, or `kRlcIdentifierNone` if it was not interned. */
+_Nodiscard RlcIdentifier rlc_identifier_find(
+	char const * name,
+	RlcSrcSize length);
+
+/** Retrieves an identifier's flags.
+@param[in] this:
+	The identifier's ID.
+@return
+	The identifier's `RlcIdentifierFlag` flags, or 0 for `kRlcIdentifierNone`. */
+_Nodiscard int rlc_identifier_flags(
+	RlcIdentifier this);
+
+/** Frees all interned identifiers. Invalidates all IDs. */
+void rlc_identifier_free(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,91 @@
+#include "nametable.h"
+#include "../assert.h"
+
+#include <string.h>
+
+/** Marks free slots. */
+static uint64_t const k_slot_free = 0;
+/** Marks slots that were free when their table was full. Probing past it is useless, as later names go to the next table. */
+static uint64_t const k_slot_sealed = (uint64_t)1 << 32;
+
+uint64_t rlc_name_key(
+	char const * name,
+	RlcSrcSize length)
+{
+	RLC_DASSERT(name != NULL);
+	RLC_DASSERT(length > 0);
+
+	// FNV-1a.
+	uint32_t hash = 0x811c9dc5u;
+	for(RlcSrcSize i = 0; i < length; i++)
+		hash = (hash ^ (unsigned char) name[i]) * 0x01000193u;
+	// Names are never empty, so keys never collide with the slot markers, whose length is 0.
+	return (uint64_t) hash << 32 | length;
+}
+
+enum RlcNameProbe rlc_name_table_probe(
+	void * slots,
+	size_t slot_size,
+	size_t capacity,
+	atomic_size_t * count,
+	uint64_t key,
+	char const * name,
+	RlcSrcSize length,
+	size_t * index)
+{
+	RLC_DASSERT(slots != NULL);
+	RLC_DASSERT(name != NULL);
+	RLC_DASSERT(index != NULL);
+
+	size_t const mask = capacity - 1;
+	for(size_t i = (key >> 32) & mask;; i = (i + 1) & mask)
+	{
+		struct RlcNameSlot * slot = (struct RlcNameSlot *)((char *)slots + i * slot_size);
+		uint64_t found = atomic_load_explicit(&slot->fKey, memory_order_acquire);
+		if(found == k_slot_free)
+		{
+			// The name would have been stored in the first free slot.
+			if(!count)
+				return kRlcNameAbsent;
+
+			int const full = 2 * atomic_load_explicit(count, memory_order_relaxed) >= capacity;
+			if(atomic_compare_exchange_strong_explicit(
+				&slot->fKey, &found, full ? k_slot_sealed : key,
+				memory_order_acq_rel, memory_order_acquire))
+			{
+				if(full)
+					return kRlcNameSealed;
+
+				atomic_fetch_add_explicit(count, 1, memory_order_relaxed);
+				*index = i;
+				return kRlcNameClaimed;
+			}
+			// Another thread claimed the slot, `found` holds its key.
+		}
+
+		if(found == k_slot_sealed)
+			return kRlcNameSealed;
+
+		if(found == key)
+		{
+			char const * other;
+			while(!(other = atomic_load_explicit(&slot->fName, memory_order_acquire)))
+				;
+			if(!memcmp(other, name, length))
+			{
+				*index = i;
+				return kRlcNameFound;
+			}
+		}
+	}
+}
+
+void rlc_name_slot_publish(
+	struct RlcNameSlot * this,
+	char const * name)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(name != NULL);
+
+	atomic_store_explicit(&this->fName, name, memory_order_release);
+}
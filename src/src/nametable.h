@@ -0,0 +1,104 @@
+/** @file nametable.h
+	Contains the lock-free probing shared by the tables that intern names from source text.
+	A name's key combines its hash and length. Slots are claimed by swapping in their key, and their name is published afterwards. Tables never move: the first free slot of a name's probe sequence decides whether the name is stored there, or, if the table is half full, whether the slot is sealed and the name goes to a later table. So racing threads agree on where a name is stored. */
+#ifndef __rlc_src_nametable_h_defined
+#define __rlc_src_nametable_h_defined
+#pragma once
+
+#include "string.h"
+#include "../macros.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A name table slot. Tables may embed it at the start of larger slots. */
+struct RlcNameSlot
+{
+	/** The name's key, or 0 if the slot is free, or a sealing marker. Claims the slot. */
+	_Atomic(uint64_t) fKey;
+	/** The name's first character. Published after the rest of the slot. */
+	_Atomic(char const *) fName;
+};
+
+/** How a name's probe sequence ended. */
+enum RlcNameProbe
+{
+	/** The name is in the table. */
+	kRlcNameFound,
+	/** A slot was claimed for the name. Its name must be published with `rlc_name_slot_publish()`. */
+	kRlcNameClaimed,
+	/** The table is full, and the name may be in a later table. */
+	kRlcNameSealed,
+	/** The name is neither in the table nor in a later table. */
+	kRlcNameAbsent,
+
+	RLC_ENUM_END(RlcNameProbe)
+};
+
+/** Computes a name's key.
+@param[in] name:
+	The name's characters.
+	@dassert @nonnull
+@param[in] length:
+	The name's length.
+	@dassert `length` > 0.
+@return
+	The name's hash (upper half) and length (lower half). Never collides with free or sealed slots. */
+_Nodiscard uint64_t rlc_name_key(
+	char const * name,
+	RlcSrcSize length);
+
+/** Looks a name up in a table, and claims a slot for it if the table has room.
+@param[in,out] slots:
+	The table's slots, which start with a `struct RlcNameSlot`.
+	@dassert @nonnull
+@param[in] slot_size:
+	The size of a slot.
+@param[in] capacity:
+	The slot count. Must be a power of two.
+@param[in,out] count:
+	The number of claimed slots. If null, the name is only looked up.
+@param[in] key:
+	The name's key, as returned by `rlc_name_key()`.
+@param[in] name:
+	The name's characters.
+	@dassert @nonnull
+@param[in] length:
+	The name's length.
+@param[out] index:
+	The name's slot, if it was found or claimed.
+	@dassert @nonnull
+@return
+	How the probe sequence ended. A name that is looked up is never claimed. */
+_Nodiscard enum RlcNameProbe rlc_name_table_probe(
+	void * slots,
+	size_t slot_size,
+	size_t capacity,
+	atomic_size_t * count,
+	uint64_t key,
+	char const * name,
+	RlcSrcSize length,
+	size_t * index);
+
+/** Publishes the name of a claimed slot, once the rest of the slot is initialised.
+@memberof RlcNameSlot
+@param[in,out] this:
+	The slot.
+	@dassert @nonnull
+@param[in] name:
+	The name's characters.
+	@dassert @nonnull */
+void rlc_name_slot_publish(
+	struct RlcNameSlot * this,
+	char const * name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
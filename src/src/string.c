@@ -1,11 +1,12 @@
 #include "string.h"
 #include "file.h"
+#include "identifier.h"
 #include "../assert.h"
 #include "../malloc.h"
 
 #include <string.h>
 
-struct RlcSrcString const kRlcSrcStringEmpty = { 0, 0 };
+struct RlcSrcString const kRlcSrcStringEmpty = { 0, 0, kRlcIdentifierNone };
 
 int rlc_src_string_valid(
 	struct RlcSrcString const * this,
@@ -29,12 +30,15 @@ int rlc_src_string_cmp(
 	RLC_DASSERT(rlc_src_string_valid(a, file));
 	RLC_DASSERT(rlc_src_string_valid(b, file));
 
+	if(a->identifier && b->identifier)
+		return (a->identifier > b->identifier) - (a->identifier < b->identifier);
+
 	if(a->length < b->length)
 		return -1;
 	else if(a->length > b->length)
 		return 1;
 	else
-		return strncmp(
+		return memcmp(
 			&file->fContents[a->start],
 			&file->fContents[b->start],
 			a->length);
@@ -91,73 +95,12 @@ void rlc_src_string_print(
 	RLC_DASSERT(file != NULL);
 	RLC_DASSERT(out != NULL);
 
-	static char const * s_special_identifiers[] = {
-		"char", "int", "short", "double", "long", "float", "unsigned", "bool",
-		"auto",
-		"class",
-		"concept",
-		"enum",
-		"extern",
-		"inline",
-		"static",
-		"operator",
-		"final",
-		"override",
-		"virtual",
-		"public",
-		"private",
-		"protected",
-		"sizeof",
-		"const",
-		"delete",
-		"new",
-		"struct",
-		"template",
-		"typedef",
-		"typename",
-		"namespace",
-		"using"
-		"volatile",
-		"std", // avoid having c++ std stuff appear in rl std.
-		"nullptr",
-		"nullptr_t",
-		"main",
-		"true",
-		"false",
-		"if",
-		"else",
-		"while",
-		"do",
-		"for",
-		"throw",
-		"catch",
-		"switch",
-		"break",
-		"continue",
-		"case",
-		"default",
-		"return",
-		"this",
-		"try",
-		"union",
-		"void",
-		"return",
-		"and",
-		"bitand",
-		"bitor",
-		"compl",
-		"not",
-		"or",
-		"xor",
-		"NULL"
-	};
-
-	for(size_t i = 0; i < _countof(s_special_identifiers); i++)
-		if(0 == rlc_src_string_cmp_cstr(file, this, s_special_identifiers[i]))
-		{
-			fputs("__rlc_", out);
-			break;
-		}
+	// Stale IDs, such as of a parse cache entry whose names were not interned again, would print wrong names.
+	RLC_DASSERT(!this->identifier
+		|| this->identifier == rlc_identifier_find(&file->fContents[this->start], this->length));
+
+	if(rlc_identifier_flags(this->identifier) & kRlcIdentifierPrefix)
+		fputs("__rlc_", out);
 
 	fprintf(out, "%.*s", (int)this->length, &file->fContents[this->start]);
 }
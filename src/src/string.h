@@ -14,14 +14,22 @@ extern "C" {
 struct RlcSrcFile;
 
 /** Source character index type. */
-typedef uint16_t RlcSrcIndex;
-typedef uint16_t RlcSrcSize;
+typedef uint32_t RlcSrcIndex;
+typedef uint32_t RlcSrcSize;
+
+/** An interned identifier, see `identifier.h`. Equal spellings have equal IDs. */
+typedef uint32_t RlcIdentifier;
+
+/** The ID of strings that are no identifiers. */
+#define kRlcIdentifierNone ((RlcIdentifier)0)
 
 /** A string inside a source file. */
 struct RlcSrcString
 {
 	RlcSrcIndex start;
 	RlcSrcSize length;
+	/** The interned identifier, or `kRlcIdentifierNone` if the string is no identifier token. */
+	RlcIdentifier identifier;
 } const kRlcSrcStringEmpty;
 
 /** Checks whether a source string is a valid range inside a file.
@@ -31,6 +39,7 @@ int rlc_src_string_valid(
 	struct RlcSrcFile const * file);
 
 /** Compares two source strings within a source file.
+	Identifiers are compared by ID, and ordered by ID instead of by spelling.
 @memberof RlcSrcString
 @return
 	`<0`, `0`, or `>0`, depending on the relation of `a` and `b`. */
@@ -63,7 +72,8 @@ char const * rlc_src_string_cstr(
 static inline RlcSrcIndex rlc_src_string_end(
 	struct RlcSrcString const * this);
 
-/** Prints a source string. */
+/** Prints a source string.
+	Identifiers that are reserved in C++ are prefixed with `__rlc_`. */
 void rlc_src_string_print(
 	struct RlcSrcString const * this,
 	struct RlcSrcFile const * file,
@@ -0,0 +1,228 @@
+#include "threadpool.h"
+#include "malloc.h"
+#include "vector.h"
+#include "assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** The worker running on the current thread, if any. */
+static _Thread_local struct RlcThreadPoolWorker * s_worker = NULL;
+
+/** Appends a task to the back of a worker's queue. */
+static void push(
+	struct RlcThreadPoolWorker * this,
+	struct RlcThreadPoolTask task)
+{
+	pthread_mutex_lock(&this->fLock);
+
+	// Reclaim the space of stolen tasks before growing.
+	if(this->fBegin && this->fBegin >= this->fEnd - this->fBegin)
+	{
+		memmove(
+			this->fTasks,
+			this->fTasks + this->fBegin,
+			(this->fEnd - this->fBegin) * sizeof(struct RlcThreadPoolTask));
+		this->fEnd -= this->fBegin;
+		this->fBegin = 0;
+	}
+	RLC_VECTOR_PUSH(NULL, this->fTasks, this->fEnd) = task;
+
+	pthread_mutex_unlock(&this->fLock);
+}
+
+/** Takes a task from a worker's queue.
+@param[in] steal:
+	Whether to take the oldest task instead of the newest. */
+static int take(
+	struct RlcThreadPoolWorker * this,
+	struct RlcThreadPoolTask * task,
+	int steal)
+{
+	pthread_mutex_lock(&this->fLock);
+
+	int const found = this->fBegin != this->fEnd;
+	if(found)
+	{
+		*task = steal
+			? this->fTasks[this->fBegin++]
+			: this->fTasks[--this->fEnd];
+		if(this->fBegin == this->fEnd)
+			this->fBegin = this->fEnd = 0;
+	}
+
+	pthread_mutex_unlock(&this->fLock);
+	return found;
+}
+
+/** Takes a task from a worker's own queue, or steals one from another worker. */
+static int find_task(
+	struct RlcThreadPoolWorker * this,
+	struct RlcThreadPoolTask * task)
+{
+	struct RlcThreadPool * pool = this->fPool;
+	if(take(this, task, 0))
+		return 1;
+
+	size_t const self = this - pool->fWorkers;
+	for(size_t i = 1; i < pool->fWorkerCount; i++)
+		if(take(&pool->fWorkers[(self + i) % pool->fWorkerCount], task, 1))
+			return 1;
+
+	return 0;
+}
+
+static void * worker_thread(
+	void * context)
+{
+	struct RlcThreadPoolWorker * this = context;
+	struct RlcThreadPool * pool = this->fPool;
+	s_worker = this;
+
+	for(;;)
+	{
+		struct RlcThreadPoolTask task;
+		if(find_task(this, &task))
+		{
+			atomic_fetch_sub_explicit(&pool->fQueued, 1, memory_order_relaxed);
+			task.fRun(pool, task.fContext);
+
+			if(atomic_fetch_sub_explicit(&pool->fPending, 1, memory_order_acq_rel) == 1)
+			{
+				pthread_mutex_lock(&pool->fLock);
+				pthread_cond_broadcast(&pool->fIdle);
+				pthread_mutex_unlock(&pool->fLock);
+			}
+			continue;
+		}
+
+		// Sleep until there is something to steal. Submitters count the task before signalling under the lock, so no wakeup is lost.
+		pthread_mutex_lock(&pool->fLock);
+		while(!pool->fStop
+		&& !atomic_load_explicit(&pool->fQueued, memory_order_acquire))
+			pthread_cond_wait(&pool->fWork, &pool->fLock);
+		int const stop = pool->fStop
+			&& !atomic_load_explicit(&pool->fQueued, memory_order_acquire);
+		pthread_mutex_unlock(&pool->fLock);
+
+		if(stop)
+			return NULL;
+	}
+}
+
+void rlc_thread_pool_create(
+	struct RlcThreadPool * this,
+	size_t workers)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(workers > 0);
+
+	this->fWorkers = NULL;
+	this->fWorkerCount = workers;
+	atomic_init(&this->fQueued, 0);
+	atomic_init(&this->fPending, 0);
+	atomic_init(&this->fNextWorker, 0);
+	this->fStop = 0;
+	pthread_mutex_init(&this->fLock, NULL);
+	pthread_cond_init(&this->fWork, NULL);
+	pthread_cond_init(&this->fIdle, NULL);
+
+	rlc_malloc(
+		(void**)&this->fWorkers,
+		workers * sizeof(struct RlcThreadPoolWorker));
+
+	for(size_t i = 0; i < workers; i++)
+	{
+		struct RlcThreadPoolWorker * worker = &this->fWorkers[i];
+		worker->fPool = this;
+		worker->fTasks = NULL;
+		worker->fBegin = 0;
+		worker->fEnd = 0;
+		pthread_mutex_init(&worker->fLock, NULL);
+	}
+
+	// Start the threads only once all queues exist, as workers steal from each other.
+	for(size_t i = 0; i < workers; i++)
+	{
+		if(pthread_create(
+			&this->fWorkers[i].fThread,
+			NULL,
+			&worker_thread,
+			&this->fWorkers[i]))
+		{
+			fputs("Failed to start worker thread.", stderr);
+			abort();
+		}
+	}
+}
+
+void rlc_thread_pool_destroy(
+	struct RlcThreadPool * this)
+{
+	RLC_DASSERT(this != NULL);
+
+	rlc_thread_pool_wait(this);
+
+	pthread_mutex_lock(&this->fLock);
+	this->fStop = 1;
+	pthread_cond_broadcast(&this->fWork);
+	pthread_mutex_unlock(&this->fLock);
+
+	// Join all workers before destroying any queue, as workers may still look for tasks to steal.
+	for(size_t i = 0; i < this->fWorkerCount; i++)
+		pthread_join(this->fWorkers[i].fThread, NULL);
+
+	for(size_t i = 0; i < this->fWorkerCount; i++)
+	{
+		struct RlcThreadPoolWorker * worker = &this->fWorkers[i];
+		pthread_mutex_destroy(&worker->fLock);
+		rlc_vector_free((void**)&worker->fTasks);
+	}
+
+	rlc_free((void**)&this->fWorkers);
+	this->fWorkerCount = 0;
+
+	pthread_cond_destroy(&this->fIdle);
+	pthread_cond_destroy(&this->fWork);
+	pthread_mutex_destroy(&this->fLock);
+}
+
+void rlc_thread_pool_submit(
+	struct RlcThreadPool * this,
+	rlc_thread_pool_task_t run,
+	void * context)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(run != NULL);
+
+	struct RlcThreadPoolWorker * worker = s_worker;
+	if(!worker || worker->fPool != this)
+	{
+		size_t const next = atomic_fetch_add_explicit(
+			&this->fNextWorker, 1,
+			memory_order_relaxed);
+		worker = &this->fWorkers[next % this->fWorkerCount];
+	}
+
+	// Count the task before queueing it, so that the counters never drop below zero.
+	atomic_fetch_add_explicit(&this->fPending, 1, memory_order_relaxed);
+	atomic_fetch_add_explicit(&this->fQueued, 1, memory_order_relaxed);
+	push(worker, (struct RlcThreadPoolTask){ run, context });
+
+	pthread_mutex_lock(&this->fLock);
+	pthread_cond_signal(&this->fWork);
+	pthread_mutex_unlock(&this->fLock);
+}
+
+void rlc_thread_pool_wait(
+	struct RlcThreadPool * this)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(!s_worker || s_worker->fPool != this);
+
+	pthread_mutex_lock(&this->fLock);
+	while(atomic_load_explicit(&this->fPending, memory_order_acquire))
+		pthread_cond_wait(&this->fIdle, &this->fLock);
+	pthread_mutex_unlock(&this->fLock);
+}
@@ -0,0 +1,127 @@
+/** @file threadpool.h
+	Contains the work-stealing thread pool used to parse files in parallel.
+	Every worker owns a task queue. Tasks submitted by a worker go to its own queue, and are taken from its back, so related work stays on the same thread. Idle workers steal the oldest tasks from the front of other workers' queues. */
+#ifndef __rlc_threadpool_h_defined
+#define __rlc_threadpool_h_defined
+
+#include "macros.h"
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct RlcThreadPool;
+
+/** A task run by a thread pool.
+@param[in,out] pool:
+	The pool running the task, to submit follow-up tasks to.
+@param[in] context:
+	The context the task was submitted with. */
+typedef void (*rlc_thread_pool_task_t)(
+	struct RlcThreadPool * pool,
+	void * context);
+
+/** A submitted task. */
+struct RlcThreadPoolTask
+{
+	/** The function to run. */
+	rlc_thread_pool_task_t fRun;
+	/** The function's context. */
+	void * fContext;
+};
+
+/** A worker thread and its task queue. */
+struct RlcThreadPoolWorker
+{
+	/** The pool the worker belongs to. */
+	struct RlcThreadPool * fPool;
+	/** The worker's thread. */
+	pthread_t fThread;
+	/** Protects the queue. */
+	pthread_mutex_t fLock;
+	/** The queued tasks are `fTasks[fBegin]` to `fTasks[fEnd-1]`. */
+	struct RlcThreadPoolTask * fTasks;
+	/** The index of the oldest queued task. */
+	size_t fBegin;
+	/** The index behind the newest queued task. */
+	size_t fEnd;
+};
+
+/** A fixed set of worker threads that run submitted tasks. */
+struct RlcThreadPool
+{
+	/** The workers. */
+	struct RlcThreadPoolWorker * fWorkers;
+	/** The worker count. */
+	size_t fWorkerCount;
+	/** The number of tasks waiting in the workers' queues. */
+	atomic_size_t fQueued;
+	/** The number of tasks that were submitted, but did not finish yet. */
+	atomic_size_t fPending;
+	/** The worker that receives the next task submitted from outside the pool. */
+	atomic_size_t fNextWorker;
+	/** Whether the workers should exit once the queues are empty. */
+	int fStop;
+	/** Protects `fStop`, and is held while signalling. */
+	pthread_mutex_t fLock;
+	/** Signalled when tasks are queued, or the pool stops. */
+	pthread_cond_t fWork;
+	/** Signalled when no tasks are pending anymore. */
+	pthread_cond_t fIdle;
+};
+
+/** Creates a thread pool and starts its workers.
+	If a thread cannot be started, terminates the program.
+@memberof RlcThreadPool
+@param[out] this:
+	The thread pool to create.
+	@dassert @nonnull
+@param[in] workers:
+	The number of worker threads.
+	@dassert `workers` > 0. */
+void rlc_thread_pool_create(
+	struct RlcThreadPool * this,
+	size_t workers);
+
+/** Waits for all tasks to finish, then stops the workers and destroys a thread pool.
+@memberof RlcThreadPool
+@param[in,out] this:
+	The thread pool to destroy.
+	@dassert @nonnull */
+void rlc_thread_pool_destroy(
+	struct RlcThreadPool * this);
+
+/** Submits a task to a thread pool.
+	Can be called from inside and outside the pool's tasks.
+@memberof RlcThreadPool
+@param[in,out] this:
+	The thread pool to run the task.
+	@dassert @nonnull
+@param[in] run:
+	The task's function.
+	@dassert @nonnull
+@param[in] context:
+	The context to pass to the task's function. */
+void rlc_thread_pool_submit(
+	struct RlcThreadPool * this,
+	rlc_thread_pool_task_t run,
+	void * context);
+
+/** Waits until all submitted tasks, including the tasks they submitted, finished.
+	Must not be called from inside the pool's tasks.
+@memberof RlcThreadPool
+@param[in,out] this:
+	The thread pool to wait for.
+	@dassert @nonnull */
+void rlc_thread_pool_wait(
+	struct RlcThreadPool * this);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
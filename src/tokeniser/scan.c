@@ -0,0 +1,421 @@
+#include "scan.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define RLC_SCAN_X86
+#include <immintrin.h>
+#endif
+
+static int is_whitespace(char c)
+{
+	return c == ' '
+		|| c == '\t'
+		|| c == '\r'
+		|| c == '\n'
+		|| c == '\v';
+}
+
+static int is_identifier(char c)
+{
+	return (c >= 'A' && c <= 'Z')
+		|| (c >= 'a' && c <= 'z')
+		|| (c >= '0' && c <= '9')
+		|| (c == '_');
+}
+
+static char const * scalar_whitespace(
+	char const * p,
+	char const * end)
+{
+	while(p != end && is_whitespace(*p))
+		++p;
+	return p;
+}
+
+static char const * scalar_line(
+	char const * p,
+	char const * end)
+{
+	while(p != end && *p != '\n' && *p)
+		++p;
+	return p;
+}
+
+static char const * scalar_block_comment(
+	char const * p,
+	char const * end)
+{
+	while(p != end && *p != '/')
+		++p;
+	return p;
+}
+
+static char const * scalar_identifier(
+	char const * p,
+	char const * end)
+{
+	while(p != end && is_identifier(*p))
+		++p;
+	return p;
+}
+
+static char const * scalar_ascii(
+	char const * p,
+	char const * end)
+{
+	while(p != end && *p > 0)
+		++p;
+	return p;
+}
+
+static size_t scalar_line_starts(
+	char const * begin,
+	char const * p,
+	char const * end,
+	uint32_t * starts,
+	size_t count)
+{
+	for(; p != end; ++p)
+		if(*p == '\n')
+		{
+			if(starts)
+				starts[count] = p + 1 - begin;
+			++count;
+		}
+	return count;
+}
+
+static char const * scalar_string(
+	char const * p,
+	char const * end,
+	char delim)
+{
+	while(p != end
+	&& *p != delim
+	&& *p != '\\'
+	&& *p != '\n'
+	&& *p)
+		++p;
+	return p;
+}
+
+#ifdef RLC_SCAN_X86
+
+/** @def SCAN_LOOP(width, vec, load, mask)
+	Advances `p` over whole vectors of `width` bytes, and returns the first byte for which `mask` (a byte mask of the bytes that end the run, computed from `v`) is set. Falls through with `p` at the unscanned tail. */
+#define SCAN_LOOP(width, vec, load, mask) \
+	for(; end - p >= (width); p += (width)) \
+	{ \
+		vec const v = load((vec const *)p); \
+		unsigned const m = (mask); \
+		if(m) \
+			return p + __builtin_ctz(m); \
+	}
+
+/** @def LINE_STARTS_LOOP(width, vec, load, mask)
+	Like `SCAN_LOOP`, but records every byte for which `mask` is set as a line end, and falls through with `p` at the unscanned tail. */
+#define LINE_STARTS_LOOP(width, vec, load, mask) \
+	for(; end - p >= (width); p += (width)) \
+	{ \
+		vec const v = load((vec const *)p); \
+		unsigned m = (mask); \
+		if(!starts) \
+			count += __builtin_popcount(m); \
+		else for(; m; m &= m - 1) \
+			starts[count++] = p + __builtin_ctz(m) + 1 - begin; \
+	}
+
+#define SSE2_EQ(v, c) _mm_cmpeq_epi8((v), _mm_set1_epi8((c)))
+#define SSE2_IN(v, lo, hi) _mm_and_si128( \
+	_mm_cmpgt_epi8((v), _mm_set1_epi8((char)((lo)-1))), \
+	_mm_cmplt_epi8((v), _mm_set1_epi8((char)((hi)+1))))
+#define SSE2_MASK(v) ((unsigned)_mm_movemask_epi8((v)))
+
+static char const * sse2_whitespace(
+	char const * p,
+	char const * end)
+{
+	SCAN_LOOP(16, __m128i, _mm_loadu_si128,
+		0xFFFFu & ~SSE2_MASK(
+			_mm_or_si128(
+				_mm_or_si128(SSE2_EQ(v, ' '), SSE2_EQ(v, '\r')),
+				SSE2_IN(v, '\t', '\v'))));
+	return scalar_whitespace(p, end);
+}
+
+static char const * sse2_line(
+	char const * p,
+	char const * end)
+{
+	SCAN_LOOP(16, __m128i, _mm_loadu_si128,
+		SSE2_MASK(_mm_or_si128(SSE2_EQ(v, '\n'), SSE2_EQ(v, '\0'))));
+	return scalar_line(p, end);
+}
+
+static char const * sse2_block_comment(
+	char const * p,
+	char const * end)
+{
+	SCAN_LOOP(16, __m128i, _mm_loadu_si128,
+		SSE2_MASK(SSE2_EQ(v, '/')));
+	return scalar_block_comment(p, end);
+}
+
+static char const * sse2_identifier(
+	char const * p,
+	char const * end)
+{
+	// Setting bit 5 maps upper-case letters to lower-case ones.
+	SCAN_LOOP(16, __m128i, _mm_loadu_si128,
+		0xFFFFu & ~SSE2_MASK(
+			_mm_or_si128(
+				_mm_or_si128(
+					SSE2_IN(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z'),
+					SSE2_IN(v, '0', '9')),
+				SSE2_EQ(v, '_'))));
+	return scalar_identifier(p, end);
+}
+
+static char const * sse2_string(
+	char const * p,
+	char const * end,
+	char delim)
+{
+	SCAN_LOOP(16, __m128i, _mm_loadu_si128,
+		SSE2_MASK(
+			_mm_or_si128(
+				_mm_or_si128(SSE2_EQ(v, delim), SSE2_EQ(v, '\\')),
+				_mm_or_si128(SSE2_EQ(v, '\n'), SSE2_EQ(v, '\0')))));
+	return scalar_string(p, end, delim);
+}
+
+static size_t sse2_line_starts(
+	char const * begin,
+	char const * p,
+	char const * end,
+	uint32_t * starts,
+	size_t count)
+{
+	LINE_STARTS_LOOP(16, __m128i, _mm_loadu_si128,
+		SSE2_MASK(SSE2_EQ(v, '\n')));
+	return scalar_line_starts(begin, p, end, starts, count);
+}
+
+static char const * sse2_ascii(
+	char const * p,
+	char const * end)
+{
+	// The sign bit of each byte is set for non-ASCII bytes.
+	SCAN_LOOP(16, __m128i, _mm_loadu_si128,
+		SSE2_MASK(_mm_or_si128(v, SSE2_EQ(v, '\0'))));
+	return scalar_ascii(p, end);
+}
+
+#define AVX2 __attribute__((target("avx2")))
+#define AVX2_EQ(v, c) _mm256_cmpeq_epi8((v), _mm256_set1_epi8((c)))
+#define AVX2_IN(v, lo, hi) _mm256_andnot_si256( \
+	_mm256_cmpgt_epi8((v), _mm256_set1_epi8((char)(hi))), \
+	_mm256_cmpgt_epi8((v), _mm256_set1_epi8((char)((lo)-1))))
+#define AVX2_MASK(v) ((unsigned)_mm256_movemask_epi8((v)))
+
+AVX2 static char const * avx2_whitespace(
+	char const * p,
+	char const * end)
+{
+	SCAN_LOOP(32, __m256i, _mm256_loadu_si256,
+		~AVX2_MASK(
+			_mm256_or_si256(
+				_mm256_or_si256(AVX2_EQ(v, ' '), AVX2_EQ(v, '\r')),
+				AVX2_IN(v, '\t', '\v'))));
+	return sse2_whitespace(p, end);
+}
+
+AVX2 static char const * avx2_line(
+	char const * p,
+	char const * end)
+{
+	SCAN_LOOP(32, __m256i, _mm256_loadu_si256,
+		AVX2_MASK(_mm256_or_si256(AVX2_EQ(v, '\n'), AVX2_EQ(v, '\0'))));
+	return sse2_line(p, end);
+}
+
+AVX2 static char const * avx2_block_comment(
+	char const * p,
+	char const * end)
+{
+	SCAN_LOOP(32, __m256i, _mm256_loadu_si256,
+		AVX2_MASK(AVX2_EQ(v, '/')));
+	return sse2_block_comment(p, end);
+}
+
+AVX2 static char const * avx2_identifier(
+	char const * p,
+	char const * end)
+{
+	// Setting bit 5 maps upper-case letters to lower-case ones.
+	SCAN_LOOP(32, __m256i, _mm256_loadu_si256,
+		~AVX2_MASK(
+			_mm256_or_si256(
+				_mm256_or_si256(
+					AVX2_IN(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), 'a', 'z'),
+					AVX2_IN(v, '0', '9')),
+				AVX2_EQ(v, '_'))));
+	return sse2_identifier(p, end);
+}
+
+AVX2 static char const * avx2_string(
+	char const * p,
+	char const * end,
+	char delim)
+{
+	SCAN_LOOP(32, __m256i, _mm256_loadu_si256,
+		AVX2_MASK(
+			_mm256_or_si256(
+				_mm256_or_si256(AVX2_EQ(v, delim), AVX2_EQ(v, '\\')),
+				_mm256_or_si256(AVX2_EQ(v, '\n'), AVX2_EQ(v, '\0')))));
+	return sse2_string(p, end, delim);
+}
+
+AVX2 static size_t avx2_line_starts(
+	char const * begin,
+	char const * p,
+	char const * end,
+	uint32_t * starts,
+	size_t count)
+{
+	LINE_STARTS_LOOP(32, __m256i, _mm256_loadu_si256,
+		AVX2_MASK(AVX2_EQ(v, '\n')));
+	return sse2_line_starts(begin, p, end, starts, count);
+}
+
+AVX2 static char const * avx2_ascii(
+	char const * p,
+	char const * end)
+{
+	// The sign bit of each byte is set for non-ASCII bytes.
+	SCAN_LOOP(32, __m256i, _mm256_loadu_si256,
+		AVX2_MASK(_mm256_or_si256(v, AVX2_EQ(v, '\0'))));
+	return sse2_ascii(p, end);
+}
+
+#endif
+
+/** A scanner implementation. */
+struct RlcScanImpl
+{
+	char const * fName;
+	char const * (*fWhitespace)(char const *, char const *);
+	char const * (*fLine)(char const *, char const *);
+	char const * (*fBlockComment)(char const *, char const *);
+	char const * (*fIdentifier)(char const *, char const *);
+	char const * (*fString)(char const *, char const *, char);
+	char const * (*fAscii)(char const *, char const *);
+	size_t (*fLineStarts)(char const *, char const *, char const *, uint32_t *, size_t);
+};
+
+static struct RlcScanImpl const k_scalar = {
+	"scalar",
+	&scalar_whitespace,
+	&scalar_line,
+	&scalar_block_comment,
+	&scalar_identifier,
+	&scalar_string,
+	&scalar_ascii,
+	&scalar_line_starts
+};
+
+#ifdef RLC_SCAN_X86
+static struct RlcScanImpl const k_sse2 = {
+	"sse2",
+	&sse2_whitespace,
+	&sse2_line,
+	&sse2_block_comment,
+	&sse2_identifier,
+	&sse2_string,
+	&sse2_ascii,
+	&sse2_line_starts
+};
+
+static struct RlcScanImpl const k_avx2 = {
+	"avx2",
+	&avx2_whitespace,
+	&avx2_line,
+	&avx2_block_comment,
+	&avx2_identifier,
+	&avx2_string,
+	&avx2_ascii,
+	&avx2_line_starts
+};
+#endif
+
+/** The implementation selected at startup. */
+static struct RlcScanImpl const * s_impl = &k_scalar;
+
+__attribute__((constructor)) static void select_implementation(void)
+{
+#ifdef RLC_SCAN_X86
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2"))
+		s_impl = &k_avx2;
+	else if(__builtin_cpu_supports("sse2"))
+		s_impl = &k_sse2;
+#endif
+}
+
+char const * rlc_scan_whitespace(
+	char const * begin,
+	char const * end)
+{
+	return s_impl->fWhitespace(begin, end);
+}
+
+char const * rlc_scan_line(
+	char const * begin,
+	char const * end)
+{
+	return s_impl->fLine(begin, end);
+}
+
+char const * rlc_scan_block_comment(
+	char const * begin,
+	char const * end)
+{
+	return s_impl->fBlockComment(begin, end);
+}
+
+char const * rlc_scan_identifier(
+	char const * begin,
+	char const * end)
+{
+	return s_impl->fIdentifier(begin, end);
+}
+
+char const * rlc_scan_string(
+	char const * begin,
+	char const * end,
+	char delim)
+{
+	return s_impl->fString(begin, end, delim);
+}
+
+char const * rlc_scan_ascii(
+	char const * begin,
+	char const * end)
+{
+	return s_impl->fAscii(begin, end);
+}
+
+size_t rlc_scan_line_starts(
+	char const * begin,
+	char const * end,
+	uint32_t * starts)
+{
+	return s_impl->fLineStarts(begin, begin, end, starts, 0);
+}
+
+char const * rlc_scan_implementation(void)
+{
+	return s_impl->fName;
+}
\ No newline at end of file
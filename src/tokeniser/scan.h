@@ -0,0 +1,77 @@
+/** @file scan.h
+	Contains the character class scanners used by the tokeniser and the source file loader.
+	Each scanner skips a run of bytes inside `[begin, end)` and returns the address of the first byte that ends the run, or `end`. The scanners never read outside of `[begin, end)`. On x86, SSE2 or AVX2 implementations are selected at startup, otherwise a scalar implementation is used. */
+#ifndef __rlc_tokeniser_scan_h_defined
+#define __rlc_tokeniser_scan_h_defined
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Skips whitespace (space, `\t`, `\r`, `\n`, `\v`).
+@return
+	The first non-whitespace byte. */
+char const * rlc_scan_whitespace(
+	char const * begin,
+	char const * end);
+
+/** Skips the contents of a line comment.
+@return
+	The first `\n` or `\0` byte. */
+char const * rlc_scan_line(
+	char const * begin,
+	char const * end);
+
+/** Skips the contents of a block comment up to the next possible delimiter.
+@return
+	The first `/` byte, which may belong to a `(/` or `/)` delimiter. */
+char const * rlc_scan_block_comment(
+	char const * begin,
+	char const * end);
+
+/** Skips identifier characters (`[A-Za-z0-9_]`).
+@return
+	The first non-identifier byte. */
+char const * rlc_scan_identifier(
+	char const * begin,
+	char const * end);
+
+/** Skips the plain contents of a string or character literal.
+@param[in] delim:
+	The literal's closing quote.
+@return
+	The first `delim`, `\\`, `\n`, or `\0` byte. */
+char const * rlc_scan_string(
+	char const * begin,
+	char const * end,
+	char delim);
+
+/** Skips non-zero ASCII bytes.
+@return
+	The first byte that is `\0` or not ASCII. */
+char const * rlc_scan_ascii(
+	char const * begin,
+	char const * end);
+
+/** Finds the starts of all lines after the first one, i.e., the bytes following each `\n` byte.
+	Unlike the other scanners, this scans the whole range.
+@param[out] starts:
+	If nonnull, receives the offsets of the line starts relative to `begin`, in ascending order. Must have room for all of them.
+@return
+	The number of `\n` bytes. */
+size_t rlc_scan_line_starts(
+	char const * begin,
+	char const * end,
+	uint32_t * starts);
+
+/** Retrieves the name of the selected scanner implementation. */
+char const * rlc_scan_implementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
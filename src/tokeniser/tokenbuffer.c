@@ -0,0 +1,197 @@
+#include "tokenbuffer.h"
+
+#include "../assert.h"
+#include "../malloc.h"
+
+#include <assert.h>
+
+static_assert(RLC_COUNT(RlcTokenType) <= UINT8_MAX + 1, "token types do not fit into a byte.");
+
+/** How many tokens are published at once to a waiting reader. */
+enum { kPublishBatch = 256 };
+
+/** Publishes the progress of the tokeniser to a waiting reader. */
+static void publish(
+	struct RlcTokenBuffer * this,
+	int done)
+{
+	if(this->fAsync)
+	{
+		pthread_mutex_lock(&this->fLock);
+		atomic_store_explicit(&this->fDone, done, memory_order_release);
+		pthread_cond_broadcast(&this->fPublished);
+		pthread_mutex_unlock(&this->fLock);
+	} else
+		atomic_store_explicit(&this->fDone, done, memory_order_release);
+}
+
+/** Tokenises the whole file, or until the first error. */
+static void tokenise(
+	struct RlcTokenBuffer * this)
+{
+	jmp_buf recover;
+	this->fTokeniser.fRecover = &recover;
+
+	if(!setjmp(recover))
+	{
+		int more;
+		do {
+			size_t const index = atomic_load_explicit(
+				&this->fCount,
+				memory_order_relaxed);
+
+			struct RlcToken token;
+			more = rlc_tokeniser_read(&this->fTokeniser, &token);
+
+			this->fTypes[index] = (uint8_t) token.type;
+			this->fStarts[index] = token.content.start;
+			this->fIdentifiers[index] = token.content.identifier;
+			if(token.content.length < kRlcTokenBufferLongLength)
+				this->fLengths[index] = (uint8_t) token.content.length;
+			else
+			{
+				size_t const long_index = atomic_load_explicit(
+					&this->fLongLengthCount,
+					memory_order_relaxed);
+				this->fLongLengths[long_index].fToken = index;
+				this->fLongLengths[long_index].fLength = token.content.length;
+				atomic_store_explicit(
+					&this->fLongLengthCount,
+					long_index + 1,
+					memory_order_release);
+				this->fLengths[index] = kRlcTokenBufferLongLength;
+			}
+			atomic_store_explicit(
+				&this->fCount,
+				index + 1,
+				memory_order_release);
+
+			if(!((index + 1) % kPublishBatch))
+				publish(this, 0);
+		} while(more);
+	} else
+		rlc_tokeniser_report(&this->fTokeniser);
+
+	this->fTokeniser.fRecover = NULL;
+	publish(this, 1);
+}
+
+static void * tokenise_thread(
+	void * this)
+{
+	tokenise((struct RlcTokenBuffer *) this);
+	return NULL;
+}
+
+void rlc_token_buffer_create(
+	struct RlcTokenBuffer * this,
+	struct RlcSrcFile const * file)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(file != NULL);
+
+	// Every token is at least one character long.
+	size_t const capacity = file->fContentLength + 1;
+	size_t const long_capacity = file->fContentLength / kRlcTokenBufferLongLength + 1;
+	this->fTypes = NULL;
+	this->fStarts = NULL;
+	this->fLengths = NULL;
+	this->fLongLengths = NULL;
+	this->fIdentifiers = NULL;
+	rlc_malloc((void**)&this->fTypes, capacity * sizeof(uint8_t));
+	rlc_malloc((void**)&this->fStarts, capacity * sizeof(RlcSrcIndex));
+	rlc_malloc((void**)&this->fLengths, capacity * sizeof(uint8_t));
+	rlc_malloc((void**)&this->fIdentifiers, capacity * sizeof(RlcIdentifier));
+	rlc_malloc(
+		(void**)&this->fLongLengths,
+		long_capacity * sizeof(struct RlcTokenBufferLongLength));
+
+	atomic_init(&this->fCount, 0);
+	atomic_init(&this->fLongLengthCount, 0);
+	atomic_init(&this->fDone, 0);
+
+	rlc_tokeniser_create(&this->fTokeniser, file);
+
+	this->fAsync = file->fContentLength >= kRlcTokenBufferAsyncThreshold;
+	if(this->fAsync)
+	{
+		pthread_mutex_init(&this->fLock, NULL);
+		pthread_cond_init(&this->fPublished, NULL);
+
+		if(pthread_create(&this->fThread, NULL, &tokenise_thread, this))
+		{
+			pthread_cond_destroy(&this->fPublished);
+			pthread_mutex_destroy(&this->fLock);
+			this->fAsync = 0;
+		}
+	}
+
+	if(!this->fAsync)
+		tokenise(this);
+}
+
+void rlc_token_buffer_destroy(
+	struct RlcTokenBuffer * this)
+{
+	RLC_DASSERT(this != NULL);
+
+	if(this->fAsync)
+	{
+		pthread_join(this->fThread, NULL);
+		pthread_cond_destroy(&this->fPublished);
+		pthread_mutex_destroy(&this->fLock);
+		this->fAsync = 0;
+	}
+
+	rlc_free((void**)&this->fTypes);
+	rlc_free((void**)&this->fStarts);
+	rlc_free((void**)&this->fLengths);
+	rlc_free((void**)&this->fLongLengths);
+	rlc_free((void**)&this->fIdentifiers);
+}
+
+int rlc_token_buffer_wait(
+	struct RlcTokenBuffer * this,
+	size_t index)
+{
+	RLC_DASSERT(this != NULL);
+
+	if(this->fAsync)
+	{
+		pthread_mutex_lock(&this->fLock);
+		while(index >= atomic_load_explicit(&this->fCount, memory_order_acquire)
+		&& !atomic_load_explicit(&this->fDone, memory_order_acquire))
+			pthread_cond_wait(&this->fPublished, &this->fLock);
+		pthread_mutex_unlock(&this->fLock);
+	}
+
+	if(index < atomic_load_explicit(&this->fCount, memory_order_acquire))
+		return 1;
+
+	RLC_DASSERT(atomic_load_explicit(&this->fDone, memory_order_acquire));
+	return 0;
+}
+
+RlcSrcSize rlc_token_buffer_long_length(
+	struct RlcTokenBuffer const * this,
+	size_t index)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(this->fLengths[index] == kRlcTokenBufferLongLength);
+
+	size_t left = 0;
+	size_t right = atomic_load_explicit(
+		&this->fLongLengthCount,
+		memory_order_acquire);
+	while(left < right)
+	{
+		size_t const mid = left + (right - left) / 2;
+		if(this->fLongLengths[mid].fToken < index)
+			left = mid + 1;
+		else
+			right = mid;
+	}
+
+	RLC_DASSERT(this->fLongLengths[left].fToken == index);
+	return this->fLongLengths[left].fLength;
+}
\ No newline at end of file
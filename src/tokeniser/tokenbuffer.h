@@ -0,0 +1,143 @@
+/** @file tokenbuffer.h
+	Contains the pre-tokenised form of a source file, as consumed by the parser. */
+#ifndef __rlc_tokeniser_tokenbuffer_h_defined
+#define __rlc_tokeniser_tokenbuffer_h_defined
+
+#include "tokeniser.h"
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Files of at least this size are tokenised on a separate thread, ahead of the parser. */
+#define kRlcTokenBufferAsyncThreshold ((size_t)16 * 1024)
+
+/** Token lengths of at least this value are stored out of line. */
+#define kRlcTokenBufferLongLength ((uint8_t)0xFF)
+
+/** The length of a token too long for the compact length array. */
+struct RlcTokenBufferLongLength
+{
+	/** The token's index. */
+	RlcSrcIndex fToken;
+	/** The token's length. */
+	RlcSrcSize fLength;
+};
+
+/** All tokens of a source file, stored as parallel arrays.
+	The arrays are sized for the worst case (one token per byte) up front, so they never move while being filled. Capacity that is never written is never touched, and costs no physical memory. */
+struct RlcTokenBuffer
+{
+	/** The tokeniser filling the buffer. Holds the error, if tokenisation failed. */
+	struct RlcTokeniser fTokeniser;
+	/** The tokens' types. */
+	uint8_t * fTypes;
+	/** The tokens' start indices. */
+	RlcSrcIndex * fStarts;
+	/** The tokens' lengths, or `kRlcTokenBufferLongLength` for long tokens. */
+	uint8_t * fLengths;
+	/** The lengths of long tokens, ordered by token index. */
+	struct RlcTokenBufferLongLength * fLongLengths;
+	/** The tokens' interned identifiers, or `kRlcIdentifierNone` for other tokens. */
+	RlcIdentifier * fIdentifiers;
+	/** The number of long tokens that can be read. */
+	atomic_size_t fLongLengthCount;
+	/** The number of tokens that can be read. */
+	atomic_size_t fCount;
+	/** Whether tokenisation has ended, successfully or not. */
+	atomic_int fDone;
+	/** Whether the buffer is filled by a separate thread. */
+	int fAsync;
+	/** The tokenising thread. */
+	pthread_t fThread;
+	/** Protects `fCount` and `fDone` while waiting. */
+	pthread_mutex_t fLock;
+	/** Signalled whenever tokens are published. */
+	pthread_cond_t fPublished;
+};
+
+/** Tokenises a source file.
+	Large files are tokenised on a separate thread, and the buffer can be read while being filled. Tokenisation stops at the first error, which is recorded with the diagnostics engine.
+@memberof RlcTokenBuffer
+@param[out] this:
+	The token buffer to create.
+	@dassert @nonnull
+@param[in] file:
+	The file to tokenise. Must remain valid until the buffer is destroyed.
+	@dassert @nonnull */
+void rlc_token_buffer_create(
+	struct RlcTokenBuffer * this,
+	struct RlcSrcFile const * file);
+
+/** Destroys a token buffer.
+	Waits for the tokenising thread, if any.
+@memberof RlcTokenBuffer
+@param[in,out] this:
+	The token buffer to destroy.
+	@dassert @nonnull */
+void rlc_token_buffer_destroy(
+	struct RlcTokenBuffer * this);
+
+/** Checks whether a token exists, waiting for it if necessary.
+	If tokenisation failed before the requested token, returns 0 like at the end of the file. The tokeniser error was already recorded with the diagnostics engine when tokenisation stopped.
+@memberof RlcTokenBuffer
+@param[in,out] this:
+	The token buffer.
+	@dassert @nonnull
+@param[in] index:
+	The token's index.
+@return
+	Whether the token exists. */
+_Nodiscard static inline int rlc_token_buffer_has(
+	struct RlcTokenBuffer * this,
+	size_t index);
+
+/** Retrieves a token.
+@memberof RlcTokenBuffer
+@param[in] this:
+	The token buffer.
+	@dassert @nonnull
+@param[in] index:
+	The token's index. Must have been checked via `rlc_token_buffer_has()`.
+@return
+	The token. */
+_Nodiscard static inline struct RlcToken rlc_token_buffer_get(
+	struct RlcTokenBuffer const * this,
+	size_t index);
+
+/** Retrieves a token's type.
+@memberof RlcTokenBuffer
+@param[in] this:
+	The token buffer.
+	@dassert @nonnull
+@param[in] index:
+	The token's index. Must have been checked via `rlc_token_buffer_has()`.
+@return
+	The token's type. */
+_Nodiscard static inline enum RlcTokenType rlc_token_buffer_type(
+	struct RlcTokenBuffer const * this,
+	size_t index);
+
+/** Slow path of `rlc_token_buffer_has()`.
+@memberof RlcTokenBuffer */
+_Nodiscard int rlc_token_buffer_wait(
+	struct RlcTokenBuffer * this,
+	size_t index);
+
+/** Looks up the length of a long token.
+@memberof RlcTokenBuffer */
+_Nodiscard RlcSrcSize rlc_token_buffer_long_length(
+	struct RlcTokenBuffer const * this,
+	size_t index);
+
+#include "tokenbuffer.inl"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
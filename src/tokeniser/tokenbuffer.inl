@@ -0,0 +1,39 @@
+#include "../assert.h"
+
+int rlc_token_buffer_has(
+	struct RlcTokenBuffer * this,
+	size_t index)
+{
+	RLC_DASSERT(this != NULL);
+
+	if(index < atomic_load_explicit(&this->fCount, memory_order_acquire))
+		return 1;
+	return rlc_token_buffer_wait(this, index);
+}
+
+struct RlcToken rlc_token_buffer_get(
+	struct RlcTokenBuffer const * this,
+	size_t index)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(index < atomic_load_explicit(&this->fCount, memory_order_relaxed));
+
+	struct RlcToken token;
+	token.content.start = this->fStarts[index];
+	token.content.length = this->fLengths[index];
+	if(token.content.length == kRlcTokenBufferLongLength)
+		token.content.length = rlc_token_buffer_long_length(this, index);
+	token.type = (enum RlcTokenType) this->fTypes[index];
+	token.content.identifier = this->fIdentifiers[index];
+	return token;
+}
+
+enum RlcTokenType rlc_token_buffer_type(
+	struct RlcTokenBuffer const * this,
+	size_t index)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(index < atomic_load_explicit(&this->fCount, memory_order_relaxed));
+
+	return (enum RlcTokenType) this->fTypes[index];
+}
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include "tokeniser.h"
+#include "scan.h"
+#include "../src/identifier.h"
 #include "../malloc.h"
 #include "../macros.h"
 #include "../error.h"
+#include "../diagnostics.h"
 
 #include <string.h>
 #include <stdio.h>
@@ -9,7 +12,7 @@
 #include <stdlib.h>
 
 static _Noreturn void tok_error(
-	struct RlcTokeniser const * this,
+	struct RlcTokeniser * this,
 	char const * message);
 
 static void skip(
@@ -33,7 +36,9 @@ static char look(
 static char ahead(
 	struct RlcTokeniser const * this,
 	size_t n);
-static int eof(
+static char const * position(
+	struct RlcTokeniser const * this);
+static char const * content_end(
 	struct RlcTokeniser const * this);
 static int take_str(
 	struct RlcTokeniser * this,
@@ -43,6 +48,9 @@ static char take(
 static void ignore(
 	struct RlcTokeniser * this,
 	RlcSrcIndex count);
+static void advance_to(
+	struct RlcTokeniser * this,
+	char const * p);
 
 void rlc_tokeniser_create(
 	struct RlcTokeniser * this,
@@ -54,6 +62,9 @@ void rlc_tokeniser_create(
 	this->fSource = file;
 	this->fIndex = 0;
 	this->fStart = 0;
+	this->fIdentifier = kRlcIdentifierNone;
+	this->fRecover = NULL;
+	this->fError = NULL;
 
 	skip(this);
 }
@@ -75,34 +86,36 @@ int rlc_tokeniser_read(
 
 	token->content.length = this->fIndex - this->fStart;
 	token->type = this->fType;
+	token->content.identifier = this->fType == kRlcTokIdentifier
+		? this->fIdentifier
+		: kRlcIdentifierNone;
 
 	skip(this);
 	return look(this) != '\0';
 }
 
 void tok_error(
-	struct RlcTokeniser const * this,
+	struct RlcTokeniser * this,
 	char const * message)
 {
-	struct RlcSrcPosition pos;
-	rlc_src_file_position(this->fSource, &pos, this->fIndex);
+	this->fError = message;
+	if(this->fRecover)
+		longjmp(*this->fRecover, 1);
 
-	fprintf(stderr, "%s:%u:%u: error: %s\n",
-		this->fSource->fName,
-		pos.line,
-		pos.column,
-		message);
+	rlc_tokeniser_report(this);
+	rlc_diagnostics_fail();
+}
 
-	if(this->fStart != this->fIndex)
-	{
-		rlc_src_file_position(this->fSource, &pos, this->fStart);
-		fprintf(stderr, "%s:%u:%u: error: caused here.\n",
-			this->fSource->fName,
-			pos.line,
-			pos.column);
-	}
+void rlc_tokeniser_report(
+	struct RlcTokeniser const * this)
+{
+	RLC_DASSERT(this != NULL);
+	RLC_DASSERT(this->fError != NULL);
 
-	exit(EXIT_FAILURE);
+	rlc_diagnostics_error(this->fSource, this->fIndex, "%s", this->fError);
+
+	if(this->fStart != this->fIndex)
+		rlc_diagnostics_note(this->fSource, this->fStart, "caused here.");
 }
 
 void skip(
@@ -116,23 +129,18 @@ void skip(
 int skip_whitespace(
 	struct RlcTokeniser * this)
 {
-	int skipped = 0;
-	char c;
-	while((c = look(this)))
+	// Most tokens are not preceded by whitespace.
+	switch(look(this))
 	{
-		static char const k_chars[] = " \t\r\n\v";
-		for(size_t i = 0; i < sizeof(k_chars)-1; i++)
-		{
-			if(k_chars[i] == c)
-			{
-				skipped = 1;
-				ignore(this, 1);
-				continue;
-			}
-		}
-		break;
+	case ' ': case '\t':
+	case '\r': case '\n':
+	case '\v':
+		advance_to(this,
+			rlc_scan_whitespace(position(this) + 1, content_end(this)));
+		return 1;
+	default:
+		return 0;
 	}
-	return skipped;
 }
 
 int skip_comment(
@@ -140,199 +148,137 @@ int skip_comment(
 {
 	if(take_str(this, "//"))
 	{
-		char c;
-		while((c = take(this)))
-			if(c == '\n')
-				break;
+		advance_to(this, rlc_scan_line(position(this), content_end(this)));
+		if(look(this) == '\n')
+			ignore(this, 1);
 		return 1;
 	} else if(take_str(this, "(/"))
 	{
 		int level = 1;
-		while(!eof(this))
+		// Every delimiter contains a '/', so only those need inspection.
+		char const * slash;
+		while((slash = rlc_scan_block_comment(position(this), content_end(this)))
+			!= content_end(this))
 		{
-			if(take_str(this, "/)"))
+			if(slash != position(this) && slash[-1] == '(')
 			{
+				advance_to(this, slash + 1);
+				++level;
+			} else if(slash + 1 != content_end(this) && slash[1] == ')')
+			{
+				advance_to(this, slash + 2);
 				if(!--level)
 					return 1;
-			}
-			else if(take_str(this, "(/"))
-				++level;
-			else
-				ignore(this, 1);
+			} else
+				advance_to(this, slash + 1);
 		}
+		advance_to(this, content_end(this));
 		tok_error(this, "unterminated block comment");
 	} else
 		return 0;
 }
 
 
-struct {
+/** Keyword lookup table, indexed by `keyword_hash()`.
+	The hash is perfect for the keyword set, so every keyword has its own slot and a lookup costs at most one string comparison. Adding a keyword requires recomputing the slots (and possibly the hash factors). */
+static struct {
 	char const * str;
 	enum RlcTokenType kw;
-} const s_keywords [] = {
-	// keywords.
-	{"ABSTRACT", kRlcTokAbstract },
-	{"ASSERT", kRlcTokAssert },
-	{"BREAK", kRlcTokBreak },
-	{"CASE", kRlcTokCase },
-	{"CATCH", kRlcTokCatch },
-	{"MASK", kRlcTokMask },
-	{"CONTINUE", kRlcTokContinue },
-	{"DEFAULT", kRlcTokDefault },
-	{"DESTRUCTOR", kRlcTokDestructor },
-	{"DO", kRlcTokDo },
-	{"ELSE", kRlcTokElse },
-	{"ENUM", kRlcTokEnum},
-	{"EXTERN", kRlcTokExtern },
-	{"FINAL", kRlcTokFinal },
-	{"FINALLY", kRlcTokFinally },
-	{"FOR", kRlcTokFor },
-	{"IF", kRlcTokIf },
-	{"INCLUDE", kRlcTokInclude },
-	{"INLINE", kRlcTokInline },
-	{"NULL", kRlcTokNull },
-	{"NUMBER", kRlcTokNumber },
-	{"OPERATOR", kRlcTokOperator },
-	{"OVERRIDE", kRlcTokOverride },
-	{"PRIVATE", kRlcTokPrivate },
-	{"PROTECTED", kRlcTokProtected },
-	{"PUBLIC", kRlcTokPublic },
-	{"RETURN", kRlcTokReturn },
-	{"SIZEOF", kRlcTokSizeof },
-	{"STATIC", kRlcTokStatic },
-	{"SWITCH", kRlcTokSwitch },
-	{"TEST", kRlcTokTest },
-	{"THIS", kRlcTokThis },
-	{"THROW", kRlcTokThrow },
-	{"TRY", kRlcTokTry },
-	{"TYPE", kRlcTokType },
-	{"UNION", kRlcTokUnion },
-	{"VIRTUAL", kRlcTokVirtual },
-	{"VOID", kRlcTokVoid },
-	{"WHILE", kRlcTokWhile },
-}, s_operators [] = {
-	// operators
-	{ "+=", kRlcTokPlusEqual },
-	{ "++", kRlcTokDoublePlus },
-	{ "+", kRlcTokPlus },
-
-	{ "-=", kRlcTokMinusEqual },
-	{ "-:", kRlcTokMinusColon },
-	{ "--", kRlcTokDoubleMinus },
-	{ "->*", kRlcTokMinusGreaterAsterisk },
-	{ "->", kRlcTokMinusGreater },
-	{ "-", kRlcTokMinus },
-
-	{ "*=", kRlcTokAsteriskEqual },
-	{ "*", kRlcTokAsterisk },
-
-	{ "\\", kRlcTokBackslash },
-
-	{ "/=", kRlcTokForwardSlashEqual },
-	{ "/", kRlcTokForwardSlash },
-
-	{ "%=", kRlcTokPercentEqual },
-	{ "%", kRlcTokPercent },
-
-	{ "!=", kRlcTokExclamationMarkEqual },
-	{ "!:", kRlcTokExclamationMarkColon },
-	{ "!", kRlcTokExclamationMark },
-
-	{ "^=", kRlcTokCircumflexEqual },
-	{ "^", kRlcTokCircumflex },
-
-	{ "~:", kRlcTokTildeColon },
-	{ "~", kRlcTokTilde },
-
-	{ "&&&", kRlcTokTripleAnd },
-	{ "&&=", kRlcTokDoubleAndEqual },
-	{ "&&", kRlcTokDoubleAnd },
-	{ "&=", kRlcTokAndEqual },
-	{ "&", kRlcTokAnd },
-
-	{ "||=", kRlcTokDoublePipeEqual },
-	{ "||", kRlcTokDoublePipe },
-	{ "|=", kRlcTokPipeEqual },
-	{ "|", kRlcTokPipe },
-
-	{ "?", kRlcTokQuestionMark },
-
-	{ "::=", kRlcTokDoubleColonEqual },
-	{ ":=", kRlcTokColonEqual },
-	{ "::", kRlcTokDoubleColon },
-	{ ":", kRlcTokColon },
-	{ "@@", kRlcTokDoubleAt },
-	{ "@", kRlcTokAt },
-	{ "...", kRlcTokTripleDot },
-	{ "..!", kRlcTokDoubleDotExclamationMark },
-	{ "..?", kRlcTokDoubleDotQuestionMark },
-	{ ".*", kRlcTokDotAsterisk },
-	{ ".", kRlcTokDot },
-	{ ",", kRlcTokComma },
-	{ ";", kRlcTokSemicolon },
-	{ "==", kRlcTokDoubleEqual },
-
-	{ "[", kRlcTokBracketOpen },
-	{ "]", kRlcTokBracketClose },
-	{ "{", kRlcTokBraceOpen },
-	{ "}", kRlcTokBraceClose },
-	{ "(", kRlcTokParentheseOpen },
-	{ ")", kRlcTokParentheseClose },
-
-	{ "<<<=", kRlcTokTripleLessEqual },
-	{ "<<<", kRlcTokTripleLess },
-	{ "<<=", kRlcTokDoubleLessEqual },
-	{ "<<", kRlcTokDoubleLess },
-	{ "<=", kRlcTokLessEqual },
-	{ "<-", kRlcTokLessMinus },
-	{ "<", kRlcTokLess },
-
-	{ ">>>=", kRlcTokTripleGreaterEqual },
-	{ ">>>", kRlcTokTripleGreater },
-	{ ">>=", kRlcTokDoubleGreaterEqual },
-	{ ">>", kRlcTokDoubleGreater },
-	{ ">=", kRlcTokGreaterEqual },
-	{ ">", kRlcTokGreater },
-
-	{ "$", kRlcTokDollar },
-	{ "##", kRlcTokDoubleHash },
-	{ "#", kRlcTokHash },
+} const s_keywords [128] = {
+	[4] = { "OVERRIDE", kRlcTokOverride },
+	[6] = { "THROW", kRlcTokThrow },
+	[7] = { "NULL", kRlcTokNull },
+	[12] = { "TRY", kRlcTokTry },
+	[13] = { "FINALLY", kRlcTokFinally },
+	[20] = { "INLINE", kRlcTokInline },
+	[21] = { "INCLUDE", kRlcTokInclude },
+	[27] = { "NUMBER", kRlcTokNumber },
+	[28] = { "SWITCH", kRlcTokSwitch },
+	[29] = { "CONTINUE", kRlcTokContinue },
+	[31] = { "ABSTRACT", kRlcTokAbstract },
+	[38] = { "ENUM", kRlcTokEnum },
+	[41] = { "VOID", kRlcTokVoid },
+	[43] = { "IF", kRlcTokIf },
+	[44] = { "TYPE", kRlcTokType },
+	[45] = { "EXTERN", kRlcTokExtern },
+	[54] = { "DO", kRlcTokDo },
+	[58] = { "UNION", kRlcTokUnion },
+	[66] = { "FOR", kRlcTokFor },
+	[67] = { "RETURN", kRlcTokReturn },
+	[69] = { "DESTRUCTOR", kRlcTokDestructor },
+	[72] = { "DEFAULT", kRlcTokDefault },
+	[79] = { "PROTECTED", kRlcTokProtected },
+	[80] = { "PRIVATE", kRlcTokPrivate },
+	[82] = { "BREAK", kRlcTokBreak },
+	[83] = { "WHILE", kRlcTokWhile },
+	[85] = { "TEST", kRlcTokTest },
+	[93] = { "OPERATOR", kRlcTokOperator },
+	[96] = { "SIZEOF", kRlcTokSizeof },
+	[99] = { "CASE", kRlcTokCase },
+	[100] = { "FINAL", kRlcTokFinal },
+	[102] = { "STATIC", kRlcTokStatic },
+	[109] = { "CATCH", kRlcTokCatch },
+	[112] = { "PUBLIC", kRlcTokPublic },
+	[116] = { "ELSE", kRlcTokElse },
+	[118] = { "VIRTUAL", kRlcTokVirtual },
+	[121] = { "THIS", kRlcTokThis },
+	[122] = { "ASSERT", kRlcTokAssert },
+	[127] = { "MASK", kRlcTokMask }
 };
 
-static int is_identifier_start(char c)
+/** The shortest and longest keyword lengths. */
+enum { kKeywordMinLength = 2, kKeywordMaxLength = 10 };
+
+/** Hashes a keyword candidate into its `s_keywords` slot.
+@param[in] str:
+	The candidate's characters.
+@param[in] length:
+	The candidate's length, at least `kKeywordMinLength`. */
+static unsigned keyword_hash(
+	char const * str,
+	RlcSrcSize length)
 {
-	return (c >= 'A' && c <= 'Z')
-		|| (c >= 'a' && c <= 'z')
-		|| (c == '_');
+	return ((unsigned char)str[0]
+		+ 13u * (unsigned char)str[1]
+		+ 3u * (unsigned char)str[length-1]
+		+ length) % _countof(s_keywords);
 }
-static int is_identifier_end(char c)
+
+static int is_identifier_start(char c)
 {
 	return (c >= 'A' && c <= 'Z')
 		|| (c >= 'a' && c <= 'z')
-		|| (c >= '0' && c <= '9')
 		|| (c == '_');
 }
-
 int identifier(
 	struct RlcTokeniser * this)
 {
 	if(!is_identifier_start(look(this)))
 		return 0;
 
-	do ignore(this, 1); while(is_identifier_end(look(this)));
+	ignore(this, 1);
+	advance_to(this, rlc_scan_identifier(position(this), content_end(this)));
 
-	struct RlcSrcString str;
-	str.start = this->fStart;
-	str.length = this->fIndex - this->fStart;
+	this->fType = kRlcTokIdentifier;
 
-	for(size_t i = 0; i < _countof(s_keywords); i++)
-		if(0 == rlc_src_string_cmp_cstr(this->fSource, &str, s_keywords[i].str))
+	// Keywords are all upper-case.
+	char const * str = &this->fSource->fContents[this->fStart];
+	RlcSrcSize const length = this->fIndex - this->fStart;
+	if(str[0] >= 'A' && str[0] <= 'Z'
+	&& length >= kKeywordMinLength
+	&& length <= kKeywordMaxLength)
+	{
+		unsigned const slot = keyword_hash(str, length);
+		if(s_keywords[slot].str
+		&& !strncmp(s_keywords[slot].str, str, length)
+		&& !s_keywords[slot].str[length])
 		{
-			this->fType = s_keywords[i].kw;
+			this->fType = s_keywords[slot].kw;
 			return 1;
 		}
+	}
 
-	this->fType = kRlcTokIdentifier;
+	this->fIdentifier = rlc_identifier_intern(str, length);
 	return 1;
 }
 
@@ -404,125 +350,277 @@ int number(
 	return 1;
 }
 
+/** Consumes an operator of the given length and type. */
+static int accept_op(
+	struct RlcTokeniser * this,
+	RlcSrcIndex length,
+	enum RlcTokenType type)
+{
+	ignore(this, length);
+	this->fType = type;
+	return 1;
+}
+
 int op(
 	struct RlcTokeniser * this)
 {
-	for(size_t i = 0; i < _countof(s_operators); i++)
-		if(take_str(this, s_operators[i].str))
+	// Longest match, dispatched on the first character.
+	char const c1 = ahead(this, 1);
+	char const c2 = ahead(this, 2);
+	switch(look(this))
+	{
+	case '+':
+		switch(c1)
 		{
-			this->fType = s_operators[i].kw;
-			return 1;
+		case '=': return accept_op(this, 2, kRlcTokPlusEqual);
+		case '+': return accept_op(this, 2, kRlcTokDoublePlus);
+		default: return accept_op(this, 1, kRlcTokPlus);
+		}
+	case '-':
+		switch(c1)
+		{
+		case '=': return accept_op(this, 2, kRlcTokMinusEqual);
+		case ':': return accept_op(this, 2, kRlcTokMinusColon);
+		case '-': return accept_op(this, 2, kRlcTokDoubleMinus);
+		case '>':
+			return c2 == '*'
+				? accept_op(this, 3, kRlcTokMinusGreaterAsterisk)
+				: accept_op(this, 2, kRlcTokMinusGreater);
+		default: return accept_op(this, 1, kRlcTokMinus);
+		}
+	case '*':
+		return c1 == '='
+			? accept_op(this, 2, kRlcTokAsteriskEqual)
+			: accept_op(this, 1, kRlcTokAsterisk);
+	case '\\':
+		return accept_op(this, 1, kRlcTokBackslash);
+	case '/':
+		return c1 == '='
+			? accept_op(this, 2, kRlcTokForwardSlashEqual)
+			: accept_op(this, 1, kRlcTokForwardSlash);
+	case '%':
+		return c1 == '='
+			? accept_op(this, 2, kRlcTokPercentEqual)
+			: accept_op(this, 1, kRlcTokPercent);
+	case '!':
+		switch(c1)
+		{
+		case '=': return accept_op(this, 2, kRlcTokExclamationMarkEqual);
+		case ':': return accept_op(this, 2, kRlcTokExclamationMarkColon);
+		default: return accept_op(this, 1, kRlcTokExclamationMark);
+		}
+	case '^':
+		return c1 == '='
+			? accept_op(this, 2, kRlcTokCircumflexEqual)
+			: accept_op(this, 1, kRlcTokCircumflex);
+	case '~':
+		return c1 == ':'
+			? accept_op(this, 2, kRlcTokTildeColon)
+			: accept_op(this, 1, kRlcTokTilde);
+	case '&':
+		switch(c1)
+		{
+		case '&':
+			switch(c2)
+			{
+			case '&': return accept_op(this, 3, kRlcTokTripleAnd);
+			case '=': return accept_op(this, 3, kRlcTokDoubleAndEqual);
+			default: return accept_op(this, 2, kRlcTokDoubleAnd);
+			}
+		case '=': return accept_op(this, 2, kRlcTokAndEqual);
+		default: return accept_op(this, 1, kRlcTokAnd);
+		}
+	case '|':
+		switch(c1)
+		{
+		case '|':
+			return c2 == '='
+				? accept_op(this, 3, kRlcTokDoublePipeEqual)
+				: accept_op(this, 2, kRlcTokDoublePipe);
+		case '=': return accept_op(this, 2, kRlcTokPipeEqual);
+		default: return accept_op(this, 1, kRlcTokPipe);
+		}
+	case '?':
+		return accept_op(this, 1, kRlcTokQuestionMark);
+	case ':':
+		switch(c1)
+		{
+		case ':':
+			return c2 == '='
+				? accept_op(this, 3, kRlcTokDoubleColonEqual)
+				: accept_op(this, 2, kRlcTokDoubleColon);
+		case '=': return accept_op(this, 2, kRlcTokColonEqual);
+		default: return accept_op(this, 1, kRlcTokColon);
+		}
+	case '@':
+		return c1 == '@'
+			? accept_op(this, 2, kRlcTokDoubleAt)
+			: accept_op(this, 1, kRlcTokAt);
+	case '.':
+		if(c1 == '.')
+			switch(c2)
+			{
+			case '.': return accept_op(this, 3, kRlcTokTripleDot);
+			case '!': return accept_op(this, 3, kRlcTokDoubleDotExclamationMark);
+			case '?': return accept_op(this, 3, kRlcTokDoubleDotQuestionMark);
+			}
+		return c1 == '*'
+			? accept_op(this, 2, kRlcTokDotAsterisk)
+			: accept_op(this, 1, kRlcTokDot);
+	case ',':
+		return accept_op(this, 1, kRlcTokComma);
+	case ';':
+		return accept_op(this, 1, kRlcTokSemicolon);
+	case '=':
+		return c1 == '='
+			&& accept_op(this, 2, kRlcTokDoubleEqual);
+	case '[':
+		return accept_op(this, 1, kRlcTokBracketOpen);
+	case ']':
+		return accept_op(this, 1, kRlcTokBracketClose);
+	case '{':
+		return accept_op(this, 1, kRlcTokBraceOpen);
+	case '}':
+		return accept_op(this, 1, kRlcTokBraceClose);
+	case '(':
+		return accept_op(this, 1, kRlcTokParentheseOpen);
+	case ')':
+		return accept_op(this, 1, kRlcTokParentheseClose);
+	case '<':
+		switch(c1)
+		{
+		case '<':
+			if(c2 == '<')
+				return ahead(this, 3) == '='
+					? accept_op(this, 4, kRlcTokTripleLessEqual)
+					: accept_op(this, 3, kRlcTokTripleLess);
+			return c2 == '='
+				? accept_op(this, 3, kRlcTokDoubleLessEqual)
+				: accept_op(this, 2, kRlcTokDoubleLess);
+		case '=': return accept_op(this, 2, kRlcTokLessEqual);
+		case '-': return accept_op(this, 2, kRlcTokLessMinus);
+		default: return accept_op(this, 1, kRlcTokLess);
+		}
+	case '>':
+		switch(c1)
+		{
+		case '>':
+			if(c2 == '>')
+				return ahead(this, 3) == '='
+					? accept_op(this, 4, kRlcTokTripleGreaterEqual)
+					: accept_op(this, 3, kRlcTokTripleGreater);
+			return c2 == '='
+				? accept_op(this, 3, kRlcTokDoubleGreaterEqual)
+				: accept_op(this, 2, kRlcTokDoubleGreater);
+		case '=': return accept_op(this, 2, kRlcTokGreaterEqual);
+		default: return accept_op(this, 1, kRlcTokGreater);
 		}
-	return 0;
+	case '$':
+		return accept_op(this, 1, kRlcTokDollar);
+	case '#':
+		return c1 == '#'
+			? accept_op(this, 2, kRlcTokDoubleHash)
+			: accept_op(this, 1, kRlcTokHash);
+	default:
+		return 0;
+	}
 }
 
 int string_or_character(
 	struct RlcTokeniser * this)
 {
-	static struct {
-		int size;
-		enum RlcTokenType type;
-		char const * string;
-		char delim;
-	} const k_start[] =
+	// Prefix: ["8" | ("16" | "32") ["L" | "B" | "l" | "b"]] quote.
+	RlcSrcIndex prefix = 0;
+	switch(look(this))
 	{
-		{4, kRlcTokCharacterLiteral, "32L\'", '\''},
-		{4, kRlcTokCharacterLiteral, "32B\'", '\''},
-		{4, kRlcTokCharacterLiteral, "32\'", '\''},
-
-		{2, kRlcTokCharacterLiteral, "16L\'", '\''},
-		{2, kRlcTokCharacterLiteral, "16B\'", '\''},
-		{2, kRlcTokCharacterLiteral, "16\'", '\''},
-
-		{4, kRlcTokCharacterLiteral, "32l\'", '\''},
-		{4, kRlcTokCharacterLiteral, "32b\'", '\''},
-
-		{2, kRlcTokCharacterLiteral, "16l\'", '\''},
-		{2, kRlcTokCharacterLiteral, "16b\'", '\''},
-
-		{1, kRlcTokCharacterLiteral, "8\'", '\''},
-
-		{1, kRlcTokCharacterLiteral, "\'", '\''},
-
-
-		{4, kRlcTokStringLiteral, "32L\"", '\"'},
-		{4, kRlcTokStringLiteral, "32B\"", '\"'},
-		{4, kRlcTokStringLiteral, "32\"", '\"'},
-
-		{2, kRlcTokStringLiteral, "16L\"", '\"'},
-		{2, kRlcTokStringLiteral, "16B\"", '\"'},
-		{2, kRlcTokStringLiteral, "16\"", '\"'},
-
-		{4, kRlcTokStringLiteral, "32l\"", '\"'},
-		{4, kRlcTokStringLiteral, "32b\"", '\"'},
-
-		{2, kRlcTokStringLiteral, "16l\"", '\"'},
-		{2, kRlcTokStringLiteral, "16b\"", '\"'},
+	case '\'':
+	case '"':
+		break;
+	case '8':
+		prefix = 1;
+		break;
+	case '1':
+	case '3':
+		if(ahead(this, 1) != (look(this) == '1' ? '6' : '2'))
+			return 0;
+		prefix = 2;
+		switch(ahead(this, prefix))
+		{
+		case 'L': case 'B':
+		case 'l': case 'b':
+			++prefix;
+		}
+		break;
+	default:
+		return 0;
+	}
 
-		{1, kRlcTokStringLiteral, "8\"", '\"'},
+	char const delim = ahead(this, prefix);
+	if(delim != '\'' && delim != '"')
+		return 0;
+	ignore(this, prefix + 1);
 
-		{1, kRlcTokStringLiteral, "\"", '\"'}
-	};
+	for(char c;;)
+	{
+		advance_to(this,
+			rlc_scan_string(position(this), content_end(this), delim));
+		if(!(c = take(this)))
+			break;
 
-	for(size_t i = 0; i < _countof(k_start); i++)
-		if(take_str(this, k_start[i].string))
+		if(c == delim)
 		{
-			char c;
-			while((c = take(this)))
+			this->fType = (delim == '"')
+				? kRlcTokStringLiteral
+				: kRlcTokCharacterLiteral;
+			return 1;
+		}
+		else if(c == '\\')
+			switch((c = take(this)))
 			{
-				if(c == k_start[i].delim)
+			case 'a': case 'e':
+			case 'b': case 'f':
+			case 'n': case 't':
+			case 'r': case 'v':
+			case '\\': case '\'':
+			case '"': case 'z':
+				break;
+			case '0': case '1': case '2': case '3':
+			case '4': case '5': case '6': case '7':
 				{
-					this->fType = k_start[i].type;
-					return 1;
-				}
-				else if(c == '\\')
-					switch((c = take(this)))
-					{
-					case 'a': case 'e':
-					case 'b': case 'f':
-					case 'n': case 't':
-					case 'r': case 'v':
-					case '\\': case '\'':
-					case '"': case 'z':
-						break;
-					case '0': case '1': case '2': case '3':
-					case '4': case '5': case '6': case '7':
-						{
-							int length = 3;
-							char max = '3';
-
-							if(!is_octal(c))
-								tok_error(this, "expected octal character");
-							if(c > max)
-								tok_error(this, "leading octal digit too large");
-							for(int i = 1; i < length; i++)
-								if(!is_octal(take(this)))
-									tok_error(this, "expected octal character");
-						} break;
-					case 'x':
-					case 'u':
-					case 'U':
-						{
-							c = take(this);
-							int length = (c == 'x')
-								? 2 : (c == 'u')
-								? 4
-								: 8;
-							for(int i = 0; i < length; i++)
-								if(!is_hexadecimal(take(this)))
-									tok_error(this, "expected hexadecimal character");
-						} break;
-					default:
-						tok_error(this, "invalid escape sequence");
-					}
-				else if(c == '\n')
-					tok_error(this, "forbidden newline in character/string literal");
+					int length = 3;
+					char max = '3';
+
+					if(!is_octal(c))
+						tok_error(this, "expected octal character");
+					if(c > max)
+						tok_error(this, "leading octal digit too large");
+					for(int i = 1; i < length; i++)
+						if(!is_octal(take(this)))
+							tok_error(this, "expected octal character");
+				} break;
+			case 'x':
+			case 'u':
+			case 'U':
+				{
+					c = take(this);
+					int length = (c == 'x')
+						? 2 : (c == 'u')
+						? 4
+						: 8;
+					for(int i = 0; i < length; i++)
+						if(!is_hexadecimal(take(this)))
+							tok_error(this, "expected hexadecimal character");
+				} break;
+			default:
+				tok_error(this, "invalid escape sequence");
 			}
-			tok_error(this, "unterminated character/string literal");
-		}
-	return 0;
+		else if(c == '\n')
+			tok_error(this, "forbidden newline in character/string literal");
+	}
+	tok_error(this, "unterminated character/string literal");
 }
 
+
 char ahead(
 	struct RlcTokeniser const * this,
 	size_t n)
@@ -533,10 +631,16 @@ char ahead(
 		return '\0';
 }
 
-int eof(
+char const * position(
+	struct RlcTokeniser const * this)
+{
+	return &this->fSource->fContents[this->fIndex];
+}
+
+char const * content_end(
 	struct RlcTokeniser const * this)
 {
-	return this->fIndex >= this->fSource->fContentLength;
+	return &this->fSource->fContents[this->fSource->fContentLength];
 }
 
 char look(
@@ -574,4 +678,13 @@ void ignore(
 {
 	this->fIndex += n;
 	RLC_DASSERT(this->fIndex <= this->fSource->fContentLength);
+}
+
+void advance_to(
+	struct RlcTokeniser * this,
+	char const * p)
+{
+	RLC_DASSERT(p >= position(this));
+	RLC_DASSERT(p <= content_end(this));
+	this->fIndex = p - this->fSource->fContents;
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "tokens.h"
 
 #include <stddef.h>
+#include <setjmp.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +26,12 @@ struct RlcTokeniser
 	RlcSrcIndex fStart;
 	/** The current token's type. */
 	enum RlcTokenType fType;
+	/** The current token's interned identifier, if it is an identifier. */
+	RlcIdentifier fIdentifier;
+	/** If set, errors are recorded in `fError` and jump here instead of terminating the program. */
+	jmp_buf * fRecover;
+	/** The recorded error message, if any. */
+	char const * fError;
 };
 
 /** Creates a tokeniser for a source file.
@@ -53,6 +60,15 @@ int rlc_tokeniser_read(
 	struct RlcTokeniser * this,
 	struct RlcToken * token);
 
+/** Reports the tokeniser's recorded error.
+@memberof RlcTokeniser
+@param[in] this:
+	The tokeniser.
+	@dassert @nonnull
+	@dassert `this->fError != NULL` */
+void rlc_tokeniser_report(
+	struct RlcTokeniser const * this);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,111 @@
+#include "vector.h"
+#include "malloc.h"
+#include "assert.h"
+
+#include <stdalign.h>
+#include <string.h>
+
+/** Precedes a vector's elements. */
+struct RlcVectorHeader
+{
+	/** The vector's capacity, in bytes. */
+	alignas(max_align_t) size_t fCapacity;
+};
+
+/** Retrieves the header of a non-empty vector. */
+static struct RlcVectorHeader * header(
+	void * data)
+{
+	return (struct RlcVectorHeader *)data - 1;
+}
+
+/** Changes a vector's capacity, moving it if necessary. */
+static void resize(
+	struct RlcArena * arena,
+	void ** data,
+	size_t capacity)
+{
+	struct RlcVectorHeader * h = *data ? header(*data) : NULL;
+	size_t const old_size = h ? sizeof(struct RlcVectorHeader) + h->fCapacity : 0;
+	size_t const new_size = sizeof(struct RlcVectorHeader) + capacity;
+
+	if(!arena)
+		rlc_realloc((void**)&h, new_size);
+	else if(!h || !rlc_arena_resize(arena, h, old_size, new_size))
+	{
+		void * moved = NULL;
+		rlc_arena_malloc(arena, &moved, new_size);
+		if(h)
+			memcpy(moved, h, old_size < new_size ? old_size : new_size);
+		h = moved;
+	}
+
+	h->fCapacity = capacity;
+	*data = h + 1;
+}
+
+void rlc_vector_reserve(
+	struct RlcArena * arena,
+	void ** data,
+	size_t count,
+	size_t element_size)
+{
+	RLC_DASSERT(data != NULL);
+
+	size_t const size = count * element_size;
+	size_t capacity = *data ? header(*data)->fCapacity : 0;
+	if(size <= capacity)
+		return;
+
+	capacity *= 2;
+	if(capacity < size)
+		capacity = size;
+
+	resize(arena, data, capacity);
+}
+
+void rlc_vector_shrink(
+	struct RlcArena * arena,
+	void ** data,
+	size_t count,
+	size_t element_size)
+{
+	RLC_DASSERT(data != NULL);
+
+	if(!*data)
+		return;
+
+	struct RlcVectorHeader * h = header(*data);
+	size_t const size = count * element_size;
+	if(size == h->fCapacity)
+		return;
+
+	if(arena)
+	{
+		// Moving would not free anything, so only shrink in place.
+		if(rlc_arena_resize(
+			arena,
+			h,
+			sizeof(struct RlcVectorHeader) + h->fCapacity,
+			sizeof(struct RlcVectorHeader) + size))
+		{
+			h->fCapacity = size;
+		}
+	} else if(!count)
+		rlc_vector_free(data);
+	else
+		resize(NULL, data, size);
+}
+
+void rlc_vector_free(
+	void ** data)
+{
+	RLC_DASSERT(data != NULL);
+
+	if(*data)
+	{
+		void * h = header(*data);
+		rlc_free(&h);
+		*data = NULL;
+	}
+}
@@ -0,0 +1,79 @@
+/** @file vector.h
+	Contains the dynamic array functions shared by all lists.
+	A vector is a plain element pointer with a separate element count, so lists keep their layout and are indexed directly. The capacity is stored in front of the elements. Vectors are allocated from an arena, or from the heap if no arena is given. */
+#ifndef __rlc_vector_h_defined
+#define __rlc_vector_h_defined
+
+#include "arena.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Ensures that a vector can hold at least the given number of elements.
+	The capacity grows geometrically, so appending elements one at a time costs amortised constant time.
+@param[in,out] arena:
+	The arena the vector is allocated from, or null for heap vectors.
+@param[in,out] data:
+	The address of the vector's element pointer. A null element pointer is an empty vector.
+	@dassert @nonnull
+@param[in] count:
+	The number of elements the vector must be able to hold.
+@param[in] element_size:
+	The size of an element, in bytes. */
+void rlc_vector_reserve(
+	struct RlcArena * arena,
+	void ** data,
+	size_t count,
+	size_t element_size);
+
+/** Releases a vector's unused capacity once it is complete.
+	Arena vectors can only be shrunk if they are the arena's most recent allocation, and are left as they are otherwise.
+@param[in,out] arena:
+	The arena the vector is allocated from, or null for heap vectors.
+@param[in,out] data:
+	The address of the vector's element pointer.
+	@dassert @nonnull
+@param[in] count:
+	The vector's element count.
+@param[in] element_size:
+	The size of an element, in bytes. */
+void rlc_vector_shrink(
+	struct RlcArena * arena,
+	void ** data,
+	size_t count,
+	size_t element_size);
+
+/** Frees a heap vector and sets its element pointer to null.
+	Arena vectors are released together with their arena.
+@param[in,out] data:
+	The address of the vector's element pointer.
+	@dassert @nonnull */
+void rlc_vector_free(
+	void ** data);
+
+/** @def RLC_VECTOR_PUSH(arena, data, count)
+	Appends an element to a vector and increments its count.
+	Evaluates to the new element, which can be assigned to.
+@param arena:
+	The arena the vector is allocated from, or null for heap vectors.
+@param data:
+	The vector's element pointer.
+@param count:
+	The vector's element count. */
+#define RLC_VECTOR_PUSH(arena, data, count) \
+	(*(rlc_vector_reserve((arena), (void**)&(data), (count) + 1, sizeof(*(data))), \
+	&(data)[(count)++]))
+
+/** @def RLC_VECTOR_SHRINK(arena, data, count)
+	Releases a vector's unused capacity, see `rlc_vector_shrink()`. */
+#define RLC_VECTOR_SHRINK(arena, data, count) \
+	rlc_vector_shrink((arena), (void**)&(data), (count), sizeof(*(data)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif